@@ -26,6 +26,7 @@ AC_DEFUN([PRTE_CONFIG_FILES],[
         src/tools/prte_info/Makefile
         src/tools/prte/Makefile
         src/tools/pterm/Makefile
+        src/tools/prte_bench/Makefile
         src/tools/psched/Makefile
     ])
 ])
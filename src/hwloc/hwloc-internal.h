@@ -193,6 +193,7 @@ extern char *prte_hwloc_print_null;
 PRTE_EXPORT char *prte_hwloc_base_print_locality(prte_hwloc_locality_t locality);
 
 PRTE_EXPORT extern char *prte_hwloc_base_topo_file;
+PRTE_EXPORT extern char *prte_hwloc_base_topo_cache_dir;
 PRTE_EXPORT extern bool prte_hwloc_synthetic_topo;
 
 /* convenience macro for debugging */
@@ -365,6 +366,12 @@ PRTE_EXPORT hwloc_obj_t prte_hwloc_base_get_pu(hwloc_topology_t topo, bool use_h
  * if responsible for freeing the returned string */
 PRTE_EXPORT char *prte_hwloc_base_get_topo_signature(hwloc_topology_t topo);
 
+/* retrieve/save a topology from/to the on-disk cache, if
+ * one was given - returns NULL if the topology for this
+ * signature isn't in the cache */
+PRTE_EXPORT hwloc_topology_t prte_hwloc_base_topo_cache_load(const char *sig);
+PRTE_EXPORT void prte_hwloc_base_topo_cache_store(const char *sig, hwloc_topology_t topo);
+
 /* get a string describing the locality of a given process */
 PRTE_EXPORT char *prte_hwloc_base_get_locality_string(hwloc_topology_t topo, char *bitmap);
 
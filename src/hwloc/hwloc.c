@@ -37,6 +37,7 @@ prte_hwloc_base_mbfa_t prte_hwloc_base_mbfa = PRTE_HWLOC_BASE_MBFA_WARN;
 prte_binding_policy_t prte_hwloc_default_binding_policy = 0;
 char *prte_hwloc_default_cpu_list = NULL;
 char *prte_hwloc_base_topo_file = NULL;
+char *prte_hwloc_base_topo_cache_dir = NULL;
 int prte_hwloc_base_output = -1;
 bool prte_hwloc_default_use_hwthread_cpus = false;
 bool prte_hwloc_synthetic_topo = false;
@@ -237,6 +238,14 @@ int prte_hwloc_base_register(void)
     (void) pmix_mca_base_var_register_synonym(ret, "prte", "hwloc", "base", "use_topo_file",
                                               PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    prte_hwloc_base_topo_cache_dir = NULL;
+    (void) pmix_mca_base_var_register("prte", "hwloc", "base", "topo_cache_dir",
+                                      "Directory in which to keep the topologies reported by "
+                                      "the daemons so they need not be retrieved again when "
+                                      "the DVM is restarted (default: none)",
+                                      PMIX_MCA_BASE_VAR_TYPE_STRING,
+                                      &prte_hwloc_base_topo_cache_dir);
+
     /* register parameters */
     return PRTE_SUCCESS;
 }
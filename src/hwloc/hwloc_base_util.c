@@ -48,6 +48,9 @@
 #if HAVE_FCNTL_H
 #    include <fcntl.h>
 #endif
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
 
 #include "src/include/constants.h"
 #include "src/pmix/pmix-internal.h"
@@ -1526,6 +1529,120 @@ char *prte_hwloc_base_get_topo_signature(hwloc_topology_t topo)
     return sig;
 }
 
+/* the cache holds one XML file for each topology, named
+ * by a hash of its signature */
+static char *topo_cache_path(const char *sig)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const unsigned char *p;
+    char *path = NULL;
+
+    for (p = (const unsigned char *) sig; '\0' != *p; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ULL;
+    }
+    pmix_asprintf(&path, "%s/topo-%016" PRIx64 ".xml", prte_hwloc_base_topo_cache_dir, hash);
+    return path;
+}
+
+hwloc_topology_t prte_hwloc_base_topo_cache_load(const char *sig)
+{
+    hwloc_topology_t topo;
+    char *path, *s;
+
+    if (NULL == prte_hwloc_base_topo_cache_dir || NULL == sig) {
+        return NULL;
+    }
+    path = topo_cache_path(sig);
+    if (0 != access(path, R_OK)) {
+        free(path);
+        return NULL;
+    }
+    if (0 != hwloc_topology_init(&topo)) {
+        free(path);
+        return NULL;
+    }
+    if (0 != hwloc_topology_set_xml(topo, path)
+        || 0 != prte_hwloc_base_topology_set_flags(topo, 0, true)
+        || 0 != hwloc_topology_load(topo)) {
+        PMIX_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache could not load %s", path));
+        hwloc_topology_destroy(topo);
+        free(path);
+        return NULL;
+    }
+    /* protect against hash collisions and stale files */
+    s = prte_hwloc_base_get_topo_signature(topo);
+    if (NULL == s || 0 != strcmp(s, sig)) {
+        PMIX_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache signature mismatch for %s", path));
+        if (NULL != s) {
+            free(s);
+        }
+        hwloc_topology_destroy(topo);
+        free(path);
+        return NULL;
+    }
+    PMIX_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                         "hwloc:base:topo_cache loaded %s from %s", sig, path));
+    free(s);
+    free(path);
+    return topo;
+}
+
+void prte_hwloc_base_topo_cache_store(const char *sig, hwloc_topology_t topo)
+{
+    char *path, *tmp = NULL, *xml = NULL;
+    int len, fd;
+    size_t n, nbytes;
+    ssize_t rc;
+
+    if (NULL == prte_hwloc_base_topo_cache_dir || NULL == sig || NULL == topo) {
+        return;
+    }
+    path = topo_cache_path(sig);
+    if (0 == access(path, F_OK)) {
+        /* already have it */
+        free(path);
+        return;
+    }
+    if (PMIX_SUCCESS != pmix_os_dirpath_create(prte_hwloc_base_topo_cache_dir, S_IRWXU)
+        || 0 != prte_hwloc_base_topology_export_xmlbuffer(topo, &xml, &len)) {
+        free(path);
+        return;
+    }
+    /* write to a temporary file and then move it into place
+     * so that a reader never sees a partial file */
+    pmix_asprintf(&tmp, "%s.%lu", path, (unsigned long) getpid());
+    fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (0 > fd) {
+        goto done;
+    }
+    nbytes = strlen(xml);
+    for (n = 0; n < nbytes; n += rc) {
+        rc = write(fd, xml + n, nbytes - n);
+        if (0 > rc) {
+            if (EINTR == errno) {
+                rc = 0;
+                continue;
+            }
+            break;
+        }
+    }
+    close(fd);
+    if (n < nbytes || 0 != rename(tmp, path)) {
+        unlink(tmp);
+    } else {
+        PMIX_OUTPUT_VERBOSE((5, prte_hwloc_base_output,
+                             "hwloc:base:topo_cache stored %s in %s", sig, path));
+    }
+
+done:
+    hwloc_free_xmlbuffer(topo, xml);
+    free(tmp);
+    free(path);
+}
+
 static int prte_hwloc_base_get_locality_string_by_depth(hwloc_topology_t topo, int d,
                                                         hwloc_cpuset_t cpuset,
                                                         hwloc_cpuset_t result)
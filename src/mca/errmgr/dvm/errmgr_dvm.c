@@ -305,6 +305,16 @@ static void proc_errors(int fd, short args, void *cbdata)
                 }
                 goto cleanup;
             }
+            if (prte_rml_base.reparent && PRTE_PROC_STATE_COMM_FAILED == state) {
+                /* the routing tree will reconnect the orphaned daemons
+                 * to a surviving ancestor, so we can keep going */
+                prte_rml_route_lost(proc->rank);
+                pmix_show_help("help-errmgr-base.txt", "node-rerouted", true,
+                               PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), prte_process_info.nodename,
+                               PRTE_NAME_PRINT(proc),
+                               (NULL == pptr->node) ? "UNKNOWN" : pptr->node->name);
+                goto cleanup;
+            }
             PMIX_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                                  "%s Comm failure: daemon %s - aborting",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(proc)));
@@ -42,6 +42,7 @@
 #include "src/mca/odls/base/base.h"
 #include "src/mca/plm/plm_types.h"
 #include "src/rml/rml.h"
+#include "src/mca/state/base/base.h"
 #include "src/mca/state/state.h"
 
 #include "src/runtime/prte_globals.h"
@@ -72,8 +73,6 @@ prte_errmgr_base_module_t prte_errmgr_prted_module = {
 
 /* Local functions */
 static bool any_live_children(pmix_nspace_t job);
-static int pack_state_update(pmix_data_buffer_t *alert, prte_job_t *jobdat);
-static int pack_state_for_proc(pmix_data_buffer_t *alert, prte_proc_t *child);
 static void failed_start(prte_job_t *jobdat);
 static void killprocs(pmix_nspace_t job, pmix_rank_t vpid);
 
@@ -238,8 +237,6 @@ static void job_errors(int fd, short args, void *cbdata)
     prte_job_t *jdata;
     prte_job_state_t jobstate;
     int rc;
-    prte_plm_cmd_flag_t cmd;
-    pmix_data_buffer_t *alert;
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
     PMIX_ACQUIRE_OBJECT(caddy);
@@ -285,26 +282,9 @@ static void job_errors(int fd, short args, void *cbdata)
     default:
         break;
     }
-    PMIX_DATA_BUFFER_CREATE(alert);
-    /* pack update state command */
-    cmd = PRTE_PLM_UPDATE_PROC_STATE;
-    rc = PMIx_Data_pack(NULL, alert, &cmd, 1, PMIX_UINT8);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DATA_BUFFER_RELEASE(alert);
-        goto cleanup;
-    }
-    /* pack the job info */
-    if (PMIX_SUCCESS != (rc = pack_state_update(alert, jdata))) {
-        PMIX_ERROR_LOG(rc);
-        PMIX_DATA_BUFFER_RELEASE(alert);
-        goto cleanup;
-    }
-    /* send it */
-    PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, alert, PRTE_RML_TAG_PLM);
-    if (PRTE_SUCCESS != rc) {
+    /* report the job info to the HNP */
+    if (PRTE_SUCCESS != (rc = prte_state_base_report_job(jdata, false))) {
         PRTE_ERROR_LOG(rc);
-        PMIX_RELEASE(alert);
     }
 
 cleanup:
@@ -318,8 +298,6 @@ static void proc_errors(int fd, short args, void *cbdata)
     pmix_proc_t *proc = &caddy->name;
     prte_proc_state_t state = caddy->proc_state;
     prte_proc_t *child, *ptr;
-    pmix_data_buffer_t *alert;
-    prte_plm_cmd_flag_t cmd;
     int rc = PRTE_SUCCESS;
     int i;
     prte_wait_tracker_t *t2;
@@ -476,41 +454,14 @@ static void proc_errors(int fd, short args, void *cbdata)
         /* report this as abnormal termination to the HNP, unless we already have
          * done so for this job */
         if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FAIL_NOTIFIED, NULL, PMIX_BOOL)) {
-            PMIX_DATA_BUFFER_CREATE(alert);
-            /* pack update state command */
-            cmd = PRTE_PLM_UPDATE_PROC_STATE;
-            rc = PMIx_Data_pack(NULL, alert, &cmd, 1, PMIX_UINT8);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                return;
-            }
-            /* pack only the data for this proc - have to start with the jobid
-             * so the receiver can unpack it correctly
-             */
-            rc = PMIx_Data_pack(NULL, alert, &proc->nspace, 1, PMIX_PROC_NSPACE);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                return;
-            }
-
-            /* now pack the child's info */
-            if (PMIX_SUCCESS != (rc = pack_state_for_proc(alert, child))) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                return;
-            }
-            /* send it */
+            /* report only the data for this proc */
             PMIX_OUTPUT_VERBOSE((5, prte_errmgr_base_framework.framework_output,
                                  "%s errmgr:prted reporting proc %s abnormally terminated with "
                                  "non-zero status (local procs = %d)",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&child->name),
                                  jdata->num_local_procs));
-            PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, alert, PRTE_RML_TAG_PLM);
-            if (PRTE_SUCCESS != rc) {
+            if (PRTE_SUCCESS != (rc = prte_state_base_report_proc(child))) {
                 PRTE_ERROR_LOG(rc);
-                PMIX_RELEASE(alert);
             }
             /* mark that we notified the HNP for this job so we don't do it again;
              * recoverable jobs need to receive every notifications, though. */
@@ -592,40 +543,14 @@ static void proc_errors(int fd, short args, void *cbdata)
          * only do this once!
          */
         if (!prte_get_attribute(&jdata->attributes, PRTE_JOB_FAIL_NOTIFIED, NULL, PMIX_BOOL)) {
-            PMIX_DATA_BUFFER_CREATE(alert);
-            /* pack update state command */
-            cmd = PRTE_PLM_UPDATE_PROC_STATE;
-            rc = PMIx_Data_pack(NULL, alert, &cmd, 1, PMIX_UINT8);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                return;
-            }
-            /* pack only the data for this proc - have to start with the jobid
-             * so the receiver can unpack it correctly
-             */
-            rc = PMIx_Data_pack(NULL, alert, &proc->nspace, 1, PMIX_PROC_NSPACE);
-            if (PMIX_SUCCESS != rc) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                return;
-            }
             child->state = state;
-            /* now pack the child's info */
-            if (PMIX_SUCCESS != (rc = pack_state_for_proc(alert, child))) {
-                PMIX_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
-                return;
-            }
+            /* report only the data for this proc */
             pmix_output_verbose(5, prte_errmgr_base_framework.framework_output,
                                 "%s errmgr:prted reporting proc %s aborted to HNP (local procs = %d)",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&child->name),
                                 jdata->num_local_procs);
-            /* send it */
-            PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, alert, PRTE_RML_TAG_PLM);
-            if (PRTE_SUCCESS != rc) {
+            if (PRTE_SUCCESS != (rc = prte_state_base_report_proc(child))) {
                 PRTE_ERROR_LOG(rc);
-                PMIX_DATA_BUFFER_RELEASE(alert);
             }
             /* mark that we reported termination of this proc so we
              * don't do it again */
@@ -648,19 +573,9 @@ static void proc_errors(int fd, short args, void *cbdata)
 
     /* only other state is terminated - see if anyone is left alive */
     if (!any_live_children(proc->nspace)) {
-        PMIX_DATA_BUFFER_CREATE(alert);
-        /* pack update state command */
-        cmd = PRTE_PLM_UPDATE_PROC_STATE;
-        rc = PMIx_Data_pack(NULL, alert, &cmd, 1, PMIX_UINT8);
-        if (PMIX_SUCCESS != rc) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_RELEASE(alert);
-            return;
-        }
-        /* pack the data for the job */
-        if (PMIX_SUCCESS != (rc = pack_state_update(alert, jdata))) {
-            PMIX_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_RELEASE(alert);
+        /* report the data for the job before we remove it */
+        if (PRTE_SUCCESS != (rc = prte_state_base_report_job(jdata, false))) {
+            PRTE_ERROR_LOG(rc);
             return;
         }
 
@@ -682,13 +597,6 @@ static void proc_errors(int fd, short args, void *cbdata)
 
         /* remove this job from our local job data since it is complete */
         PMIX_RELEASE(jdata);
-
-        /* send it */
-        PRTE_RML_SEND(rc, PRTE_PROC_MY_HNP->rank, alert, PRTE_RML_TAG_PLM);
-        if (PRTE_SUCCESS != rc) {
-            PRTE_ERROR_LOG(rc);
-            PMIX_DATA_BUFFER_RELEASE(alert);
-        }
         return;
     }
 
@@ -719,73 +627,6 @@ static bool any_live_children(pmix_nspace_t job)
     return false;
 }
 
-static int pack_state_for_proc(pmix_data_buffer_t *alert, prte_proc_t *child)
-{
-    int rc;
-
-    /* pack the child's vpid */
-    rc = PMIx_Data_pack(NULL, alert, &child->name.rank, 1, PMIX_PROC_RANK);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    /* pack the pid */
-    rc = PMIx_Data_pack(NULL, alert, &child->pid, 1, PMIX_PID);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    /* pack its state */
-    rc = PMIx_Data_pack(NULL, alert, &child->state, 1, PMIX_UINT32);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    /* pack its exit code */
-    rc = PMIx_Data_pack(NULL, alert, &child->exit_code, 1, PMIX_INT32);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    return PRTE_SUCCESS;
-}
-
-static int pack_state_update(pmix_data_buffer_t *alert, prte_job_t *jobdat)
-{
-    int rc, i;
-    prte_proc_t *child;
-    pmix_rank_t null = PMIX_RANK_INVALID;
-
-    /* pack the jobid */
-
-    rc = PMIx_Data_pack(NULL, alert, &jobdat->nspace, 1, PMIX_PROC_NSPACE);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-    for (i = 0; i < prte_local_children->size; i++) {
-        if (NULL == (child = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, i))) {
-            continue;
-        }
-        /* if this child is part of the job... */
-        if (PMIX_CHECK_NSPACE(child->name.nspace, jobdat->nspace)) {
-            if (PMIX_SUCCESS != (rc = pack_state_for_proc(alert, child))) {
-                PMIX_ERROR_LOG(rc);
-                return rc;
-            }
-        }
-    }
-    /* flag that this job is complete so the receiver can know */
-    rc = PMIx_Data_pack(NULL, alert, &null, 1, PMIX_PROC_RANK);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        return rc;
-    }
-
-    return PRTE_SUCCESS;
-}
-
 static void failed_start(prte_job_t *jobdat)
 {
     int i;
@@ -225,6 +225,7 @@ static int rte_init(int argc, char **argv)
     node->state = PRTE_NODE_STATE_UP;
     /* get our aliases - will include all the interface aliases captured in prte_init */
     node->aliases = PMIX_ARGV_COPY_COMPAT(prte_process_info.aliases);
+    prte_node_index(node);
     /* record that the daemon job is running */
     jdata->num_procs = 1;
     jdata->state = PRTE_JOB_STATE_RUNNING;
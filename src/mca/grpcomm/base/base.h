@@ -68,9 +68,28 @@ typedef struct {
 } prte_grpcomm_base_active_t;
 PMIX_CLASS_DECLARATION(prte_grpcomm_base_active_t);
 
+/* what we know about a signature - kept in the sig_table */
+typedef struct {
+    /* number of allgathers run with it so far */
+    uint32_t seq;
+    bool started;
+    /* the participating daemons, which are costly to
+     * compute, and the number of contributions we get
+     * from them. These are only valid as long as the
+     * routing tree is unchanged */
+    bool cached;
+    uint32_t tree_version;
+    pmix_rank_t *dmns;
+    size_t ndmns;
+    size_t nexpected;
+} prte_grpcomm_sig_info_t;
+
 typedef struct {
     pmix_list_t actives;
-    pmix_list_t ongoing;
+    /* ongoing collectives, indexed by a hash of their
+     * signature - each entry is a pmix_list_t of the
+     * trackers whose signatures share that hash */
+    pmix_hash_table_t ongoing;
     pmix_hash_table_t sig_table;
     char *transports;
     uint32_t context_id;
@@ -86,6 +105,10 @@ PRTE_EXPORT int prte_grpcomm_API_allgather(prte_pmix_mdx_caddy_t *cd);
 
 PRTE_EXPORT prte_grpcomm_coll_t *prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig,
                                                                bool create);
+PRTE_EXPORT void prte_grpcomm_base_remove_tracker(prte_grpcomm_coll_t *coll);
+PRTE_EXPORT prte_grpcomm_sig_info_t *prte_grpcomm_base_get_sig_info(prte_grpcomm_signature_t *sig,
+                                                                    bool create);
+PRTE_EXPORT void prte_grpcomm_base_purge_sig_info(const pmix_nspace_t nspace);
 
 PRTE_EXPORT int prte_pack_ctrl_options(pmix_byte_object_t *bo,
                                        const pmix_info_t *info, size_t ninfo);
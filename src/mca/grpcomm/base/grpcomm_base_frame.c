@@ -48,7 +48,7 @@
  */
 prte_grpcomm_base_t prte_grpcomm_base = {
     .actives = PMIX_LIST_STATIC_INIT,
-    .ongoing = PMIX_LIST_STATIC_INIT,
+    .ongoing = PMIX_HASH_TABLE_STATIC_INIT,
     .sig_table = PMIX_HASH_TABLE_STATIC_INIT,
     .transports = NULL,
     .context_id = 0
@@ -77,7 +77,9 @@ static int prte_grpcomm_base_close(void)
     prte_grpcomm_base_active_t *active;
     void *key;
     size_t size;
-    uint32_t *seq_number;
+    uint64_t ukey;
+    pmix_list_t *bucket;
+    prte_grpcomm_sig_info_t *info;
 
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_XCAST);
 
@@ -89,12 +91,21 @@ static int prte_grpcomm_base_close(void)
         }
     }
     PMIX_LIST_DESTRUCT(&prte_grpcomm_base.actives);
-    PMIX_LIST_DESTRUCT(&prte_grpcomm_base.ongoing);
+    for (void *_nptr = NULL;
+         PRTE_SUCCESS
+         == pmix_hash_table_get_next_key_uint64(&prte_grpcomm_base.ongoing, &ukey,
+                                                (void **) &bucket, _nptr, &_nptr);) {
+        PMIX_LIST_RELEASE(bucket);
+    }
+    PMIX_DESTRUCT(&prte_grpcomm_base.ongoing);
     for (void *_nptr = NULL;
          PRTE_SUCCESS
          == pmix_hash_table_get_next_key_ptr(&prte_grpcomm_base.sig_table, &key, &size,
-                                             (void **) &seq_number, _nptr, &_nptr);) {
-        free(seq_number);
+                                             (void **) &info, _nptr, &_nptr);) {
+        if (NULL != info->dmns) {
+            free(info->dmns);
+        }
+        free(info);
     }
     PMIX_DESTRUCT(&prte_grpcomm_base.sig_table);
 
@@ -108,7 +119,8 @@ static int prte_grpcomm_base_close(void)
 static int prte_grpcomm_base_open(pmix_mca_base_open_flag_t flags)
 {
     PMIX_CONSTRUCT(&prte_grpcomm_base.actives, pmix_list_t);
-    PMIX_CONSTRUCT(&prte_grpcomm_base.ongoing, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_grpcomm_base.ongoing, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_grpcomm_base.ongoing, 128);
     PMIX_CONSTRUCT(&prte_grpcomm_base.sig_table, pmix_hash_table_t);
     pmix_hash_table_init(&prte_grpcomm_base.sig_table, 128);
     prte_grpcomm_base.context_id = UINT32_MAX;
@@ -148,6 +160,9 @@ static void ccon(prte_grpcomm_coll_t *p)
     p->ndmns = 0;
     p->nexpected = 0;
     p->nreported = 0;
+    p->my_rank = 0;
+    p->seq = 0;
+    p->step = 0;
     p->assignID = false;
     p->timeout = 0;
     p->memsize = 0;
@@ -106,10 +106,9 @@ int prte_grpcomm_API_xcast(prte_grpcomm_signature_t *sig, prte_rml_tag_t tag,
 static void allgather_stub(int fd, short args, void *cbdata)
 {
     prte_pmix_mdx_caddy_t *cd = (prte_pmix_mdx_caddy_t *) cbdata;
-    int ret = PRTE_SUCCESS;
     prte_grpcomm_base_active_t *active;
     prte_grpcomm_coll_t *coll;
-    uint32_t *seq_number;
+    prte_grpcomm_sig_info_t *info;
     PRTE_HIDE_UNUSED_PARAMS(fd, args);
 
     PMIX_ACQUIRE_OBJECT(cd);
@@ -121,31 +120,22 @@ static void allgather_stub(int fd, short args, void *cbdata)
     /* retrieve an existing tracker, create it if not
      * already found. The allgather module is responsible
      * for releasing it upon completion of the collective */
-    ret = pmix_hash_table_get_value_ptr(&prte_grpcomm_base.sig_table, (void *) cd->sig->signature,
-                                        cd->sig->sz * sizeof(pmix_proc_t), (void **) &seq_number);
-    if (PMIX_ERR_NOT_FOUND == ret) {
-        seq_number = (uint32_t *) malloc(sizeof(uint32_t));
-        *seq_number = 0;
-    } else if (PMIX_SUCCESS == ret) {
-        *seq_number = *seq_number + 1;
-    } else {
-        PMIX_OUTPUT((prte_grpcomm_base_framework.framework_output,
-                     "%s rpcomm:base:allgather cannot get signature from hash table",
-                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-        PMIX_ERROR_LOG(ret);
-        PMIX_RELEASE(cd);
-        return;
-    }
-    ret = pmix_hash_table_set_value_ptr(&prte_grpcomm_base.sig_table, (void *) cd->sig->signature,
-                                        cd->sig->sz * sizeof(pmix_proc_t), (void *) seq_number);
-    if (PMIX_SUCCESS != ret) {
+    info = prte_grpcomm_base_get_sig_info(cd->sig, true);
+    if (NULL == info) {
         PMIX_OUTPUT((prte_grpcomm_base_framework.framework_output,
                      "%s rpcomm:base:allgather cannot add new signature to hash table",
                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-        PMIX_ERROR_LOG(ret);
         PMIX_RELEASE(cd);
         return;
     }
+    /* the entry may have been created by an early
+     * contribution from someone else */
+    if (info->started) {
+        ++info->seq;
+    } else {
+        info->started = true;
+        info->seq = 0;
+    }
     coll = prte_grpcomm_base_get_tracker(cd->sig, true);
     if (NULL == coll) {
         PMIX_RELEASE(cd->sig);
@@ -181,29 +171,165 @@ int prte_grpcomm_API_allgather(prte_pmix_mdx_caddy_t *cd)
     return PRTE_SUCCESS;
 }
 
+/* hash a signature - only the meaningful part of each
+ * nspace is included so that this is cheap to compute */
+static uint64_t sig_hash(prte_grpcomm_signature_t *sig)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    size_t n, m, len;
+    const unsigned char *ptr;
+
+    if (NULL == sig->signature) {
+        return 0;
+    }
+    for (n = 0; n < sig->sz; n++) {
+        len = strnlen(sig->signature[n].nspace, PMIX_MAX_NSLEN);
+        ptr = (const unsigned char *) sig->signature[n].nspace;
+        for (m = 0; m < len; m++) {
+            hash = (hash ^ ptr[m]) * 1099511628211ULL;
+        }
+        ptr = (const unsigned char *) &sig->signature[n].rank;
+        for (m = 0; m < sizeof(pmix_rank_t); m++) {
+            hash = (hash ^ ptr[m]) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+static bool sig_match(prte_grpcomm_signature_t *a, prte_grpcomm_signature_t *b)
+{
+    if (NULL == a->signature || NULL == b->signature) {
+        /* only one collective can operate at a time
+         * across every process in the system */
+        return (a->signature == b->signature);
+    }
+    return (a->sz == b->sz &&
+            0 == memcmp(a->signature, b->signature, a->sz * sizeof(pmix_proc_t)));
+}
+
+static pmix_list_t *get_bucket(uint64_t key, bool create)
+{
+    pmix_list_t *bucket = NULL;
+    int rc;
+
+    rc = pmix_hash_table_get_value_uint64(&prte_grpcomm_base.ongoing, key, (void **) &bucket);
+    if (PMIX_SUCCESS == rc) {
+        return bucket;
+    }
+    if (!create) {
+        return NULL;
+    }
+    bucket = PMIX_NEW(pmix_list_t);
+    rc = pmix_hash_table_set_value_uint64(&prte_grpcomm_base.ongoing, key, bucket);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_RELEASE(bucket);
+        return NULL;
+    }
+    return bucket;
+}
+
+prte_grpcomm_sig_info_t *prte_grpcomm_base_get_sig_info(prte_grpcomm_signature_t *sig,
+                                                        bool create)
+{
+    prte_grpcomm_sig_info_t *info = NULL;
+    int rc;
+
+    if (NULL == sig->signature) {
+        return NULL;
+    }
+    rc = pmix_hash_table_get_value_ptr(&prte_grpcomm_base.sig_table, (void *) sig->signature,
+                                       sig->sz * sizeof(pmix_proc_t), (void **) &info);
+    if (PMIX_SUCCESS == rc) {
+        return info;
+    }
+    if (!create) {
+        return NULL;
+    }
+    info = (prte_grpcomm_sig_info_t *) calloc(1, sizeof(prte_grpcomm_sig_info_t));
+    if (NULL == info) {
+        return NULL;
+    }
+    rc = pmix_hash_table_set_value_ptr(&prte_grpcomm_base.sig_table, (void *) sig->signature,
+                                       sig->sz * sizeof(pmix_proc_t), (void *) info);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        free(info);
+        return NULL;
+    }
+    return info;
+}
+
+/* forget every signature that involves the given job - called
+ * when the job is cleaned up so the table doesn't keep growing
+ * in a persistent DVM */
+void prte_grpcomm_base_purge_sig_info(const pmix_nspace_t nspace)
+{
+    prte_grpcomm_sig_info_t *info;
+    prte_grpcomm_signature_t *sig;
+    pmix_pointer_array_t sigs;
+    pmix_proc_t *procs;
+    size_t size, n;
+    void *key;
+    int i;
+
+    PMIX_CONSTRUCT(&sigs, pmix_pointer_array_t);
+    pmix_pointer_array_init(&sigs, 8, INT_MAX, 8);
+    for (void *_nptr = NULL;
+         PRTE_SUCCESS
+         == pmix_hash_table_get_next_key_ptr(&prte_grpcomm_base.sig_table, &key, &size,
+                                             (void **) &info, _nptr, &_nptr);) {
+        procs = (pmix_proc_t *) key;
+        for (n = 0; n < size / sizeof(pmix_proc_t); n++) {
+            if (PMIX_CHECK_NSPACE(procs[n].nspace, nspace)) {
+                /* can't remove it while we are walking the table */
+                sig = PMIX_NEW(prte_grpcomm_signature_t);
+                sig->sz = size / sizeof(pmix_proc_t);
+                sig->signature = (pmix_proc_t *) malloc(size);
+                memcpy(sig->signature, procs, size);
+                pmix_pointer_array_add(&sigs, sig);
+                break;
+            }
+        }
+    }
+    for (i = 0; i < sigs.size; i++) {
+        if (NULL == (sig = (prte_grpcomm_signature_t *) pmix_pointer_array_get_item(&sigs, i))) {
+            continue;
+        }
+        info = prte_grpcomm_base_get_sig_info(sig, false);
+        if (NULL != info) {
+            pmix_hash_table_remove_value_ptr(&prte_grpcomm_base.sig_table,
+                                             (void *) sig->signature,
+                                             sig->sz * sizeof(pmix_proc_t));
+            if (NULL != info->dmns) {
+                free(info->dmns);
+            }
+            free(info);
+        }
+        PMIX_RELEASE(sig);
+    }
+    PMIX_DESTRUCT(&sigs);
+}
+
 prte_grpcomm_coll_t *prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig, bool create)
 {
     prte_grpcomm_coll_t *coll;
+    prte_grpcomm_sig_info_t *info;
+    pmix_list_t *bucket;
     int rc;
     size_t n;
 
-    /* search the existing tracker list to see if this already exists */
-    PMIX_LIST_FOREACH(coll, &prte_grpcomm_base.ongoing, prte_grpcomm_coll_t) {
-        if (NULL == sig->signature) {
-            if (NULL == coll->sig->signature) {
-                /* only one collective can operate at a time
-                 * across every process in the system */
+    /* see if this already exists - we only have to compare
+     * against the trackers whose signature hashes the same */
+    bucket = get_bucket(sig_hash(sig), create);
+    if (NULL != bucket) {
+        PMIX_LIST_FOREACH(coll, bucket, prte_grpcomm_coll_t) {
+            if (sig_match(sig, coll->sig)) {
+                PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                                     "%s grpcomm:base:returning existing collective",
+                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
                 return coll;
             }
-            /* if only one is NULL, then we can't possibly match */
-            break;
-        }
-        if (sig->sz == coll->sig->sz &&
-            0 == memcmp(sig->signature, coll->sig->signature, sig->sz * sizeof(pmix_proc_t))) {
-            PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:base:returning existing collective",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
-            return coll;
         }
     }
     /* if we get here, then this is a new collective - so create
@@ -215,13 +341,29 @@ prte_grpcomm_coll_t *prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig
 
         return NULL;
     }
+    if (NULL == bucket) {
+        return NULL;
+    }
     coll = PMIX_NEW(prte_grpcomm_coll_t);
     coll->sig = PMIX_NEW(prte_grpcomm_signature_t);
     coll->sig->sz = sig->sz;
     coll->sig->signature = (pmix_proc_t *) malloc(coll->sig->sz * sizeof(pmix_proc_t));
     memcpy(coll->sig->signature, sig->signature, coll->sig->sz * sizeof(pmix_proc_t));
 
-    pmix_list_append(&prte_grpcomm_base.ongoing, &coll->super);
+    pmix_list_append(bucket, &coll->super);
+
+    /* reuse what we computed the last time we saw this
+     * signature if the routing tree hasn't changed since */
+    info = prte_grpcomm_base_get_sig_info(sig, true);
+    if (NULL != info && info->cached && info->tree_version == prte_rml_base.tree_version) {
+        coll->ndmns = info->ndmns;
+        if (NULL != info->dmns) {
+            coll->dmns = (pmix_rank_t *) malloc(info->ndmns * sizeof(pmix_rank_t));
+            memcpy(coll->dmns, info->dmns, info->ndmns * sizeof(pmix_rank_t));
+        }
+        coll->nexpected = info->nexpected;
+        return coll;
+    }
 
     /* now get the daemons involved */
     if (PRTE_SUCCESS != (rc = create_dmns(sig, &coll->dmns, &coll->ndmns))) {
@@ -235,16 +377,54 @@ prte_grpcomm_coll_t *prte_grpcomm_base_get_tracker(prte_grpcomm_signature_t *sig
     /* see if I am in the array of participants - note that I may
      * be in the rollup tree even though I'm not participating
      * in the collective itself */
-    for (n = 0; n < coll->ndmns; n++) {
+    if (NULL == coll->dmns) {
+        /* everyone is participating */
+        coll->nexpected++;
+    }
+    for (n = 0; NULL != coll->dmns && n < coll->ndmns; n++) {
         if (coll->dmns[n] == PRTE_PROC_MY_NAME->rank) {
             coll->nexpected++;
             break;
         }
     }
 
+    /* an empty set means the job hasn't been mapped yet,
+     * so don't remember that */
+    if (NULL != info && 0 < coll->ndmns) {
+        if (NULL != info->dmns) {
+            free(info->dmns);
+            info->dmns = NULL;
+        }
+        if (NULL != coll->dmns) {
+            info->dmns = (pmix_rank_t *) malloc(coll->ndmns * sizeof(pmix_rank_t));
+            memcpy(info->dmns, coll->dmns, coll->ndmns * sizeof(pmix_rank_t));
+        }
+        info->ndmns = coll->ndmns;
+        info->nexpected = coll->nexpected;
+        info->tree_version = prte_rml_base.tree_version;
+        info->cached = true;
+    }
+
     return coll;
 }
 
+void prte_grpcomm_base_remove_tracker(prte_grpcomm_coll_t *coll)
+{
+    pmix_list_t *bucket;
+    uint64_t key;
+
+    key = sig_hash(coll->sig);
+    bucket = get_bucket(key, false);
+    if (NULL == bucket) {
+        return;
+    }
+    pmix_list_remove_item(bucket, &coll->super);
+    if (0 == pmix_list_get_size(bucket)) {
+        pmix_hash_table_remove_value_uint64(&prte_grpcomm_base.ongoing, key);
+        PMIX_RELEASE(bucket);
+    }
+}
+
 static int create_dmns(prte_grpcomm_signature_t *sig, pmix_rank_t **dmns, size_t *ndmns)
 {
     size_t n;
@@ -54,13 +54,53 @@ prte_grpcomm_base_module_t prte_grpcomm_direct_module = {
 /* internal functions */
 static void xcast_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                        prte_rml_tag_t tag, void *cbdata);
+static void xcast_frag_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                            prte_rml_tag_t tag, void *cbdata);
+static void xcast_process(pmix_data_buffer_t *buffer, prte_grpcomm_direct_payload_t *rly);
+static void wireup_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                        prte_rml_tag_t tag, void *cbdata);
+static void relay_to_children(prte_grpcomm_direct_payload_t *rly, prte_rml_tag_t tag);
+static void send_segments(prte_grpcomm_direct_payload_t *rly);
 static void allgather_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                            prte_rml_tag_t tag, void *cbdata);
 static void barrier_release(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                             prte_rml_tag_t tag, void *cbdata);
+static int pack_merged_ctrls(prte_grpcomm_coll_t *coll, pmix_info_t *info, size_t ninfo,
+                             pmix_byte_object_t *bo);
 
 /* internal variables */
 static pmix_list_t tracker;
+static pmix_list_t frags;
+static uint32_t next_xcast_id = 0;
+
+static void pcon(prte_grpcomm_direct_payload_t *p)
+{
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->dbuf);
+}
+static void pdes(prte_grpcomm_direct_payload_t *p)
+{
+    PMIX_DATA_BUFFER_DESTRUCT(&p->dbuf);
+}
+PMIX_CLASS_INSTANCE(prte_grpcomm_direct_payload_t,
+                    pmix_object_t,
+                    pcon, pdes);
+
+static void fcon(prte_grpcomm_direct_xfrag_t *p)
+{
+    p->id = 0;
+    p->total = 0;
+    p->nrecvd = 0;
+    p->bytes = NULL;
+}
+static void fdes(prte_grpcomm_direct_xfrag_t *p)
+{
+    if (NULL != p->bytes) {
+        free(p->bytes);
+    }
+}
+PMIX_CLASS_INSTANCE(prte_grpcomm_direct_xfrag_t,
+                    pmix_list_item_t,
+                    fcon, fdes);
 
 /**
  * Initialize the module
@@ -68,15 +108,26 @@ static pmix_list_t tracker;
 static int init(void)
 {
     PMIX_CONSTRUCT(&tracker, pmix_list_t);
+    PMIX_CONSTRUCT(&frags, pmix_list_t);
 
     /* post the receives */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_XCAST,
                   PRTE_RML_PERSISTENT, xcast_recv, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_XCAST_FRAG,
+                  PRTE_RML_PERSISTENT, xcast_frag_recv, NULL);
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_ALLGATHER_DIRECT,
                   PRTE_RML_PERSISTENT, allgather_recv, NULL);
+    prte_grpcomm_direct_rcd_init();
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_ALLGATHER_RCD,
+                  PRTE_RML_PERSISTENT, prte_grpcomm_direct_rcd_recv, NULL);
     /* setup recv for barrier release */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_COLL_RELEASE,
                   PRTE_RML_PERSISTENT, barrier_release, NULL);
+    /* setup recv for the full wireup of late-joining daemons */
+    if (!PRTE_PROC_IS_MASTER) {
+        PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_WIREUP,
+                      PRTE_RML_PERSISTENT, wireup_recv, NULL);
+    }
 
     return PRTE_SUCCESS;
 }
@@ -87,6 +138,8 @@ static int init(void)
 static void finalize(void)
 {
     PMIX_LIST_DESTRUCT(&tracker);
+    PMIX_LIST_DESTRUCT(&frags);
+    prte_grpcomm_direct_rcd_finalize();
     return;
 }
 
@@ -119,6 +172,14 @@ static int allgather(prte_grpcomm_coll_t *coll,
      * before calling us, so we can safely access global data
      * at this point */
 
+    /* if everyone can compute the result themselves, then
+     * mid-sized groups of daemons are better off exchanging
+     * data directly than funnelling it all through the HNP */
+    if (cd->symmetric && 1 < coll->ndmns &&
+        coll->ndmns <= (size_t) prte_grpcomm_direct_rcd_max_daemons) {
+        return prte_grpcomm_direct_rcd_allgather(coll, cd);
+    }
+
     PMIX_DATA_BUFFER_CREATE(relay);
     /* pack the signature */
     rc = PMIx_Data_pack(NULL, relay, &coll->sig->sz, 1, PMIX_SIZE);
@@ -161,6 +222,63 @@ static int allgather(prte_grpcomm_coll_t *coll,
     return rc;
 }
 
+/* build the ctrls to pass up the tree from the values merged
+ * across all of our contributors, keeping anything else the
+ * latest contributor provided */
+static int pack_merged_ctrls(prte_grpcomm_coll_t *coll, pmix_info_t *info, size_t ninfo,
+                             pmix_byte_object_t *bo)
+{
+    pmix_info_t *merged;
+    pmix_data_array_t darray;
+    pmix_proc_t *members;
+    prte_namelist_t *nm;
+    size_t n, nmerged = 0, nmembers;
+    int rc;
+
+    PMIX_INFO_CREATE(merged, ninfo + 4);
+    for (n = 0; n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT) ||
+            PMIX_CHECK_KEY(&info[n], PMIX_LOCAL_COLLECTIVE_STATUS) ||
+            PMIX_CHECK_KEY(&info[n], PMIX_GROUP_ASSIGN_CONTEXT_ID) ||
+            PMIX_CHECK_KEY(&info[n], PMIX_GROUP_ADD_MEMBERS)) {
+            continue;
+        }
+        PMIX_INFO_XFER(&merged[nmerged], &info[n]);
+        ++nmerged;
+    }
+    if (0 < coll->timeout) {
+        PMIX_INFO_LOAD(&merged[nmerged], PMIX_TIMEOUT, &coll->timeout, PMIX_INT);
+        ++nmerged;
+    }
+    if (PMIX_SUCCESS != coll->status) {
+        PMIX_INFO_LOAD(&merged[nmerged], PMIX_LOCAL_COLLECTIVE_STATUS, &coll->status, PMIX_STATUS);
+        ++nmerged;
+    }
+    if (coll->assignID) {
+        PMIX_INFO_LOAD(&merged[nmerged], PMIX_GROUP_ASSIGN_CONTEXT_ID, &coll->assignID, PMIX_BOOL);
+        ++nmerged;
+    }
+    nmembers = pmix_list_get_size(&coll->addmembers);
+    if (0 < nmembers) {
+        PMIX_PROC_CREATE(members, nmembers);
+        n = 0;
+        PMIX_LIST_FOREACH(nm, &coll->addmembers, prte_namelist_t) {
+            PMIX_XFER_PROCID(&members[n], &nm->name);
+            ++n;
+        }
+        darray.type = PMIX_PROC;
+        darray.array = members;
+        darray.size = nmembers;
+        PMIX_INFO_LOAD(&merged[nmerged], PMIX_GROUP_ADD_MEMBERS, &darray, PMIX_DATA_ARRAY);
+        PMIX_PROC_FREE(members, nmembers);
+        ++nmerged;
+    }
+
+    rc = prte_pack_ctrl_options(bo, merged, nmerged);
+    PMIX_INFO_FREE(merged, ninfo + 4);
+    return rc;
+}
+
 static void allgather_recv(int status, pmix_proc_t *sender,
                            pmix_data_buffer_t *buffer,
                            prte_rml_tag_t tag, void *cbdata)
@@ -168,7 +286,7 @@ static void allgather_recv(int status, pmix_proc_t *sender,
     int32_t cnt;
     int rc, timeout;
     size_t n, ninfo, memsize, m;
-    bool assignID = false;
+    bool assignID = false, found;
     pmix_proc_t *addmembers = NULL;
     size_t num_members = 0;
     prte_namelist_t *nm;
@@ -290,6 +408,18 @@ static void allgather_recv(int status, pmix_proc_t *sender,
             addmembers = (pmix_proc_t*)info[n].value.data.darray->array;
             num_members = info[n].value.data.darray->size;
             for (m=0; m < num_members; m++) {
+                /* every contributor below us may have reported
+                 * the same members - only keep one of each */
+                found = false;
+                PMIX_LIST_FOREACH(nm, &coll->addmembers, prte_namelist_t) {
+                    if (PMIX_CHECK_PROCID(&nm->name, &addmembers[m])) {
+                        found = true;
+                        break;
+                    }
+                }
+                if (found) {
+                    continue;
+                }
                 nm = PMIX_NEW(prte_namelist_t);
                 PMIX_XFER_PROCID(&nm->name, &addmembers[m]);
                 pmix_list_append(&coll->addmembers, &nm->super);
@@ -345,8 +475,8 @@ static void allgather_recv(int status, pmix_proc_t *sender,
             /* add some values to the payload in the bucket */
             PMIX_DATA_BUFFER_CONSTRUCT(&ctrlbuf);
 
-            /* if we were asked to provide a context id, do so */
-            if (assignID) {
+            /* if anyone asked us to provide a context id, do so */
+            if (coll->assignID) {
                 size_t sz;
                 sz = prte_grpcomm_base.context_id;
                 --prte_grpcomm_base.context_id;
@@ -427,9 +557,9 @@ static void allgather_recv(int status, pmix_proc_t *sender,
                 PMIX_PROC_FREE(sig.signature, sig.sz);
                 return;
             }
-            /* pass along the ctrls - we have updated the values
-             * we collected along the way */
-            rc = prte_pack_ctrl_options(&ctrlsbo, info, ninfo);
+            /* pass along the ctrls - merged across everyone
+             * who reported to us */
+            rc = pack_merged_ctrls(coll, info, ninfo, &ctrlsbo);
             if (PRTE_SUCCESS != rc) {
                 PMIX_DATA_BUFFER_RELEASE(reply);
                 PMIX_PROC_FREE(sig.signature, sig.sz);
@@ -471,18 +601,8 @@ static void xcast_recv(int status, pmix_proc_t *sender,
                        pmix_data_buffer_t *buffer,
                        prte_rml_tag_t tg, void *cbdata)
 {
-    prte_routed_tree_t *nm;
-    int ret, cnt;
-    pmix_data_buffer_t *relay = NULL, *rly, *rlycopy;
-    pmix_data_buffer_t datbuf, *data;
-    bool compressed;
-    prte_job_t *daemons;
-    pmix_list_t coll;
-    prte_grpcomm_signature_t sig;
-    prte_rml_tag_t tag;
-    pmix_byte_object_t bo, pbo;
-    pmix_value_t val;
-    pmix_proc_t dmn;
+    prte_grpcomm_direct_payload_t *rly;
+    int ret;
     PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
 
     PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
@@ -490,14 +610,272 @@ static void xcast_recv(int status, pmix_proc_t *sender,
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) buffer->bytes_used));
 
     /* we need a passthru buffer to send to our children - we leave it
-     * as compressed data */
-    PMIX_DATA_BUFFER_CREATE(rly);
-    ret = PMIx_Data_copy_payload(rly, buffer);
+     * as compressed data. A single copy is shared by all the children */
+    rly = PMIX_NEW(prte_grpcomm_direct_payload_t);
+    ret = PMIx_Data_copy_payload(&rly->dbuf, buffer);
     if (PMIX_SUCCESS != ret) {
         PMIX_ERROR_LOG(ret);
-        PMIX_DATA_BUFFER_RELEASE(rly);
+        PMIX_RELEASE(rly);
+        return;
+    }
+    xcast_process(buffer, rly);
+    PMIX_RELEASE(rly);
+}
+
+/* a segment of an xcast - pass it along to our children right
+ * away, and process the message once all of it has arrived */
+static void xcast_frag_recv(int status, pmix_proc_t *sender,
+                            pmix_data_buffer_t *buffer,
+                            prte_rml_tag_t tg, void *cbdata)
+{
+    prte_grpcomm_direct_payload_t *seg;
+    prte_grpcomm_direct_xfrag_t *frag, *fptr;
+    pmix_data_buffer_t datbuf;
+    pmix_byte_object_t bo;
+    uint32_t id;
+    size_t total, offset, hdrlen, len;
+    int ret, cnt;
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
+
+    cnt = 1;
+    ret = PMIx_Data_unpack(NULL, buffer, &id, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS == ret) {
+        cnt = 1;
+        ret = PMIx_Data_unpack(NULL, buffer, &total, &cnt, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS == ret) {
+        cnt = 1;
+        ret = PMIx_Data_unpack(NULL, buffer, &offset, &cnt, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+        return;
+    }
+    /* the rest of the buffer is the raw segment */
+    hdrlen = buffer->unpack_ptr - buffer->base_ptr;
+    len = buffer->bytes_used - hdrlen;
+    if (total < offset || total - offset < len) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+        return;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:xcast:frag: id %u bytes %lu-%lu of %lu",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), id, (unsigned long) offset,
+                         (unsigned long) (offset + len), (unsigned long) total));
+
+    /* take over the incoming storage so it can be relayed as-is - the
+     * RML will release the now-empty buffer when we return */
+    seg = PMIX_NEW(prte_grpcomm_direct_payload_t);
+    seg->dbuf = *buffer;
+    PMIX_DATA_BUFFER_CONSTRUCT(buffer);
+
+    /* get it moving on down the tree before we do anything else */
+    relay_to_children(seg, PRTE_RML_TAG_XCAST_FRAG);
+
+    frag = NULL;
+    PMIX_LIST_FOREACH(fptr, &frags, prte_grpcomm_direct_xfrag_t) {
+        if (fptr->id == id) {
+            frag = fptr;
+            break;
+        }
+    }
+    if (NULL == frag) {
+        frag = PMIX_NEW(prte_grpcomm_direct_xfrag_t);
+        frag->id = id;
+        frag->total = total;
+        frag->bytes = (char *) malloc(total);
+        if (NULL == frag->bytes) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            PMIX_RELEASE(frag);
+            PMIX_RELEASE(seg);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            return;
+        }
+        pmix_list_append(&frags, &frag->super);
+    } else if (frag->total != total) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        PMIX_RELEASE(seg);
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+        return;
+    }
+    memcpy(frag->bytes + offset, seg->dbuf.base_ptr + hdrlen, len);
+    frag->nrecvd += len;
+    PMIX_RELEASE(seg);
+
+    if (frag->nrecvd < frag->total) {
+        return;
+    }
+
+    /* we have it all - the segments have already been passed
+     * along, so just process it ourselves */
+    pmix_list_remove_item(&frags, &frag->super);
+    PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
+    bo.bytes = frag->bytes;
+    bo.size = frag->total;
+    frag->bytes = NULL;
+    PMIX_RELEASE(frag);
+    ret = PMIx_Data_load(&datbuf, &bo);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+        return;
+    }
+    xcast_process(&datbuf, NULL);
+    PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
+}
+
+/* send the payload to each of our children - they all
+ * share the one copy */
+static void relay_to_children(prte_grpcomm_direct_payload_t *rly, prte_rml_tag_t tag)
+{
+    prte_routed_tree_t *nm;
+    prte_job_t *daemons;
+    int ret;
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    if (prte_get_attribute(&daemons->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
         return;
     }
+
+    PMIX_LIST_FOREACH(nm, &prte_rml_base.children, prte_routed_tree_t)
+    {
+        PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                             "%s grpcomm:direct:send_relay sending relay msg of %d bytes to %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) rly->dbuf.bytes_used,
+                             PRTE_VPID_PRINT(nm->rank)));
+        PRTE_RML_SEND_SHARED(ret, nm->rank, &rly->dbuf, &rly->super, tag);
+        if (PRTE_SUCCESS != ret) {
+            PRTE_ERROR_LOG(ret);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            continue;
+        }
+    }
+}
+
+/* break a large xcast into segments so each daemon can
+ * relay them as they arrive instead of waiting for the
+ * entire message */
+static void send_segments(prte_grpcomm_direct_payload_t *rly)
+{
+    prte_grpcomm_direct_payload_t *seg;
+    pmix_data_buffer_t hdr;
+    size_t total, offset, len;
+    uint32_t id;
+    char *bytes;
+    int ret;
+
+    id = next_xcast_id++;
+    total = rly->dbuf.bytes_used;
+    for (offset = 0; offset < total; offset += len) {
+        len = total - offset;
+        if (prte_grpcomm_direct_xcast_segment_size < len) {
+            len = prte_grpcomm_direct_xcast_segment_size;
+        }
+        PMIX_DATA_BUFFER_CONSTRUCT(&hdr);
+        ret = PMIx_Data_pack(NULL, &hdr, &id, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &hdr, &total, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, &hdr, &offset, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&hdr);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            return;
+        }
+        /* the segment follows the header as raw bytes */
+        bytes = (char *) malloc(hdr.bytes_used + len);
+        if (NULL == bytes) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+            PMIX_DATA_BUFFER_DESTRUCT(&hdr);
+            PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+            return;
+        }
+        memcpy(bytes, hdr.base_ptr, hdr.bytes_used);
+        memcpy(bytes + hdr.bytes_used, rly->dbuf.base_ptr + offset, len);
+        seg = PMIX_NEW(prte_grpcomm_direct_payload_t);
+        PMIX_DATA_BUFFER_LOAD(&seg->dbuf, bytes, hdr.bytes_used + len);
+        PMIX_DATA_BUFFER_DESTRUCT(&hdr);
+        relay_to_children(seg, PRTE_RML_TAG_XCAST_FRAG);
+        PMIX_RELEASE(seg);
+    }
+}
+
+/* update our node map and the contact info for
+ * the daemons in the DVM */
+static int process_wireup(pmix_data_buffer_t *data)
+{
+    pmix_proc_t dmn;
+    pmix_value_t val;
+    int ret, cnt;
+
+    if (PRTE_SUCCESS != (ret = prte_util_decode_nidmap(data))) {
+        PRTE_ERROR_LOG(ret);
+        return ret;
+    }
+    /* unpack the wireup info */
+    cnt = 1;
+    while (PMIX_SUCCESS == (ret = PMIx_Data_unpack(NULL, data, &dmn, &cnt, PMIX_PROC))) {
+        PMIX_VALUE_CONSTRUCT(&val);
+        val.type = PMIX_STRING;
+        cnt = 1;
+        ret = PMIx_Data_unpack(NULL, data, &val.data.string, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            return ret;
+        }
+
+        if (!PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_HNP) &&
+            !PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_NAME) &&
+            !PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_PARENT)) {
+            /* store it locally */
+            ret = PMIx_Store_internal(&dmn, PMIX_PROC_URI, &val);
+            if (PMIX_SUCCESS != ret) {
+                PMIX_ERROR_LOG(ret);
+                PMIX_VALUE_DESTRUCT(&val);
+                return ret;
+            }
+        }
+        PMIX_VALUE_DESTRUCT(&val);
+        cnt = 1;
+    }
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != ret) {
+        PMIX_ERROR_LOG(ret);
+    }
+    return PRTE_SUCCESS;
+}
+
+/* the full node map and contact info sent directly to a
+ * daemon that joined after the DVM was formed, ahead of
+ * the update being sent to all */
+static void wireup_recv(int status, pmix_proc_t *sender,
+                        pmix_data_buffer_t *buffer,
+                        prte_rml_tag_t tg, void *cbdata)
+{
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, tg, cbdata);
+
+    if (PRTE_SUCCESS != process_wireup(buffer)) {
+        PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+    }
+}
+
+static void xcast_process(pmix_data_buffer_t *buffer, prte_grpcomm_direct_payload_t *rly)
+{
+    int ret, cnt;
+    pmix_data_buffer_t *relay = NULL;
+    pmix_data_buffer_t datbuf, *data;
+    bool compressed;
+    pmix_list_t coll;
+    prte_grpcomm_signature_t sig;
+    prte_rml_tag_t tag;
+    pmix_byte_object_t bo, pbo;
+
     PMIX_DATA_BUFFER_CONSTRUCT(&datbuf);
     /* setup the relay list */
     PMIX_CONSTRUCT(&coll, pmix_list_t);
@@ -510,7 +888,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PMIX_DESTRUCT(&coll);
-        PMIX_DATA_BUFFER_RELEASE(rly);
         return;
     }
     /* unpack the data blob */
@@ -520,7 +897,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
         PMIX_ERROR_LOG(ret);
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         PMIX_DESTRUCT(&coll);
-        PMIX_DATA_BUFFER_RELEASE(rly);
         return;
     }
     if (compressed) {
@@ -534,7 +910,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
                 PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
                 PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
                 PMIX_DESTRUCT(&coll);
-                PMIX_DATA_BUFFER_RELEASE(rly);
                 return;
             }
         } else {
@@ -544,7 +919,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
             PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
             PMIX_DESTRUCT(&coll);
-            PMIX_DATA_BUFFER_RELEASE(rly);
             return;
         }
     } else {
@@ -554,7 +928,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
             PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
             PMIX_DESTRUCT(&coll);
-            PMIX_DATA_BUFFER_RELEASE(rly);
             return;
         }
     }
@@ -569,7 +942,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PMIX_DESTRUCT(&coll);
-        PMIX_DATA_BUFFER_RELEASE(rly);
         return;
     }
     PMIX_PROC_CREATE(sig.signature, sig.sz);
@@ -580,7 +952,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PMIX_DESTRUCT(&coll);
-        PMIX_DATA_BUFFER_RELEASE(rly);
         PMIX_PROC_FREE(sig.signature, sig.sz);
         return;
     }
@@ -594,7 +965,6 @@ static void xcast_recv(int status, pmix_proc_t *sender,
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PMIX_DESTRUCT(&coll);
-        PMIX_DATA_BUFFER_RELEASE(rly);
         return;
     }
 
@@ -606,92 +976,32 @@ static void xcast_recv(int status, pmix_proc_t *sender,
         PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
         PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
         PMIX_DESTRUCT(&coll);
-        PMIX_DATA_BUFFER_RELEASE(rly);
         PMIX_DATA_BUFFER_RELEASE(relay);
         return;
     }
 
     if (PRTE_RML_TAG_WIREUP == tag && !PRTE_PROC_IS_MASTER) {
-        if (PRTE_SUCCESS != (ret = prte_util_decode_nidmap(data))) {
-            PRTE_ERROR_LOG(ret);
+        if (PRTE_SUCCESS != (ret = process_wireup(data))) {
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
             PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
             PMIX_DESTRUCT(&coll);
-            PMIX_DATA_BUFFER_RELEASE(rly);
             PMIX_DATA_BUFFER_RELEASE(relay);
             return;
         }
-        /* unpack the wireup info */
-        cnt = 1;
-        while (PMIX_SUCCESS == (ret = PMIx_Data_unpack(NULL, data, &dmn, &cnt, PMIX_PROC))) {
-            PMIX_VALUE_CONSTRUCT(&val);
-            val.type = PMIX_STRING;
-            cnt = 1;
-            ret = PMIx_Data_unpack(NULL, data, &val.data.string, &cnt, PMIX_STRING);
-            if (PMIX_SUCCESS != ret) {
-                PMIX_ERROR_LOG(ret);
-                PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
-                PMIX_DESTRUCT(&coll);
-                PMIX_DATA_BUFFER_RELEASE(rly);
-                PMIX_DATA_BUFFER_RELEASE(relay);
-                return;
-            }
-
-            if (!PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_HNP) &&
-                !PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_NAME) &&
-                !PMIX_CHECK_PROCID(&dmn, PRTE_PROC_MY_PARENT)) {
-                /* store it locally */
-                ret = PMIx_Store_internal(&dmn, PMIX_PROC_URI, &val);
-                PMIX_VALUE_DESTRUCT(&val);
-                if (PMIX_SUCCESS != ret) {
-                    PMIX_ERROR_LOG(ret);
-                    PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                    PMIX_DATA_BUFFER_DESTRUCT(&datbuf);
-                    PMIX_DESTRUCT(&coll);
-                    PMIX_DATA_BUFFER_RELEASE(rly);
-                    PMIX_DATA_BUFFER_RELEASE(relay);
-                    return;
-                }
-            }
-        }
-        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != ret) {
-            PMIX_ERROR_LOG(ret);
-        }
     }
 
-    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
-    if (!prte_get_attribute(&daemons->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
-        /* send the message to each of our children */
-        PMIX_LIST_FOREACH(nm, &prte_rml_base.children, prte_routed_tree_t)
-        {
-            PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
-                                 "%s grpcomm:direct:send_relay sending relay msg of %d bytes to %s",
-                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) rly->bytes_used,
-                                 PRTE_VPID_PRINT(nm->rank)));
-            /* copy the buffer for send */
-            PMIX_DATA_BUFFER_CREATE(rlycopy);
-            ret = PMIx_Data_copy_payload(rlycopy, rly);
-            if (PMIX_SUCCESS != ret) {
-                PRTE_ERROR_LOG(ret);
-                PMIX_DATA_BUFFER_RELEASE(rlycopy);
-                PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                continue;
-            }
-            PRTE_RML_SEND(ret, nm->rank, rlycopy, PRTE_RML_TAG_XCAST);
-            if (PRTE_SUCCESS != ret) {
-                PRTE_ERROR_LOG(ret);
-                PMIX_DATA_BUFFER_RELEASE(rlycopy);
-                PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                continue;
-            }
+    if (NULL != rly) {
+        if (PRTE_PROC_IS_MASTER && 0 < prte_grpcomm_direct_xcast_segment_size &&
+            prte_grpcomm_direct_xcast_segment_size < rly->dbuf.bytes_used) {
+            send_segments(rly);
+        } else {
+            relay_to_children(rly, PRTE_RML_TAG_XCAST);
         }
     }
 
 CLEANUP:
     /* cleanup */
     PMIX_LIST_DESTRUCT(&coll);
-    PMIX_DATA_BUFFER_RELEASE(rly); // retain accounting
 
     /* now pass the relay buffer to myself for processing IFF it
      * wasn't just a wireup message - don't
@@ -758,7 +1068,7 @@ static void barrier_release(int status, pmix_proc_t *sender,
     if (NULL != coll->cbfunc) {
         coll->cbfunc(ret, buffer, coll->cbdata);
     }
-    pmix_list_remove_item(&prte_grpcomm_base.ongoing, &coll->super);
+    prte_grpcomm_base_remove_tracker(coll);
     PMIX_RELEASE(coll);
     PMIX_PROC_FREE(sig.signature, sig.sz);
 }
@@ -27,6 +27,34 @@ BEGIN_C_DECLS
 
 PRTE_MODULE_EXPORT extern prte_grpcomm_base_component_t prte_mca_grpcomm_direct_component;
 extern prte_grpcomm_base_module_t prte_grpcomm_direct_module;
+extern size_t prte_grpcomm_direct_xcast_segment_size;
+extern int prte_grpcomm_direct_rcd_max_daemons;
+
+/* refcounted holder for a buffer that is relayed to
+ * several children without being copied */
+typedef struct {
+    pmix_object_t super;
+    pmix_data_buffer_t dbuf;
+} prte_grpcomm_direct_payload_t;
+PMIX_CLASS_DECLARATION(prte_grpcomm_direct_payload_t);
+
+/* tracker for reassembling a segmented xcast */
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t id;
+    size_t total;
+    size_t nrecvd;
+    char *bytes;
+} prte_grpcomm_direct_xfrag_t;
+PMIX_CLASS_DECLARATION(prte_grpcomm_direct_xfrag_t);
+
+/* recursive doubling allgather */
+void prte_grpcomm_direct_rcd_init(void);
+void prte_grpcomm_direct_rcd_finalize(void);
+int prte_grpcomm_direct_rcd_allgather(prte_grpcomm_coll_t *coll, prte_pmix_mdx_caddy_t *cd);
+void prte_grpcomm_direct_rcd_recv(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tag, void *cbdata);
 
 END_C_DECLS
 
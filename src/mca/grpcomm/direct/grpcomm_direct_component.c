@@ -26,6 +26,8 @@
 #include "grpcomm_direct.h"
 
 static int my_priority = 5; /* must be below "bad" module */
+size_t prte_grpcomm_direct_xcast_segment_size = 0;
+int prte_grpcomm_direct_rcd_max_daemons = 0;
 static int direct_open(void);
 static int direct_close(void);
 static int direct_query(pmix_mca_base_module_t **module, int *priority);
@@ -60,6 +62,25 @@ static int direct_register(void)
                                                 "Priority of the grpcomm direct component",
                                                 PMIX_MCA_BASE_VAR_TYPE_INT,
                                                 &my_priority);
+
+    prte_grpcomm_direct_xcast_segment_size = 0;
+    (void) pmix_mca_base_component_var_register(c, "xcast_segment_size",
+                                                "Relay xcast messages larger than this many bytes "
+                                                "as a pipeline of segments of this size, with each "
+                                                "daemon forwarding a segment to its children as soon "
+                                                "as it arrives (0 = always relay the full message)",
+                                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                                &prte_grpcomm_direct_xcast_segment_size);
+
+    prte_grpcomm_direct_rcd_max_daemons = 0;
+    (void) pmix_mca_base_component_var_register(c, "allgather_rcd_max",
+                                                "Run fences across at most this many daemons as a "
+                                                "recursive doubling exchange among the participants "
+                                                "instead of collecting all data at the HNP and "
+                                                "broadcasting it back (0 = never). Must be the same "
+                                                "on all daemons",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_grpcomm_direct_rcd_max_daemons);
     return PRTE_SUCCESS;
 }
 
@@ -0,0 +1,457 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2026      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Recursive doubling allgather among the participating daemons.
+ * Each daemon exchanges everything it has collected so far with
+ * a partner at distance 1, 2, 4, ... so that all of them hold the
+ * complete result after log2(N) steps, without funnelling the
+ * data through the HNP and back down the tree. When the number
+ * of daemons is not a power of two, the "extra" daemons first
+ * fold their contribution into a proxy among the lower ranks,
+ * and receive the final result from it at the end.
+ *
+ * Messages carry the sequence number of the collective so that
+ * a peer that has already finished can start the next instance
+ * with the same signature without confusing us.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+#include "types.h"
+
+#include <string.h>
+
+#include "src/class/pmix_list.h"
+#include "src/pmix/pmix-internal.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/rml/rml.h"
+#include "src/util/name_fns.h"
+#include "src/util/proc_info.h"
+
+#include "grpcomm_direct.h"
+#include "src/mca/grpcomm/base/base.h"
+
+static pmix_list_t rcd_ongoing;
+
+static void rcd_progress(prte_grpcomm_coll_t *coll);
+
+void prte_grpcomm_direct_rcd_init(void)
+{
+    PMIX_CONSTRUCT(&rcd_ongoing, pmix_list_t);
+}
+
+void prte_grpcomm_direct_rcd_finalize(void)
+{
+    PMIX_LIST_DESTRUCT(&rcd_ongoing);
+}
+
+/* decompose the number of participants into the largest
+ * power of two that fits and the number left over */
+static size_t rcd_nsteps(prte_grpcomm_coll_t *coll, size_t *pof2)
+{
+    size_t p = 1, nsteps = 0;
+
+    while (p * 2 <= coll->ndmns) {
+        p *= 2;
+        ++nsteps;
+    }
+    *pof2 = p;
+    return nsteps;
+}
+
+static pmix_rank_t rcd_peer(prte_grpcomm_coll_t *coll, size_t idx)
+{
+    if (NULL == coll->dmns) {
+        return (pmix_rank_t) idx;
+    }
+    return coll->dmns[idx];
+}
+
+static int rank_cmp(const void *a, const void *b)
+{
+    pmix_rank_t ra = *(const pmix_rank_t *) a;
+    pmix_rank_t rb = *(const pmix_rank_t *) b;
+
+    return (ra < rb) ? -1 : ((ra > rb) ? 1 : 0);
+}
+
+static prte_grpcomm_coll_t *rcd_get_tracker(prte_grpcomm_signature_t *sig, uint32_t seq,
+                                            prte_grpcomm_coll_t *base)
+{
+    prte_grpcomm_coll_t *coll;
+    size_t n, nsteps, pof2;
+
+    PMIX_LIST_FOREACH(coll, &rcd_ongoing, prte_grpcomm_coll_t) {
+        if (coll->seq == seq && sig->sz == coll->sig->sz &&
+            0 == memcmp(sig->signature, coll->sig->signature, sig->sz * sizeof(pmix_proc_t))) {
+            if (NULL != base) {
+                /* our peers got here first - adopt the
+                 * local callback and drop the duplicate */
+                coll->cbfunc = base->cbfunc;
+                coll->cbdata = base->cbdata;
+                prte_grpcomm_base_remove_tracker(base);
+                PMIX_RELEASE(base);
+            }
+            return coll;
+        }
+    }
+
+    /* let the base compute the participants for us, but
+     * track it ourselves as we need to match on the seq */
+    if (NULL == base && NULL == (base = prte_grpcomm_base_get_tracker(sig, true))) {
+        return NULL;
+    }
+    prte_grpcomm_base_remove_tracker(base);
+    coll = base;
+    coll->seq = seq;
+    coll->step = 0;
+    coll->nreported = 0;
+
+    /* everyone must agree on the order */
+    if (NULL != coll->dmns) {
+        qsort(coll->dmns, coll->ndmns, sizeof(pmix_rank_t), rank_cmp);
+    }
+    coll->my_rank = coll->ndmns;
+    for (n = 0; n < coll->ndmns; n++) {
+        if (rcd_peer(coll, n) == PRTE_PROC_MY_NAME->rank) {
+            coll->my_rank = n;
+            break;
+        }
+    }
+    nsteps = rcd_nsteps(coll, &pof2);
+    coll->buffers = (pmix_data_buffer_t **) calloc(nsteps + 2, sizeof(pmix_data_buffer_t *));
+    if (NULL == coll->buffers || coll->my_rank == coll->ndmns) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        PMIX_RELEASE(coll);
+        return NULL;
+    }
+    pmix_list_append(&rcd_ongoing, &coll->super);
+    return coll;
+}
+
+static void rcd_send(prte_grpcomm_coll_t *coll, size_t idx, uint32_t step)
+{
+    pmix_data_buffer_t *buf;
+    int rc;
+
+    PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:rcd sending step %u to %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), step,
+                         PRTE_VPID_PRINT(rcd_peer(coll, idx))));
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = PMIx_Data_pack(NULL, buf, &coll->sig->sz, 1, PMIX_SIZE);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, coll->sig->signature, coll->sig->sz, PMIX_PROC);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &coll->seq, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &step, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &coll->status, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &coll->timeout, 1, PMIX_INT);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_copy_payload(buf, &coll->bucket);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        coll->status = rc;
+        return;
+    }
+    PRTE_RML_SEND(rc, rcd_peer(coll, idx), buf, PRTE_RML_TAG_ALLGATHER_RCD);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        coll->status = rc;
+    }
+}
+
+/* fold the data received for the given step into our own. If
+ * replace is true, the data is the complete result */
+static bool rcd_merge(prte_grpcomm_coll_t *coll, size_t step, bool replace)
+{
+    pmix_data_buffer_t *buf = coll->buffers[step];
+    pmix_status_t st;
+    int timeout, cnt, rc;
+
+    if (NULL == buf) {
+        return false;
+    }
+    coll->buffers[step] = NULL;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buf, &st, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buf, &timeout, &cnt, PMIX_INT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        st = rc;
+        timeout = 0;
+    }
+    if (PMIX_SUCCESS != st && (replace || PMIX_SUCCESS == coll->status)) {
+        coll->status = st;
+    }
+    if (coll->timeout < timeout) {
+        coll->timeout = timeout;
+    }
+    if (PMIX_SUCCESS == rc) {
+        if (replace) {
+            PMIX_DATA_BUFFER_DESTRUCT(&coll->bucket);
+            PMIX_DATA_BUFFER_CONSTRUCT(&coll->bucket);
+        }
+        rc = PMIx_Data_copy_payload(&coll->bucket, buf);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            coll->status = rc;
+        }
+    }
+    PMIX_DATA_BUFFER_RELEASE(buf);
+    return true;
+}
+
+static void rcd_complete(prte_grpcomm_coll_t *coll)
+{
+    pmix_data_buffer_t *reply;
+    pmix_byte_object_t bo;
+    size_t n, nsteps, pof2;
+    int rc;
+
+    PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:rcd allgather complete",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+
+    pmix_list_remove_item(&rcd_ongoing, &coll->super);
+    nsteps = rcd_nsteps(coll, &pof2);
+    for (n = 0; n < nsteps + 2; n++) {
+        if (NULL != coll->buffers[n]) {
+            PMIX_DATA_BUFFER_RELEASE(coll->buffers[n]);
+        }
+    }
+
+    /* present the result just as the release from the
+     * HNP would - an empty set of ctrls followed by the
+     * collected data */
+    PMIX_DATA_BUFFER_CREATE(reply);
+    PMIX_BYTE_OBJECT_CONSTRUCT(&bo);
+    rc = PMIx_Data_pack(NULL, reply, &bo, 1, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_copy_payload(reply, &coll->bucket);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        coll->status = rc;
+    }
+    if (NULL != coll->cbfunc) {
+        coll->cbfunc(coll->status, reply, coll->cbdata);
+    }
+    PMIX_DATA_BUFFER_RELEASE(reply);
+    PMIX_RELEASE(coll);
+}
+
+static void rcd_progress(prte_grpcomm_coll_t *coll)
+{
+    size_t r = coll->my_rank, nsteps, pof2, extra;
+
+    /* nothing can move until we have our own contribution */
+    if (0 == coll->nreported) {
+        return;
+    }
+    nsteps = rcd_nsteps(coll, &pof2);
+    extra = coll->ndmns - pof2;
+
+    for (;;) {
+        if (0 == coll->step) {
+            if (r >= pof2) {
+                /* hand our data to our proxy and wait for the result */
+                rcd_send(coll, r - pof2, 0);
+                coll->step = nsteps + 1;
+                continue;
+            }
+            if (r < extra && !rcd_merge(coll, 0, false)) {
+                return;
+            }
+            coll->step = 1;
+            if (1 <= nsteps) {
+                rcd_send(coll, r ^ 1, 1);
+            }
+            continue;
+        }
+        if (r >= pof2) {
+            if (!rcd_merge(coll, nsteps + 1, true)) {
+                return;
+            }
+            break;
+        }
+        if (coll->step <= nsteps) {
+            if (!rcd_merge(coll, coll->step, false)) {
+                return;
+            }
+            ++coll->step;
+            if (coll->step <= nsteps) {
+                rcd_send(coll, r ^ ((size_t) 1 << (coll->step - 1)), coll->step);
+            }
+            continue;
+        }
+        /* we have everything - pass it to anyone we proxied for */
+        if (r < extra) {
+            rcd_send(coll, r + pof2, nsteps + 1);
+        }
+        break;
+    }
+    rcd_complete(coll);
+}
+
+int prte_grpcomm_direct_rcd_allgather(prte_grpcomm_coll_t *coll, prte_pmix_mdx_caddy_t *cd)
+{
+    prte_grpcomm_signature_t *sig;
+    prte_grpcomm_sig_info_t *sinfo;
+    pmix_data_buffer_t ctrlbuf;
+    pmix_info_t *info = NULL;
+    pmix_status_t st;
+    uint32_t seq = 0;
+    size_t n, ninfo = 0;
+    int cnt, rc, timeout;
+
+    PMIX_OUTPUT_VERBOSE((1, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct: rcd allgather across %lu daemons",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned long) coll->ndmns));
+
+    /* the base has already bumped the seq for this signature */
+    sinfo = prte_grpcomm_base_get_sig_info(coll->sig, false);
+    if (NULL != sinfo) {
+        seq = sinfo->seq;
+    }
+
+    sig = coll->sig;
+    PMIX_RETAIN(sig);
+    coll = rcd_get_tracker(sig, seq, coll);
+    PMIX_RELEASE(sig);
+    if (NULL == coll) {
+        return PRTE_ERR_NOT_FOUND;
+    }
+
+    /* pick out the ctrls we can merge */
+    PMIX_DATA_BUFFER_CONSTRUCT(&ctrlbuf);
+    if (0 < cd->ctrls.size) {
+        rc = PMIx_Data_embed(&ctrlbuf, &cd->ctrls);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &ctrlbuf, &ninfo, &cnt, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc && 0 < ninfo) {
+            PMIX_INFO_CREATE(info, ninfo);
+            cnt = ninfo;
+            rc = PMIx_Data_unpack(NULL, &ctrlbuf, info, &cnt, PMIX_INFO);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            coll->status = rc;
+        }
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&ctrlbuf);
+    for (n = 0; NULL != info && n < ninfo; n++) {
+        if (PMIX_CHECK_KEY(&info[n], PMIX_TIMEOUT)) {
+            PMIX_VALUE_GET_NUMBER(rc, &info[n].value, timeout, int);
+            if (PMIX_SUCCESS == rc && coll->timeout < timeout) {
+                coll->timeout = timeout;
+            }
+        } else if (PMIX_CHECK_KEY(&info[n], PMIX_LOCAL_COLLECTIVE_STATUS)) {
+            PMIX_VALUE_GET_NUMBER(rc, &info[n].value, st, pmix_status_t);
+            if (PMIX_SUCCESS == rc && PMIX_SUCCESS != st && PMIX_SUCCESS == coll->status) {
+                coll->status = st;
+            }
+        }
+    }
+    if (NULL != info) {
+        PMIX_INFO_FREE(info, ninfo);
+    }
+
+    /* our own data goes in first */
+    if (NULL != cd->buf) {
+        rc = PMIx_Data_copy_payload(&coll->bucket, cd->buf);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            coll->status = rc;
+        }
+    }
+    coll->nreported = 1;
+
+    rcd_progress(coll);
+    return PRTE_SUCCESS;
+}
+
+void prte_grpcomm_direct_rcd_recv(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tag, void *cbdata)
+{
+    prte_grpcomm_signature_t sig;
+    prte_grpcomm_coll_t *coll;
+    uint32_t seq, step;
+    size_t nsteps, pof2;
+    int cnt, rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    PMIX_OUTPUT_VERBOSE((5, prte_grpcomm_base_framework.framework_output,
+                         "%s grpcomm:direct:rcd recvd from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender)));
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &sig.sz, &cnt, PMIX_SIZE);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    PMIX_PROC_CREATE(sig.signature, sig.sz);
+    cnt = sig.sz;
+    rc = PMIx_Data_unpack(NULL, buffer, sig.signature, &cnt, PMIX_PROC);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &seq, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &step, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_PROC_FREE(sig.signature, sig.sz);
+        return;
+    }
+
+    coll = rcd_get_tracker(&sig, seq, NULL);
+    PMIX_PROC_FREE(sig.signature, sig.sz);
+    if (NULL == coll) {
+        return;
+    }
+    nsteps = rcd_nsteps(coll, &pof2);
+    if (nsteps + 1 < step || NULL != coll->buffers[step]) {
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return;
+    }
+
+    /* hold the rest until we get to this step */
+    PMIX_DATA_BUFFER_CREATE(coll->buffers[step]);
+    rc = PMIx_Data_copy_payload(coll->buffers[step], buffer);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(coll->buffers[step]);
+        return;
+    }
+    rcd_progress(coll);
+}
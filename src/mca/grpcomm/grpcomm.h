@@ -83,6 +83,11 @@ typedef struct {
     size_t ndmns;
     /** my index in the dmns array */
     unsigned long my_rank;
+    /* instance of this signature, for algorithms that
+     * can see contributions to the next one early */
+    uint32_t seq;
+    /* current step of a peer exchange */
+    size_t step;
     /* number of buckets expected */
     size_t nexpected;
     /* number reported in */
@@ -115,6 +120,10 @@ typedef struct {
     size_t nprocs;
     pmix_info_t *info;
     size_t ninfo;
+    /* true if every participant can compute the result
+     * itself - i.e., the collective needs nothing assigned
+     * by the HNP (context IDs, membership changes) */
+    bool symmetric;
     prte_grpcomm_cbfunc_t grpcbfunc;
     pmix_modex_cbfunc_t mdxcbfunc;
     pmix_info_cbfunc_t infocbfunc;
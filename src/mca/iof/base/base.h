@@ -136,7 +136,9 @@ PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_iof_write_output_t);
 
 typedef struct{
     pmix_object_t super;
+    prte_event_t ev;
     pmix_proc_t source;
+    pmix_iof_channel_t channel;
     pmix_byte_object_t bo;
 } prte_iof_deliver_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_iof_deliver_t);
@@ -252,6 +254,19 @@ PRTE_EXPORT void prte_iof_base_output(const pmix_proc_t *source,
                                       pmix_iof_channel_t channel,
                                       char *string);
 
+/* forwarded output may be aggregated into batches of records, each
+ * record consisting of the stream tag, source proc, #bytes and the
+ * bytes themselves. The batch is wrapped for transmission along with
+ * a flag requesting that it be passed along without delay */
+PRTE_EXPORT int prte_iof_base_batch_pack(pmix_data_buffer_t *payload, bool compress,
+                                         bool flush, pmix_data_buffer_t *msg);
+PRTE_EXPORT int prte_iof_base_batch_unpack(pmix_data_buffer_t *msg, bool *flush,
+                                           pmix_data_buffer_t *payload);
+
+/* restart any read events on the given list of procs that were
+ * left idle while output was being held off */
+PRTE_EXPORT void prte_iof_base_resume_reads(pmix_list_t *procs);
+
 END_C_DECLS
 
 #endif /* MCA_IOF_BASE_H */
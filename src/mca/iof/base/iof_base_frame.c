@@ -249,6 +249,7 @@ PMIX_CLASS_INSTANCE(prte_iof_write_output_t, pmix_list_item_t, NULL, NULL);
 
 static void pdcon(prte_iof_deliver_t *p)
 {
+    p->channel = 0;
     p->bo.bytes = NULL;
     p->bo.size = 0;
 }
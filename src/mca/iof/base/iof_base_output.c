@@ -176,3 +176,94 @@ ABORT:
 NEXT_CALL:
     PRTE_IOF_SINK_ACTIVATE(wev);
 }
+
+int prte_iof_base_batch_pack(pmix_data_buffer_t *payload, bool compress,
+                             bool flush, pmix_data_buffer_t *msg)
+{
+    pmix_byte_object_t bo;
+    bool compressed = false;
+    pmix_status_t rc;
+
+    rc = PMIx_Data_pack(NULL, msg, &flush, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (compress
+        && PMIx_Data_compress((uint8_t *) payload->base_ptr, payload->bytes_used,
+                              (uint8_t **) &bo.bytes, &bo.size)) {
+        compressed = true;
+    } else {
+        bo.bytes = payload->base_ptr;
+        bo.size = payload->bytes_used;
+    }
+    rc = PMIx_Data_pack(NULL, msg, &compressed, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, msg, &bo, 1, PMIX_BYTE_OBJECT);
+    }
+    if (compressed) {
+        free(bo.bytes);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+int prte_iof_base_batch_unpack(pmix_data_buffer_t *msg, bool *flush,
+                               pmix_data_buffer_t *payload)
+{
+    pmix_byte_object_t bo;
+    bool compressed;
+    uint8_t *raw;
+    size_t sz;
+    int32_t cnt;
+    pmix_status_t rc;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, msg, flush, &cnt, PMIX_BOOL);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, msg, &compressed, &cnt, PMIX_BOOL);
+    }
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, msg, &bo, &cnt, PMIX_BYTE_OBJECT);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+    if (compressed) {
+        if (!PMIx_Data_decompress((uint8_t *) bo.bytes, bo.size, &raw, &sz)) {
+            PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+            PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+            return PRTE_ERR_UNPACK_FAILURE;
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+        bo.bytes = (char *) raw;
+        bo.size = sz;
+    }
+    rc = PMIx_Data_load(payload, &bo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_BYTE_OBJECT_DESTRUCT(&bo);
+    }
+    return rc;
+}
+
+void prte_iof_base_resume_reads(pmix_list_t *procs)
+{
+    prte_iof_proc_t *proct;
+
+    PMIX_LIST_FOREACH(proct, procs, prte_iof_proc_t) {
+        if (NULL != proct->revstdout && proct->revstdout->activated
+            && !proct->revstdout->active) {
+            PRTE_IOF_READ_ACTIVATE(proct->revstdout);
+        }
+        if (NULL != proct->revstderr && proct->revstderr->activated
+            && !proct->revstderr->active) {
+            PRTE_IOF_READ_ACTIVATE(proct->revstderr);
+        }
+    }
+}
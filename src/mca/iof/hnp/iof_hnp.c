@@ -100,8 +100,18 @@ static int init(void)
      */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_HNP,
                   PRTE_RML_PERSISTENT, prte_iof_hnp_recv, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_BATCH,
+                  PRTE_RML_PERSISTENT, prte_iof_hnp_recv_batch, NULL);
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY,
+                  PRTE_RML_PERSISTENT, prte_iof_hnp_recv_proxy, NULL);
 
     PMIX_CONSTRUCT(&prte_mca_iof_hnp_component.procs, pmix_list_t);
+    prte_mca_iof_hnp_component.pending = 0;
+    prte_mca_iof_hnp_component.xoff = false;
+    prte_mca_iof_hnp_component.spill_fd = -1;
+    prte_mca_iof_hnp_component.spill_rd = 0;
+    prte_mca_iof_hnp_component.spill_wr = 0;
+    prte_mca_iof_hnp_component.dropped = 0;
 
     return PRTE_SUCCESS;
 }
@@ -387,6 +397,10 @@ static void hnp_complete(const prte_job_t *jdata)
 
 static int finalize(void)
 {
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_HNP);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_BATCH);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY);
+    prte_iof_hnp_flow_finalize();
     PMIX_DESTRUCT(&prte_mca_iof_hnp_component.procs);
     return PRTE_SUCCESS;
 }
@@ -65,14 +65,32 @@ struct prte_mca_iof_hnp_component_t {
     prte_iof_base_component_t super;
     pmix_list_t procs;
     prte_event_t stdinsig;
+    /* flow control of forwarded output */
+    size_t pending;
+    bool xoff;
+    int spill_fd;
+    off_t spill_rd;
+    off_t spill_wr;
+    size_t dropped;
 };
 typedef struct prte_mca_iof_hnp_component_t prte_mca_iof_hnp_component_t;
 
 PRTE_MODULE_EXPORT extern prte_mca_iof_hnp_component_t prte_mca_iof_hnp_component;
 extern prte_iof_base_module_t prte_iof_hnp_module;
+extern size_t prte_iof_hnp_xoff_bytes;
+extern size_t prte_iof_hnp_xon_bytes;
+extern size_t prte_iof_hnp_max_bytes;
+extern bool prte_iof_hnp_spill;
 
 void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                        prte_rml_tag_t tag, void *cbdata);
+void prte_iof_hnp_recv_batch(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata);
+void prte_iof_hnp_recv_proxy(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata);
+
+void prte_iof_hnp_deliver(prte_iof_deliver_t *p);
+void prte_iof_hnp_flow_finalize(void);
 
 void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata);
 void prte_iof_hnp_stdin_cb(int fd, short event, void *cbdata);
@@ -39,6 +39,7 @@
 /*
  * Local functions
  */
+static int prte_iof_hnp_register(void);
 static int prte_iof_hnp_open(void);
 static int prte_iof_hnp_close(void);
 static int prte_iof_hnp_query(pmix_mca_base_module_t **module, int *priority);
@@ -46,6 +47,11 @@ static int prte_iof_hnp_query(pmix_mca_base_module_t **module, int *priority);
 /*
  * Public string showing the iof hnp component version number
  */
+size_t prte_iof_hnp_xoff_bytes = 64 * 1024 * 1024;
+size_t prte_iof_hnp_xon_bytes = 16 * 1024 * 1024;
+size_t prte_iof_hnp_max_bytes = 0;
+bool prte_iof_hnp_spill = false;
+
 const char *prte_mca_iof_hnp_component_version_string
     = "PRTE hnp iof MCA component version " PRTE_VERSION;
 
@@ -63,9 +69,46 @@ prte_mca_iof_hnp_component_t prte_mca_iof_hnp_component = {
         .pmix_mca_open_component = prte_iof_hnp_open,
         .pmix_mca_close_component = prte_iof_hnp_close,
         .pmix_mca_query_component = prte_iof_hnp_query,
+        .pmix_mca_register_component_params = prte_iof_hnp_register,
     }
 };
 
+static int prte_iof_hnp_register(void)
+{
+    pmix_mca_base_component_t *c = &prte_mca_iof_hnp_component.super;
+
+    prte_iof_hnp_xoff_bytes = 64 * 1024 * 1024;
+    (void) pmix_mca_base_component_var_register(c, "xoff_bytes",
+                                                "Tell the daemons to stop reading output from "
+                                                "their procs once this many bytes of output are "
+                                                "waiting to be written (0 = never)",
+                                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                                &prte_iof_hnp_xoff_bytes);
+
+    prte_iof_hnp_xon_bytes = 16 * 1024 * 1024;
+    (void) pmix_mca_base_component_var_register(c, "xon_bytes",
+                                                "Tell the daemons to resume reading output once "
+                                                "the backlog has drained to this many bytes",
+                                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                                &prte_iof_hnp_xon_bytes);
+
+    prte_iof_hnp_max_bytes = 0;
+    (void) pmix_mca_base_component_var_register(c, "max_bytes",
+                                                "Maximum number of bytes of output to hold in "
+                                                "memory - output arriving beyond this is dropped "
+                                                "or spilled to a file (0 = unlimited)",
+                                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                                &prte_iof_hnp_max_bytes);
+
+    prte_iof_hnp_spill = false;
+    (void) pmix_mca_base_component_var_register(c, "spill",
+                                                "Spill output beyond iof_hnp_max_bytes to a file "
+                                                "in the session directory instead of dropping it",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_iof_hnp_spill);
+    return PRTE_SUCCESS;
+}
+
 /**
  * component open/close/init function
  */
@@ -49,18 +49,6 @@
 
 #include "iof_hnp.h"
 
-static void lkcbfunc(pmix_status_t status, void *cbdata)
-{
-    prte_iof_deliver_t *p = (prte_iof_deliver_t*)cbdata;
-
-    /* nothing to do here - we use this solely to
-     * ensure that IOF_deliver doesn't block */
-    if (PMIX_SUCCESS != status) {
-        PMIX_ERROR_LOG(status);
-    }
-    PMIX_RELEASE(p);
-}
-
 /* this is the read handler for my own child procs. In this case,
  * the data is going nowhere - I just output it myself
  */
@@ -72,7 +60,6 @@ void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
     prte_iof_proc_t *proct = (prte_iof_proc_t *) rev->proc;
     prte_iof_deliver_t *p;
     pmix_iof_channel_t pchan;
-    pmix_status_t prc;
     PRTE_HIDE_UNUSED_PARAMS(event);
 
     PMIX_ACQUIRE_OBJECT(rev);
@@ -130,14 +117,16 @@ void prte_iof_hnp_read_local_handler(int fd, short event, void *cbdata)
     p->bo.bytes = (char*)malloc(numbytes);
     memcpy(p->bo.bytes, data, numbytes);
     p->bo.size = numbytes;
-    prc = PMIx_server_IOF_deliver(&p->source, pchan, &p->bo, NULL, 0, lkcbfunc, (void*)p);
-    if (PMIX_SUCCESS != prc) {
-        PMIX_ERROR_LOG(prc);
-        PMIX_RELEASE(p);
+    p->channel = pchan;
+    prte_iof_hnp_deliver(p);
+
+    /* re-add the event unless output is being held off */
+    if (prte_mca_iof_hnp_component.xoff) {
+        rev->active = false;
+        PMIX_POST_OBJECT(rev);
+    } else {
+        PRTE_IOF_READ_ACTIVATE(rev);
     }
-
-    /* re-add the event */
-    PRTE_IOF_READ_ACTIVATE(rev);
     return;
 
 CLEAN_RETURN:
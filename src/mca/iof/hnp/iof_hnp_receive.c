@@ -47,26 +47,202 @@
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
 #include "src/util/name_fns.h"
+#include "src/util/pmix_os_path.h"
+#include "src/util/proc_info.h"
 
 #include "src/mca/iof/base/base.h"
 #include "src/mca/iof/iof.h"
 
 #include "iof_hnp.h"
 
+/* header of each record in the spill file */
+typedef struct {
+    pmix_proc_t source;
+    pmix_iof_channel_t channel;
+    size_t size;
+} spill_hdr_t;
+
+static void send_output(prte_iof_deliver_t *p);
+
+/* tell all the daemons to stop or resume reading output */
+static void send_flow(prte_iof_tag_t tag)
+{
+    pmix_proc_t all;
+
+    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s iof:hnp sending %s with %lu bytes pending",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         (PRTE_IOF_XON == tag) ? "xon" : "xoff",
+                         (unsigned long) prte_mca_iof_hnp_component.pending));
+
+    PMIX_LOAD_PROCID(&all, PRTE_PROC_MY_NAME->nspace, PMIX_RANK_WILDCARD);
+    (void) prte_iof_hnp_send_data_to_endpoint(&all, &all, tag, NULL, 0);
+}
+
+/* pass along as much spilled output as we can hold */
+static void drain_spill(void)
+{
+    prte_mca_iof_hnp_component_t *c = &prte_mca_iof_hnp_component;
+    prte_iof_deliver_t *p;
+    spill_hdr_t hdr;
+
+    while (c->spill_rd < c->spill_wr
+           && (0 == prte_iof_hnp_max_bytes || c->pending < prte_iof_hnp_max_bytes)) {
+        if (sizeof(hdr) != pread(c->spill_fd, &hdr, sizeof(hdr), c->spill_rd)) {
+            PRTE_ERROR_LOG(PRTE_ERR_FILE_READ_FAILURE);
+            break;
+        }
+        p = PMIX_NEW(prte_iof_deliver_t);
+        PMIX_XFER_PROCID(&p->source, &hdr.source);
+        p->channel = hdr.channel;
+        p->bo.bytes = (char *) malloc(hdr.size);
+        p->bo.size = hdr.size;
+        if ((ssize_t) hdr.size != pread(c->spill_fd, p->bo.bytes, hdr.size,
+                                        c->spill_rd + sizeof(hdr))) {
+            PRTE_ERROR_LOG(PRTE_ERR_FILE_READ_FAILURE);
+            PMIX_RELEASE(p);
+            break;
+        }
+        c->spill_rd += sizeof(hdr) + hdr.size;
+        send_output(p);
+    }
+    if (c->spill_rd < c->spill_wr) {
+        return;
+    }
+    /* everything has been passed along - start over */
+    c->spill_rd = 0;
+    c->spill_wr = 0;
+    if (0 <= c->spill_fd && 0 != ftruncate(c->spill_fd, 0)) {
+        PRTE_ERROR_LOG(PRTE_ERR_FILE_WRITE_FAILURE);
+    }
+}
+
+/* the PMIx server is done with some output - executed
+ * in the event base */
+static void delivered(int sd, short args, void *cbdata)
+{
+    prte_iof_deliver_t *p = (prte_iof_deliver_t *) cbdata;
+    prte_mca_iof_hnp_component_t *c = &prte_mca_iof_hnp_component;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(p);
+    c->pending -= p->bo.size;
+    PMIX_RELEASE(p);
+
+    if (c->spill_rd < c->spill_wr) {
+        drain_spill();
+    }
+    if (c->xoff && c->pending <= prte_iof_hnp_xon_bytes && c->spill_rd == c->spill_wr) {
+        c->xoff = false;
+        send_flow(PRTE_IOF_XON);
+        prte_iof_base_resume_reads(&c->procs);
+    }
+}
+
 static void lkcbfunc(pmix_status_t status, void *cbdata)
 {
     prte_iof_deliver_t *p = (prte_iof_deliver_t*)cbdata;
 
-    /* nothing to do here - we use this solely to
-     * ensure that IOF_deliver doesn't block */
     if (PMIX_SUCCESS != status) {
         PMIX_ERROR_LOG(status);
     }
+    /* we track how much output the server is holding, so
+     * account for this in our own event base */
+    PRTE_PMIX_THREADSHIFT(p, prte_event_base, delivered);
+}
+
+static void send_output(prte_iof_deliver_t *p)
+{
+    prte_mca_iof_hnp_component_t *c = &prte_mca_iof_hnp_component;
+    pmix_status_t prc;
+
+    c->pending += p->bo.size;
+    prc = PMIx_server_IOF_deliver(&p->source, p->channel, &p->bo, NULL, 0, lkcbfunc, (void*)p);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        c->pending -= p->bo.size;
+        PMIX_RELEASE(p);
+        return;
+    }
+    if (!c->xoff && 0 < prte_iof_hnp_xoff_bytes && prte_iof_hnp_xoff_bytes <= c->pending) {
+        c->xoff = true;
+        send_flow(PRTE_IOF_XOFF);
+    }
+}
+
+/* we are holding all the output we are allowed - either
+ * spill this to a file or drop it */
+static void overflow(prte_iof_deliver_t *p)
+{
+    prte_mca_iof_hnp_component_t *c = &prte_mca_iof_hnp_component;
+    spill_hdr_t hdr;
+    char *path;
+
+    if (prte_iof_hnp_spill && 0 > c->spill_fd && NULL != prte_process_info.top_session_dir) {
+        path = pmix_os_path(false, prte_process_info.top_session_dir, "iof.spill", NULL);
+        c->spill_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (0 > c->spill_fd) {
+            pmix_output(0, "%s iof:hnp could not open spill file %s: %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), path, strerror(errno));
+            prte_iof_hnp_spill = false;
+        }
+        free(path);
+    }
+
+    if (prte_iof_hnp_spill && 0 <= c->spill_fd) {
+        memset(&hdr, 0, sizeof(hdr));
+        PMIX_XFER_PROCID(&hdr.source, &p->source);
+        hdr.channel = p->channel;
+        hdr.size = p->bo.size;
+        if (sizeof(hdr) == pwrite(c->spill_fd, &hdr, sizeof(hdr), c->spill_wr)
+            && (ssize_t) hdr.size == pwrite(c->spill_fd, p->bo.bytes, hdr.size,
+                                            c->spill_wr + sizeof(hdr))) {
+            c->spill_wr += sizeof(hdr) + hdr.size;
+            PMIX_RELEASE(p);
+            return;
+        }
+        PRTE_ERROR_LOG(PRTE_ERR_FILE_WRITE_FAILURE);
+    }
+
+    if (0 == c->dropped) {
+        pmix_output(0, "IO Forwarding is running too far behind - output is being "
+                       "discarded");
+    }
+    c->dropped += p->bo.size;
     PMIX_RELEASE(p);
 }
 
-void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
-                       prte_rml_tag_t tag, void *cbdata)
+/* output this thru our PMIx server, holding it back if
+ * the server already has all it is allowed */
+void prte_iof_hnp_deliver(prte_iof_deliver_t *p)
+{
+    prte_mca_iof_hnp_component_t *c = &prte_mca_iof_hnp_component;
+
+    /* anything already spilled must go first to preserve order */
+    if (c->spill_rd < c->spill_wr
+        || (0 < prte_iof_hnp_max_bytes && prte_iof_hnp_max_bytes < c->pending + p->bo.size)) {
+        overflow(p);
+        return;
+    }
+    send_output(p);
+}
+
+void prte_iof_hnp_flow_finalize(void)
+{
+    prte_mca_iof_hnp_component_t *c = &prte_mca_iof_hnp_component;
+
+    if (0 < c->dropped) {
+        pmix_output(0, "IO Forwarding discarded %lu bytes of output",
+                    (unsigned long) c->dropped);
+    }
+    if (0 <= c->spill_fd) {
+        close(c->spill_fd);
+        c->spill_fd = -1;
+    }
+}
+
+/* process one forwarded output record */
+static int process_record(pmix_data_buffer_t *buffer)
 {
     pmix_proc_t origin;
     prte_iof_tag_t stream;
@@ -75,19 +251,18 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
     prte_iof_proc_t *proct;
     pmix_iof_channel_t pchan;
     prte_iof_deliver_t *p;
-    pmix_status_t prc;
-    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
-
-    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
-                         "%s received IOF msg from proc %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                         PRTE_NAME_PRINT(sender)));
 
     /* unpack the stream first as this may be flow control info */
     count = 1;
     rc = PMIx_Data_unpack(NULL, buffer, &stream, &count, PMIX_UINT16);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+        return rc;
+    }
+    if (PRTE_IOF_XON == stream || PRTE_IOF_XOFF == stream) {
+        /* a daemon's stdin backlog - we learn of that thru
+         * push_stdin, so there is nothing more to do */
+        return PRTE_SUCCESS;
     }
 
     /* get name of the process whose io we are discussing */
@@ -95,7 +270,7 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
     rc = PMIx_Data_unpack(NULL, buffer, &origin, &count, PMIX_PROC);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+        return rc;
     }
 
     PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
@@ -107,11 +282,11 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
     rc = PMIx_Data_unpack(NULL, buffer, &numbytes, &count, PMIX_INT32);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        goto CLEAN_RETURN;
+        return rc;
     }
     if (0 == numbytes) {
         /* nothing to do - shouldn't have been sent */
-        goto CLEAN_RETURN;
+        return PRTE_SUCCESS;
     }
     p = PMIX_NEW(prte_iof_deliver_t);
     PMIX_XFER_PROCID(&p->source, &origin);
@@ -120,7 +295,7 @@ void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buff
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         PMIX_RELEASE(p);
-        goto CLEAN_RETURN;
+        return rc;
     }
     p->bo.size = numbytes;
 
@@ -154,12 +329,52 @@ NSTEP:
         pchan |= PMIX_FWD_STDDIAG_CHANNEL;
     }
     /* output this thru our PMIx server */
-    prc = PMIx_server_IOF_deliver(&p->source, pchan, &p->bo, NULL, 0, lkcbfunc, (void*)p);
-    if (PMIX_SUCCESS != prc) {
-        PMIX_ERROR_LOG(prc);
-        PMIX_RELEASE(p);
+    p->channel = pchan;
+    prte_iof_hnp_deliver(p);
+    return PRTE_SUCCESS;
+}
+
+void prte_iof_hnp_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                       prte_rml_tag_t tag, void *cbdata)
+{
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s received IOF msg from proc %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                         PRTE_NAME_PRINT(sender)));
+
+    (void) process_record(buffer);
+}
+
+/* a batch of output aggregated by the daemons - process
+ * each of the records in it */
+void prte_iof_hnp_recv_batch(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata)
+{
+    pmix_data_buffer_t payload;
+    bool flush;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s received IOF batch of %d bytes from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) buffer->bytes_used,
+                         PRTE_NAME_PRINT(sender)));
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&payload);
+    rc = prte_iof_base_batch_unpack(buffer, &flush, &payload);
+    while (PRTE_SUCCESS == rc
+           && (size_t) (payload.unpack_ptr - payload.base_ptr) < payload.bytes_used) {
+        rc = process_record(&payload);
     }
+    PMIX_DATA_BUFFER_DESTRUCT(&payload);
+}
 
-CLEAN_RETURN:
-    return;
+/* we get our own copy of anything xcast to the daemons on the
+ * proxy tag, such as flow control - there is nothing for us to
+ * do with it, but it has to be consumed */
+void prte_iof_hnp_recv_proxy(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                             prte_rml_tag_t tag, void *cbdata)
+{
+    PRTE_HIDE_UNUSED_PARAMS(status, sender, buffer, tag, cbdata);
 }
@@ -47,6 +47,7 @@
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/odls/odls_types.h"
+#include "src/mca/state/base/base.h"
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
 #include "src/threads/pmix_threads.h"
@@ -96,10 +97,25 @@ static int init(void)
      from the HNP IOF component */
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY,
                   PRTE_RML_PERSISTENT, prte_iof_prted_recv, NULL);
+    /* always listen for batches from our children - they may
+     * be aggregating even if we are not */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_BATCH,
+                  PRTE_RML_PERSISTENT, prte_iof_prted_recv_batch, NULL);
 
     /* setup the local global variables */
     PMIX_CONSTRUCT(&prte_mca_iof_prted_component.procs, pmix_list_t);
     prte_mca_iof_prted_component.xoff = false;
+    prte_mca_iof_prted_component.paused = false;
+    PMIX_DATA_BUFFER_CONSTRUCT(&prte_mca_iof_prted_component.batch);
+    prte_event_evtimer_set(prte_event_base, &prte_mca_iof_prted_component.batch_ev,
+                           prte_iof_prted_batch_timer, NULL);
+    prte_mca_iof_prted_component.batch_pending = false;
+    if (0 < prte_iof_prted_batch_max) {
+        /* batches are merged at each daemon on the way up the tree,
+         * so the proc state reports must take the same path or they
+         * could reach the HNP ahead of the final output of a proc */
+        prte_state_base.report_relay = true;
+    }
 
     return PRTE_SUCCESS;
 }
@@ -289,10 +305,15 @@ static void prted_complete(const prte_job_t *jdata)
 
 static int finalize(void)
 {
+    /* push out anything still waiting to go */
+    prte_iof_prted_batch_flush(true);
+    PMIX_DATA_BUFFER_DESTRUCT(&prte_mca_iof_prted_component.batch);
+
     PMIX_LIST_DESTRUCT(&prte_mca_iof_prted_component.procs);
 
-    /* Cancel the RML receive */
+    /* Cancel the RML receives */
     PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_PROXY);
+    PRTE_RML_CANCEL(PRTE_NAME_WILDCARD, PRTE_RML_TAG_IOF_BATCH);
     return PRTE_SUCCESS;
 }
 
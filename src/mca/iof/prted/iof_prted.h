@@ -46,6 +46,18 @@
  * SOURCEs don't overwhelm SINK resources (E.g., send an entire input
  * file to an prted before the target process has read any of it).
  *
+ * Output may optionally be aggregated into batches that are sent
+ * to our parent in the routing tree once they reach a given size
+ * or age. Batches received from our children are merged into our
+ * own so the HNP sees one message per subtree rather than one per
+ * read.
+ *
+ * The HNP tells us to stop reading output from our local procs
+ * (XOFF) when more output is waiting to be written than it is
+ * willing to hold, and to resume (XON) once that has drained. The
+ * procs then block on their pipes instead of the HNP running out
+ * of memory.
+ *
  */
 #ifndef PRTE_IOF_PRTED_H
 #define PRTE_IOF_PRTED_H
@@ -66,11 +78,18 @@ struct prte_mca_iof_prted_component_t {
     prte_iof_base_component_t super;
     pmix_list_t procs;
     bool xoff;
+    bool paused;
+    pmix_data_buffer_t batch;
+    prte_event_t batch_ev;
+    bool batch_pending;
 };
 typedef struct prte_mca_iof_prted_component_t prte_mca_iof_prted_component_t;
 
 PRTE_MODULE_EXPORT extern prte_mca_iof_prted_component_t prte_mca_iof_prted_component;
 extern prte_iof_base_module_t prte_iof_prted_module;
+extern size_t prte_iof_prted_batch_max;
+extern int prte_iof_prted_batch_usec;
+extern bool prte_iof_prted_batch_compress;
 
 void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                          prte_rml_tag_t tag, void *cbdata);
@@ -78,6 +97,12 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
 void prte_iof_prted_read_handler(int fd, short event, void *data);
 void prte_iof_prted_send_xonxoff(prte_iof_tag_t tag);
 
+void prte_iof_prted_recv_batch(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                               prte_rml_tag_t tag, void *cbdata);
+void prte_iof_prted_batch_append(pmix_data_buffer_t *records, bool flush);
+void prte_iof_prted_batch_flush(bool flush);
+void prte_iof_prted_batch_timer(int fd, short args, void *cbdata);
+
 END_C_DECLS
 
 #endif
@@ -35,6 +35,7 @@
 /*
  * Local functions
  */
+static int prte_iof_prted_register(void);
 static int prte_iof_prted_open(void);
 static int prte_iof_prted_close(void);
 static int prte_iof_prted_query(pmix_mca_base_module_t **module, int *priority);
@@ -42,6 +43,10 @@ static int prte_iof_prted_query(pmix_mca_base_module_t **module, int *priority);
 /*
  * Public string showing the iof prted component version number
  */
+size_t prte_iof_prted_batch_max = 0;
+int prte_iof_prted_batch_usec = 10000;
+bool prte_iof_prted_batch_compress = false;
+
 const char *prte_mca_iof_prted_component_version_string
     = "PRTE prted iof MCA component version " PRTE_VERSION;
 
@@ -59,9 +64,38 @@ prte_mca_iof_prted_component_t prte_mca_iof_prted_component = {
         .pmix_mca_open_component = prte_iof_prted_open,
         .pmix_mca_close_component = prte_iof_prted_close,
         .pmix_mca_query_component = prte_iof_prted_query,
+        .pmix_mca_register_component_params = prte_iof_prted_register,
     }
 };
 
+static int prte_iof_prted_register(void)
+{
+    pmix_mca_base_component_t *c = &prte_mca_iof_prted_component.super;
+
+    prte_iof_prted_batch_max = 0;
+    (void) pmix_mca_base_component_var_register(c, "batch_size",
+                                                "Aggregate forwarded output from local procs and "
+                                                "from the daemons below us in the routing tree, "
+                                                "sending it upward once this many bytes are "
+                                                "pending (0 = forward each read as it occurs)",
+                                                PMIX_MCA_BASE_VAR_TYPE_SIZE_T,
+                                                &prte_iof_prted_batch_max);
+
+    prte_iof_prted_batch_usec = 10000;
+    (void) pmix_mca_base_component_var_register(c, "batch_timeout",
+                                                "Maximum time in microseconds that aggregated "
+                                                "output is held before being sent upward",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_iof_prted_batch_usec);
+
+    prte_iof_prted_batch_compress = false;
+    (void) pmix_mca_base_component_var_register(c, "batch_compress",
+                                                "Compress aggregated output before sending it",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_iof_prted_batch_compress);
+    return PRTE_SUCCESS;
+}
+
 /**
  * component open/close/init function
  */
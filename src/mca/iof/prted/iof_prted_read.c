@@ -162,6 +162,13 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
         goto CLEAN_RETURN;
     }
 
+    if (0 < prte_iof_prted_batch_max) {
+        /* hold it for aggregation with other output */
+        prte_iof_prted_batch_append(buf, false);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        goto REACTIVATE;
+    }
+
     /* start non-blocking RML call to forward received data */
     PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
                          "%s iof:prted:read handler sending %d bytes to HNP",
@@ -172,9 +179,16 @@ void prte_iof_prted_read_handler(int fd, short event, void *cbdata)
         PRTE_ERROR_LOG(rc);
         PMIX_DATA_BUFFER_RELEASE(buf);
     }
-    /* re-add the event */
-    PRTE_IOF_READ_ACTIVATE(rev);
 
+REACTIVATE:
+    /* re-add the event unless the HNP has asked us to hold off - the
+     * proc will block on its pipe until we are told to resume */
+    if (prte_mca_iof_prted_component.paused) {
+        rev->active = false;
+        PMIX_POST_OBJECT(rev);
+    } else {
+        PRTE_IOF_READ_ACTIVATE(rev);
+    }
     return;
 
 CLEAN_RETURN:
@@ -193,6 +207,9 @@ CLEAN_RETURN:
     }
     /* check to see if they are all done */
     if (NULL == proct->revstdout && NULL == proct->revstderr) {
+        /* make sure any output we are holding for it gets
+         * on its way before we declare it complete */
+        prte_iof_prted_batch_flush(true);
         /* this proc's iof is complete */
         PRTE_ACTIVATE_PROC_STATE(&proct->name, PRTE_PROC_STATE_IOF_COMPLETE);
     }
@@ -201,3 +218,73 @@ CLEAN_RETURN:
     }
     return;
 }
+
+/* add a set of output records to the pending batch, sending it
+ * on if it has grown large enough or we were asked to flush it */
+void prte_iof_prted_batch_append(pmix_data_buffer_t *records, bool flush)
+{
+    prte_mca_iof_prted_component_t *c = &prte_mca_iof_prted_component;
+    struct timeval tv;
+    pmix_status_t rc;
+
+    rc = PMIx_Data_copy_payload(&c->batch, records);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return;
+    }
+    if (flush || prte_iof_prted_batch_max <= c->batch.bytes_used) {
+        prte_iof_prted_batch_flush(flush);
+        return;
+    }
+    if (!c->batch_pending) {
+        tv.tv_sec = prte_iof_prted_batch_usec / 1000000;
+        tv.tv_usec = prte_iof_prted_batch_usec % 1000000;
+        prte_event_evtimer_add(&c->batch_ev, &tv);
+        c->batch_pending = true;
+    }
+}
+
+/* send the pending batch to our parent - a batch sent with the
+ * flush flag set will not be held by the daemons it passes thru */
+void prte_iof_prted_batch_flush(bool flush)
+{
+    prte_mca_iof_prted_component_t *c = &prte_mca_iof_prted_component;
+    pmix_data_buffer_t *buf;
+    int rc;
+
+    if (c->batch_pending) {
+        prte_event_evtimer_del(&c->batch_ev);
+        c->batch_pending = false;
+    }
+    if (0 == c->batch.bytes_used) {
+        return;
+    }
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    rc = prte_iof_base_batch_pack(&c->batch, prte_iof_prted_batch_compress, flush, buf);
+    PMIX_DATA_BUFFER_DESTRUCT(&c->batch);
+    PMIX_DATA_BUFFER_CONSTRUCT(&c->batch);
+    if (PRTE_SUCCESS != rc) {
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+
+    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s iof:prted sending batch of %d bytes to %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) buf->bytes_used,
+                         PRTE_VPID_PRINT(prte_rml_base.lifeline)));
+
+    PRTE_RML_SEND(rc, prte_rml_base.lifeline, buf, PRTE_RML_TAG_IOF_BATCH);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+}
+
+void prte_iof_prted_batch_timer(int fd, short args, void *cbdata)
+{
+    PRTE_HIDE_UNUSED_PARAMS(fd, args, cbdata);
+
+    prte_mca_iof_prted_component.batch_pending = false;
+    prte_iof_prted_batch_flush(false);
+}
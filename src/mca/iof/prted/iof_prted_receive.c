@@ -79,7 +79,8 @@ void prte_iof_prted_send_xonxoff(prte_iof_tag_t tag)
  * (a) stdin, which is to be copied to whichever local
  *     procs "pull'd" a copy
  *
- * (b) flow control messages
+ * (b) flow control messages telling us to stop or resume
+ *     reading output from our local procs
  */
 void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
                          prte_rml_tag_t tag, void *cbdata)
@@ -100,6 +101,20 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
         return;
     }
 
+    if (PRTE_IOF_XOFF == stream) {
+        PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                             "%s holding output", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+        prte_mca_iof_prted_component.paused = true;
+        return;
+    }
+    if (PRTE_IOF_XON == stream) {
+        PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                             "%s resuming output", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME)));
+        prte_mca_iof_prted_component.paused = false;
+        prte_iof_base_resume_reads(&prte_mca_iof_prted_component.procs);
+        return;
+    }
+
     /* if this isn't stdin, then we have an error */
     if (PRTE_IOF_STDIN != stream) {
         PRTE_ERROR_LOG(PRTE_ERR_COMM_FAILURE);
@@ -160,3 +175,26 @@ void prte_iof_prted_recv(int status, pmix_proc_t *sender, pmix_data_buffer_t *bu
         }
     }
 }
+
+/* a batch of output from the daemons below us - merge it
+ * into our own so it continues up the tree with our output */
+void prte_iof_prted_recv_batch(int status, pmix_proc_t *sender, pmix_data_buffer_t *buffer,
+                               prte_rml_tag_t tag, void *cbdata)
+{
+    pmix_data_buffer_t payload;
+    bool flush;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    PMIX_OUTPUT_VERBOSE((1, prte_iof_base_framework.framework_output,
+                         "%s received IOF batch of %d bytes from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) buffer->bytes_used,
+                         PRTE_NAME_PRINT(sender)));
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&payload);
+    rc = prte_iof_base_batch_unpack(buffer, &flush, &payload);
+    if (PRTE_SUCCESS == rc) {
+        prte_iof_prted_batch_append(&payload, flush);
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&payload);
+}
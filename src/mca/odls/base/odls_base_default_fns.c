@@ -154,12 +154,11 @@ done:
  */
 int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_nspace_t job)
 {
-    int rc, n;
+    int rc;
     prte_job_t *jdata = NULL, *jptr;
     prte_job_map_t *map = NULL;
     pmix_data_buffer_t jobdata, priorjob;
     int8_t flag;
-    prte_proc_t *proc;
     pmix_status_t ret;
     prte_node_t *node;
     int i, k;
@@ -205,28 +204,15 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
             /* skip the one we are launching now */
             if (jptr != jdata) {
                 PMIX_DATA_BUFFER_CONSTRUCT(&priorjob);
-                /* pack the job struct */
-                rc = prte_job_pack(&priorjob, jptr);
+                /* pack the job struct - this includes the
+                 * location of each proc */
+                rc = prte_job_pack_launch(&priorjob, jptr);
                 if (PMIX_SUCCESS != rc) {
                     PMIX_ERROR_LOG(rc);
                     PMIX_DATA_BUFFER_DESTRUCT(&jobdata);
                     PMIX_DATA_BUFFER_DESTRUCT(&priorjob);
                     return rc;
                 }
-                /* pack the location of each proc */
-                for (n = 0; n < jptr->procs->size; n++) {
-                    if (NULL
-                        == (proc = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, n))) {
-                        continue;
-                    }
-                    rc = PMIx_Data_pack(NULL, &priorjob, &proc->parent, 1, PMIX_PROC_RANK);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_DATA_BUFFER_DESTRUCT(&jobdata);
-                        PMIX_DATA_BUFFER_DESTRUCT(&priorjob);
-                        return rc;
-                    }
-                }
                 /* unload the buffer */
                 rc = PMIx_Data_unload(&priorjob, &pbo);
                 if (PMIX_SUCCESS != rc) {
@@ -269,7 +255,7 @@ int prte_odls_base_default_get_add_procs_data(pmix_data_buffer_t *buffer, pmix_n
     }
 
     /* pack the job struct */
-    rc = prte_job_pack(buffer, jdata);
+    rc = prte_job_pack_launch(buffer, jdata);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         return rc;
@@ -401,7 +387,7 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
     int32_t cnt;
     prte_job_t *jdata = NULL, *daemons;
     prte_node_t *node;
-    pmix_rank_t dmnvpid, v;
+    pmix_rank_t v;
     int32_t n;
     pmix_data_buffer_t dbuf, jdbuf;
     prte_proc_t *pptr, *dmn;
@@ -469,7 +455,7 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
             }
             /* unpack each job and add it to the local prte_job_data array */
             cnt = 1;
-            rc = prte_job_unpack(&jdbuf, &jdata);
+            rc = prte_job_unpack_launch(&jdbuf, &jdata);
             if (PRTE_SUCCESS != rc) {
                 PRTE_ERROR_LOG(rc);
                 PMIX_DATA_BUFFER_DESTRUCT(&dbuf);
@@ -484,26 +470,16 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
             } else {
                 /* nope - add it */
                 prte_set_job_data_object(jdata);
-                /* unpack the location of each proc in this job */
+                /* connect each proc in this job to its location */
                 for (v = 0; v < jdata->num_procs; v++) {
                     if (NULL
                         == (pptr = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, v))) {
-                        pptr = PMIX_NEW(prte_proc_t);
-                        PMIX_LOAD_PROCID(&pptr->name, jdata->nspace, v);
-                        pmix_pointer_array_set_item(jdata->procs, v, pptr);
-                    }
-                    cnt = 1;
-                    rc = PMIx_Data_unpack(NULL, &jdbuf, &dmnvpid, &cnt, PMIX_PROC_RANK);
-                    if (PMIX_SUCCESS != rc) {
-                        PMIX_ERROR_LOG(rc);
-                        PMIX_DATA_BUFFER_DESTRUCT(&dbuf);
-                        PMIX_DATA_BUFFER_DESTRUCT(&jdbuf);
-                        goto REPORT_ERROR;
+                        continue;
                     }
                     /* lookup the daemon */
                     if (NULL
                         == (dmn = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs,
-                                                                              dmnvpid))) {
+                                                                              pptr->parent))) {
                         PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
                         rc = PRTE_ERR_NOT_FOUND;
                         PMIX_DATA_BUFFER_DESTRUCT(&dbuf);
@@ -550,7 +526,7 @@ int prte_odls_base_default_construct_child_list(pmix_data_buffer_t *buffer, pmix
 
 next:
     /* unpack the job we are to launch */
-    rc = prte_job_unpack(buffer, &jdata);
+    rc = prte_job_unpack_launch(buffer, &jdata);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         goto REPORT_ERROR;
@@ -1097,6 +1073,8 @@ void prte_odls_base_spawn_proc(int fd, short sd, void *cbdata)
         state = PRTE_PROC_STATE_FAILED_TO_START;
         goto errorout;
     }
+    /* let the waitpid callback find the child directly */
+    prte_wait_track(child);
     if (PRTE_PROC_IS_MASTER) {
         /* locally store the pid */
         pidval.type = PMIX_PID;
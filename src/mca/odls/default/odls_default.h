@@ -42,6 +42,9 @@ int prte_mca_odls_default_component_open(void);
 int prte_mca_odls_default_component_close(void);
 int prte_mca_odls_default_component_query(pmix_mca_base_module_t **module, int *priority);
 
+/* use posix_spawn to launch procs when possible */
+extern bool prte_odls_default_use_spawn;
+
 /*
  * ODLS Default module
  */
@@ -45,6 +45,8 @@
 #include "src/mca/odls/default/odls_default.h"
 #include "src/mca/odls/base/base.h"
 
+static int default_register(void);
+
 /*
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
@@ -63,8 +65,25 @@ prte_odls_base_component_t prte_mca_odls_default_component = {
     .pmix_mca_open_component = prte_mca_odls_default_component_open,
     .pmix_mca_close_component = prte_mca_odls_default_component_close,
     .pmix_mca_query_component = prte_mca_odls_default_component_query,
+    .pmix_mca_register_component_params = default_register,
 };
 
+bool prte_odls_default_use_spawn = true;
+
+static int default_register(void)
+{
+    pmix_mca_base_component_t *c = &prte_mca_odls_default_component;
+
+    prte_odls_default_use_spawn = true;
+    (void) pmix_mca_base_component_var_register(c, "use_spawn",
+                                                "Launch procs with posix_spawn instead of fork/exec "
+                                                "whenever no setup is required in the child that "
+                                                "posix_spawn cannot perform",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_odls_default_use_spawn);
+    return PRTE_SUCCESS;
+}
+
 int prte_mca_odls_default_component_open(void)
 {
     return PRTE_SUCCESS;
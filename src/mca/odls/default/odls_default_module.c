@@ -67,6 +67,15 @@
  * - if the problem was an error, the child exits and the parent
  *   handles the death of the child as appropriate (i.e., this ODLS
  *   simply reports the error -- other things decide what to do).
+ *
+ * None of that is needed when the child has nothing to do before
+ * exec'ing beyond rearranging its file descriptors, resetting its
+ * signals and (possibly) binding itself to a set of cpus. In that
+ * case we launch it with posix_spawn instead: the binding is inherited
+ * from the spawning thread, and exec failures are returned directly
+ * by posix_spawn. This avoids copying the page tables of the (large)
+ * daemon for every child and waiting on the pipe before moving on to
+ * the next one.
  */
 
 #include "prte_config.h"
@@ -113,6 +122,13 @@
 #ifdef HAVE_SYS_PTRACE_H
 #    include <sys/ptrace.h>
 #endif
+#if defined(HAVE_SPAWN_H) && defined(HAVE_POSIX_SPAWN) \
+    && defined(HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCLOSEFROM_NP)
+#    include <spawn.h>
+#    define PRTE_ODLS_DEFAULT_HAVE_SPAWN 1
+#else
+#    define PRTE_ODLS_DEFAULT_HAVE_SPAWN 0
+#endif
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/hwloc/hwloc-internal.h"
@@ -120,6 +136,7 @@
 #include "src/util/pmix_fd.h"
 #include "src/util/pmix_environ.h"
 #include "src/util/pmix_show_help.h"
+#include "src/util/pmix_string_copy.h"
 #include "src/util/sys_limits.h"
 
 #include "src/mca/errmgr/errmgr.h"
@@ -587,6 +604,176 @@ static int do_parent(prte_odls_spawn_caddy_t *cd, int read_fd)
     return PRTE_SUCCESS;
 }
 
+#if PRTE_ODLS_DEFAULT_HAVE_SPAWN
+/*
+ * Launch the specified process with posix_spawn. Returns
+ * PRTE_ERR_NOT_SUPPORTED if the child requires setup that can
+ * only be done by forking, in which case nothing has been done
+ */
+static int spawn_local_proc(prte_odls_spawn_caddy_t *cd)
+{
+    prte_proc_t *child = cd->child;
+    posix_spawn_file_actions_t fa;
+    posix_spawnattr_t attr;
+    hwloc_cpuset_t cpuset = NULL, prior = NULL;
+    sigset_t sigs;
+    short flags;
+    pid_t pid;
+    int rc;
+    char dir[MAXPATHLEN], *msg;
+    struct stat stats;
+
+    if (!prte_odls_default_use_spawn || NULL == child || cd->opts.usepty
+        || prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_REPORT_BINDINGS, NULL, PMIX_BOOL)) {
+        return PRTE_ERR_NOT_SUPPORTED;
+    }
+#if PRTE_HAVE_STOP_ON_EXEC
+    if (prte_get_attribute(&cd->jdata->attributes, PRTE_JOB_STOP_ON_EXEC, NULL, PMIX_BOOL)) {
+        return PRTE_ERR_NOT_SUPPORTED;
+    }
+#endif
+#ifndef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+    if (NULL != cd->wdir) {
+        return PRTE_ERR_NOT_SUPPORTED;
+    }
+#endif
+
+    /* the child inherits the binding of the thread that spawns
+     * it, so temporarily bind ourselves as the child is to be
+     * bound. Anything out of the ordinary is left to the rtc
+     * framework in a forked child so it can be reported properly */
+    if (NULL != child->cpuset && 0 < strlen(child->cpuset)) {
+        if (PRTE_HWLOC_BASE_MAP_NONE != prte_hwloc_base_map) {
+            /* memory binding must be done by the child itself */
+            return PRTE_ERR_NOT_SUPPORTED;
+        }
+        cpuset = hwloc_bitmap_alloc();
+        if (NULL == cpuset || 0 != hwloc_bitmap_list_sscanf(cpuset, child->cpuset)) {
+            hwloc_bitmap_free(cpuset);
+            return PRTE_ERR_NOT_SUPPORTED;
+        }
+    } else if (NULL != prte_daemon_cores) {
+        /* we are bound, so we have to "free" the child */
+#if HWLOC_API_VERSION < 0x20000
+        cpuset = hwloc_bitmap_dup(hwloc_get_root_obj(prte_hwloc_topology)->allowed_cpuset);
+#else
+        cpuset = hwloc_bitmap_dup(hwloc_topology_get_allowed_cpuset(prte_hwloc_topology));
+#endif
+    }
+    if (NULL != cpuset) {
+        prior = hwloc_bitmap_alloc();
+        if (NULL == prior
+            || 0 != hwloc_get_cpubind(prte_hwloc_topology, prior, HWLOC_CPUBIND_THREAD)
+            || 0 != hwloc_set_cpubind(prte_hwloc_topology, cpuset, HWLOC_CPUBIND_THREAD)) {
+            hwloc_bitmap_free(cpuset);
+            hwloc_bitmap_free(prior);
+            return PRTE_ERR_NOT_SUPPORTED;
+        }
+        hwloc_bitmap_free(cpuset);
+    }
+
+    posix_spawn_file_actions_init(&fa);
+    posix_spawnattr_init(&attr);
+
+    /* setup stdin/stdout/stderr as prte_iof_base_setup_child would.
+     * Everything else, including the other ends of the pipes, is
+     * closed below */
+    if (PRTE_FLAG_TEST(cd->jdata, PRTE_JOB_FLAG_FORWARD_OUTPUT)) {
+        if (cd->opts.connect_stdin) {
+            if (cd->opts.p_stdin[0] != STDIN_FILENO) {
+                posix_spawn_file_actions_adddup2(&fa, cd->opts.p_stdin[0], STDIN_FILENO);
+            }
+        } else {
+            posix_spawn_file_actions_addopen(&fa, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        }
+        if (cd->opts.p_stdout[1] != STDOUT_FILENO) {
+            posix_spawn_file_actions_adddup2(&fa, cd->opts.p_stdout[1], STDOUT_FILENO);
+        }
+        if (cd->opts.p_stderr[1] != STDERR_FILENO) {
+            posix_spawn_file_actions_adddup2(&fa, cd->opts.p_stderr[1], STDERR_FILENO);
+        }
+    }
+    posix_spawn_file_actions_addclosefrom_np(&fa, STDERR_FILENO + 1);
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+    if (NULL != cd->wdir) {
+        posix_spawn_file_actions_addchdir_np(&fa, cd->wdir);
+    }
+#endif
+
+    /* reset the signals the event library may have set, and
+     * unblock everything - see do_child for why */
+    flags = POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK;
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGTERM);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGHUP);
+    sigaddset(&sigs, SIGPIPE);
+    sigaddset(&sigs, SIGCHLD);
+    sigaddset(&sigs, SIGTRAP);
+    posix_spawnattr_setsigdefault(&attr, &sigs);
+    sigemptyset(&sigs);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+#if HAVE_SETPGID
+    /* put the child in its own process group, so that any
+     * signals we send to it will reach any children it spawns */
+    flags |= POSIX_SPAWN_SETPGROUP;
+    posix_spawnattr_setpgroup(&attr, 0);
+#endif
+    posix_spawnattr_setflags(&attr, flags);
+
+    if (NULL == cd->argv) {
+        PMIX_ARGV_APPEND_NOSIZE_COMPAT(&cd->argv, cd->app->app);
+    }
+
+    rc = posix_spawn(&pid, cd->cmd, &fa, &attr, cd->argv, cd->env);
+
+    posix_spawn_file_actions_destroy(&fa);
+    posix_spawnattr_destroy(&attr);
+    if (NULL != prior) {
+        hwloc_set_cpubind(prte_hwloc_topology, prior, HWLOC_CPUBIND_THREAD);
+        hwloc_bitmap_free(prior);
+    }
+
+    /* close our copies of the child's ends of the pipes */
+    if (cd->opts.connect_stdin) {
+        close(cd->opts.p_stdin[0]);
+    }
+    close(cd->opts.p_stdout[1]);
+    close(cd->opts.p_stderr[1]);
+
+    if (0 != rc) {
+        if (EAGAIN == rc || ENOMEM == rc) {
+            PRTE_ERROR_LOG(PMIX_ERR_SYS_LIMITS_CHILDREN);
+            child->state = PRTE_PROC_STATE_FAILED_TO_START;
+            child->exit_code = PMIX_ERR_SYS_LIMITS_CHILDREN;
+            return PMIX_ERR_SYS_LIMITS_CHILDREN;
+        }
+        if (NULL != cd->wdir) {
+            pmix_string_copy(dir, cd->wdir, sizeof(dir));
+        } else {
+            (void) getcwd(dir, sizeof(dir));
+        }
+        /* see do_child for the meaning of ENOENT here */
+        if (ENOENT == rc && 0 == stat(cd->app->app, &stats)) {
+            pmix_asprintf(&msg, "%s has a bad interpreter on the first line.", cd->app->app);
+        } else {
+            msg = strdup(strerror(rc));
+        }
+        pmix_show_help("help-prte-odls-default.txt", "execve error", true,
+                       prte_process_info.nodename, dir, cd->app->app, msg);
+        free(msg);
+        child->state = PRTE_PROC_STATE_FAILED_TO_START;
+        PRTE_FLAG_UNSET(child, PRTE_PROC_FLAG_ALIVE);
+        return PRTE_ERR_FAILED_TO_START;
+    }
+
+    child->pid = pid;
+    child->state = PRTE_PROC_STATE_RUNNING;
+    PRTE_FLAG_SET(child, PRTE_PROC_FLAG_ALIVE);
+    return PRTE_SUCCESS;
+}
+#endif
+
 /**
  *  Fork/exec the specified processes
  */
@@ -597,6 +784,16 @@ static int odls_default_fork_local_proc(void *cdptr)
     pid_t pid;
     prte_proc_t *child = cd->child;
 
+#if PRTE_ODLS_DEFAULT_HAVE_SPAWN
+    int rc;
+
+    /* take the fast path if we can */
+    rc = spawn_local_proc(cd);
+    if (PRTE_ERR_NOT_SUPPORTED != rc) {
+        return rc;
+    }
+#endif
+
     /* A pipe is used to communicate between the parent and child to
        indicate whether the exec ultimately succeeded or failed.  The
        child sets the pipe to be close-on-exec; the child only ever
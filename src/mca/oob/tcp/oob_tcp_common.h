@@ -34,4 +34,11 @@
 PRTE_MODULE_EXPORT void prte_oob_tcp_set_socket_options(int sd);
 PRTE_MODULE_EXPORT char *prte_oob_tcp_state_print(prte_oob_tcp_state_t state);
 PRTE_MODULE_EXPORT prte_oob_tcp_peer_t *prte_oob_tcp_peer_lookup(const pmix_proc_t *name);
+
+/* compact header support */
+PRTE_MODULE_EXPORT void prte_oob_tcp_hdr_reset(prte_oob_tcp_peer_t *peer);
+PRTE_MODULE_EXPORT size_t prte_oob_tcp_hdr_pack(prte_oob_tcp_peer_t *peer,
+                                                const prte_oob_tcp_hdr_t *hdr, uint8_t *buf);
+PRTE_MODULE_EXPORT int prte_oob_tcp_hdr_unpack(prte_oob_tcp_peer_t *peer, const uint8_t *buf,
+                                               size_t len, prte_oob_tcp_hdr_t *hdr);
 #endif /* _MCA_OOB_TCP_COMMON_H_ */
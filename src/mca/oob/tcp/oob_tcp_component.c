@@ -383,6 +383,20 @@ static int tcp_component_register(void)
                                                 PMIX_MCA_BASE_VAR_TYPE_INT,
                                                 &prte_mca_oob_tcp_component.max_recon_attempts);
 
+    prte_mca_oob_tcp_component.compact_hdr = true;
+    (void) pmix_mca_base_component_var_register(component, "compact_hdr",
+                                                "Use a compact message header with per-connection nspace interning "
+                                                "when the peer also supports it",
+                                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                                &prte_mca_oob_tcp_component.compact_hdr);
+
+    prte_mca_oob_tcp_component.max_nspace_ids = 1024;
+    (void) pmix_mca_base_component_var_register(component, "max_nspace_ids",
+                                                "Max number of nspaces to intern on each connection when using the compact "
+                                                "header - nspaces beyond this are sent in full",
+                                                PMIX_MCA_BASE_VAR_TYPE_INT,
+                                                &prte_mca_oob_tcp_component.max_nspace_ids);
+
     return PRTE_SUCCESS;
 }
 
@@ -1040,6 +1054,14 @@ static void peer_cons(prte_oob_tcp_peer_t *peer)
     peer->send_ev_active = false;
     peer->recv_ev_active = false;
     peer->timer_ev_active = false;
+    peer->compact_hdr = false;
+    PMIX_CONSTRUCT(&peer->send_nspaces, pmix_hash_table_t);
+    pmix_hash_table_init(&peer->send_nspaces, 32);
+    peer->next_nspace_id = 1;
+    peer->hdr_epoch = 1;
+    PMIX_CONSTRUCT(&peer->recv_nspaces, pmix_pointer_array_t);
+    pmix_pointer_array_init(&peer->recv_nspaces, 8, INT32_MAX, 8);
+    peer->next_recv_id = 1;
 }
 static void peer_des(prte_oob_tcp_peer_t *peer)
 {
@@ -1062,6 +1084,9 @@ static void peer_des(prte_oob_tcp_peer_t *peer)
     }
     PMIX_LIST_DESTRUCT(&peer->addrs);
     PMIX_LIST_DESTRUCT(&peer->send_queue);
+    prte_oob_tcp_hdr_reset(peer);
+    PMIX_DESTRUCT(&peer->send_nspaces);
+    PMIX_DESTRUCT(&peer->recv_nspaces);
 }
 PMIX_CLASS_INSTANCE(prte_oob_tcp_peer_t, pmix_list_item_t, peer_cons, peer_des);
 
@@ -90,6 +90,8 @@ typedef struct {
     int retry_delay;        /**< time to wait before retrying connection */
     int max_recon_attempts; /**< maximum number of times to attempt connect before giving up (-1 for
                                never) */
+    bool compact_hdr;       /**< offer the compact message header to peers */
+    int max_nspace_ids;     /**< max number of nspaces to intern per connection */
 } prte_mca_oob_tcp_component_t;
 
 PRTE_MODULE_EXPORT extern prte_mca_oob_tcp_component_t prte_mca_oob_tcp_component;
@@ -500,8 +500,13 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     char *msg;
     prte_oob_tcp_hdr_t hdr;
     uint16_t ack_flag = htons(1);
+    uint8_t caps = 0;
     size_t sdsize, offset = 0;
 
+    if (prte_mca_oob_tcp_component.compact_hdr) {
+        caps |= PRTE_OOB_TCP_CAP_COMPACT_HDR;
+    }
+
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
                         "%s SEND CONNECT ACK", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
@@ -513,8 +518,8 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     hdr.seq_num = 0;
     memset(hdr.routed, 0, PRTE_MAX_RTD_SIZE + 1);
 
-    /* payload size */
-    sdsize = sizeof(ack_flag) + strlen(prte_version_string) + 1;
+    /* payload size - include our capabilities */
+    sdsize = sizeof(ack_flag) + strlen(prte_version_string) + 1 + sizeof(caps);
     hdr.nbytes = sdsize;
     MCA_OOB_TCP_HDR_HTON(&hdr);
 
@@ -532,6 +537,8 @@ static int tcp_peer_send_connect_ack(prte_oob_tcp_peer_t *peer)
     offset += sizeof(ack_flag);
     memcpy(msg + offset, prte_version_string, strlen(prte_version_string) + 1);
     offset += strlen(prte_version_string) + 1;
+    memcpy(msg + offset, &caps, sizeof(caps));
+    offset += sizeof(caps);
 
     /* send it */
     if (PRTE_SUCCESS != tcp_peer_send_blocking(peer->sd, msg, sdsize)) {
@@ -798,6 +805,7 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
     prte_oob_tcp_hdr_t hdr;
     prte_oob_tcp_peer_t *peer;
     uint16_t ack_flag;
+    uint8_t caps = 0;
     bool is_new = (NULL == pr);
 
     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
@@ -974,6 +982,10 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
         --cnt;
     }
     offset += cnt + 1;
+    /* older peers do not provide capabilities */
+    if (offset < hdr.nbytes) {
+        caps = (uint8_t) msg[offset];
+    }
     if (0 != strcmp(version, prte_version_string)) {
         pmix_show_help("help-oob-tcp.txt", "version mismatch", true, prte_process_info.nodename,
                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), prte_version_string,
@@ -990,6 +1002,17 @@ int prte_oob_tcp_peer_recv_connect_ack(prte_oob_tcp_peer_t *pr, int sd, prte_oob
                         "%s connect-ack version from %s matches ours",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name));
 
+    /* this is a new connection, so any nspaces interned on a
+     * prior connection are gone - and use the compact header
+     * only if we both support it */
+    prte_oob_tcp_hdr_reset(peer);
+    peer->compact_hdr = prte_mca_oob_tcp_component.compact_hdr
+                        && (caps & PRTE_OOB_TCP_CAP_COMPACT_HDR);
+    pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                        "%s connection to %s will use the %s header",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&peer->name),
+                        peer->compact_hdr ? "compact" : "legacy");
+
     /* if the requestor wanted the header returned, then they
      * will complete their processing
      */
@@ -1056,6 +1079,7 @@ void prte_oob_tcp_peer_close(prte_oob_tcp_peer_t *peer)
     /* release the socket */
     close(peer->sd);
     peer->sd = -1;
+    peer->compact_hdr = false;
 
     /* if we were CONNECTING, then we need to mark the address as
      * failed and cycle back to try the next address */
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Encode/decode of the compact message header. See oob_tcp_hdr.h
+ * for a description of the wire format.
+ */
+
+#include "prte_config.h"
+#include "types.h"
+
+#include <string.h>
+#ifdef HAVE_ARPA_INET_H
+#    include <arpa/inet.h>
+#endif
+
+#include "src/util/error.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/oob/tcp/oob_tcp.h"
+#include "src/mca/oob/tcp/oob_tcp_common.h"
+#include "src/mca/oob/tcp/oob_tcp_component.h"
+#include "src/mca/oob/tcp/oob_tcp_peer.h"
+
+static size_t pack_varint(uint8_t *buf, uint32_t val)
+{
+    size_t n = 0;
+
+    while (0x80 <= val) {
+        buf[n++] = (uint8_t) (val | 0x80);
+        val >>= 7;
+    }
+    buf[n++] = (uint8_t) val;
+    return n;
+}
+
+static bool unpack_varint(const uint8_t *buf, size_t len, size_t *offset, uint32_t *val)
+{
+    uint32_t v = 0;
+    unsigned int shift = 0;
+    size_t n;
+
+    for (n = 0; n < PRTE_OOB_TCP_VARINT_MAX && *offset < len; n++) {
+        v |= (uint32_t) (buf[*offset] & 0x7f) << shift;
+        if (0 == (buf[(*offset)++] & 0x80)) {
+            *val = v;
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+/* encode an nspace - returns true if the literal nspace was
+ * included, false if only the id was sent */
+static bool pack_nspace(prte_oob_tcp_peer_t *peer, const pmix_nspace_t nspace,
+                        uint8_t *buf, size_t *offset)
+{
+    void *ptr;
+    uint32_t id = 0;
+    size_t len;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&peer->send_nspaces, nspace,
+                                                      strlen(nspace), &ptr)) {
+        id = (uint32_t) (uintptr_t) ptr;
+        *offset += pack_varint(buf + *offset, id);
+        return false;
+    }
+
+    /* first time we have sent this nspace on this connection - assign
+     * it an id if we still have room */
+    if (prte_mca_oob_tcp_component.max_nspace_ids < 0
+        || peer->next_nspace_id <= (uint32_t) prte_mca_oob_tcp_component.max_nspace_ids) {
+        id = peer->next_nspace_id++;
+        pmix_hash_table_set_value_ptr(&peer->send_nspaces, nspace, strlen(nspace),
+                                      (void *) (uintptr_t) id);
+    }
+    *offset += pack_varint(buf + *offset, id);
+    len = strnlen(nspace, PMIX_MAX_NSLEN);
+    *offset += pack_varint(buf + *offset, (uint32_t) len);
+    memcpy(buf + *offset, nspace, len);
+    *offset += len;
+    return true;
+}
+
+static bool unpack_nspace(prte_oob_tcp_peer_t *peer, bool literal, const uint8_t *buf,
+                          size_t len, size_t *offset, pmix_nspace_t nspace)
+{
+    uint32_t id, nslen;
+    char *ns;
+
+    if (!unpack_varint(buf, len, offset, &id)) {
+        return false;
+    }
+    if (!literal) {
+        /* only accept ids the peer has already given us on this connection */
+        if (0 == id || peer->next_recv_id <= id) {
+            return false;
+        }
+        ns = (char *) pmix_pointer_array_get_item(&peer->recv_nspaces, id);
+        if (NULL == ns) {
+            return false;
+        }
+        PMIX_LOAD_NSPACE(nspace, ns);
+        return true;
+    }
+
+    if (!unpack_varint(buf, len, offset, &nslen) || PMIX_MAX_NSLEN < nslen
+        || len - *offset < nslen) {
+        return false;
+    }
+    memset(nspace, 0, PMIX_MAX_NSLEN + 1);
+    memcpy(nspace, buf + *offset, nslen);
+    *offset += nslen;
+    if (0 != id) {
+        /* the peer wants us to remember this one - it assigns ids
+         * in order, so anything else is a protocol error */
+        if (id != peer->next_recv_id) {
+            return false;
+        }
+        pmix_pointer_array_set_item(&peer->recv_nspaces, id, strdup(nspace));
+        ++peer->next_recv_id;
+    }
+    return true;
+}
+
+/* clear the interning tables - must be done whenever
+ * a connection is (re)established as the peer will
+ * have started over */
+void prte_oob_tcp_hdr_reset(prte_oob_tcp_peer_t *peer)
+{
+    char *ns;
+    int n;
+
+    pmix_hash_table_remove_all(&peer->send_nspaces);
+    peer->next_nspace_id = 1;
+    peer->next_recv_id = 1;
+    ++peer->hdr_epoch;
+    for (n = 0; n < peer->recv_nspaces.size; n++) {
+        if (NULL != (ns = (char *) pmix_pointer_array_get_item(&peer->recv_nspaces, n))) {
+            free(ns);
+            pmix_pointer_array_set_item(&peer->recv_nspaces, n, NULL);
+        }
+    }
+}
+
+/* pack the provided (network byte order) header into the
+ * given buffer, which must be at least PRTE_OOB_TCP_CHDR_MAX
+ * bytes in size. Returns the number of bytes to be sent,
+ * including the leading length */
+size_t prte_oob_tcp_hdr_pack(prte_oob_tcp_peer_t *peer, const prte_oob_tcp_hdr_t *hdr,
+                             uint8_t *buf)
+{
+    size_t offset = 2, flagpos, len;
+    uint8_t flags = 0;
+    uint16_t hlen;
+
+    buf[offset++] = hdr->type;
+    flagpos = offset++;
+
+    if (pack_nspace(peer, hdr->origin.nspace, buf, &offset)) {
+        flags |= PRTE_OOB_TCP_CHDR_ORIGIN_NS;
+    }
+    offset += pack_varint(buf + offset, ntohl(hdr->origin.rank));
+    if (pack_nspace(peer, hdr->dst.nspace, buf, &offset)) {
+        flags |= PRTE_OOB_TCP_CHDR_DST_NS;
+    }
+    offset += pack_varint(buf + offset, ntohl(hdr->dst.rank));
+    offset += pack_varint(buf + offset, PRTE_RML_TAG_NTOH(hdr->tag));
+    /* the seq_num is not converted by MCA_OOB_TCP_HDR_HTON */
+    offset += pack_varint(buf + offset, hdr->seq_num);
+    offset += pack_varint(buf + offset, ntohl(hdr->nbytes));
+
+    len = strnlen(hdr->routed, PRTE_MAX_RTD_SIZE);
+    if (0 < len) {
+        flags |= PRTE_OOB_TCP_CHDR_ROUTED;
+        buf[offset++] = (uint8_t) len;
+        memcpy(buf + offset, hdr->routed, len);
+        offset += len;
+    }
+    buf[flagpos] = flags;
+
+    hlen = htons((uint16_t) (offset - 2));
+    memcpy(buf, &hlen, sizeof(hlen));
+    return offset;
+}
+
+/* unpack a compact header (excluding its leading length) into
+ * the provided header in host byte order */
+int prte_oob_tcp_hdr_unpack(prte_oob_tcp_peer_t *peer, const uint8_t *buf, size_t len,
+                            prte_oob_tcp_hdr_t *hdr)
+{
+    size_t offset = 0, rlen;
+    uint8_t flags;
+
+    memset(hdr, 0, sizeof(prte_oob_tcp_hdr_t));
+    if (len < 2) {
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    hdr->type = buf[offset++];
+    flags = buf[offset++];
+
+    if (!unpack_nspace(peer, flags & PRTE_OOB_TCP_CHDR_ORIGIN_NS, buf, len, &offset,
+                       hdr->origin.nspace)
+        || !unpack_varint(buf, len, &offset, &hdr->origin.rank)
+        || !unpack_nspace(peer, flags & PRTE_OOB_TCP_CHDR_DST_NS, buf, len, &offset,
+                          hdr->dst.nspace)
+        || !unpack_varint(buf, len, &offset, &hdr->dst.rank)
+        || !unpack_varint(buf, len, &offset, &hdr->tag)
+        || !unpack_varint(buf, len, &offset, &hdr->seq_num)
+        || !unpack_varint(buf, len, &offset, &hdr->nbytes)) {
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+
+    if (flags & PRTE_OOB_TCP_CHDR_ROUTED) {
+        if (offset >= len) {
+            return PRTE_ERR_UNPACK_FAILURE;
+        }
+        rlen = buf[offset++];
+        if (PRTE_MAX_RTD_SIZE < rlen || len - offset < rlen) {
+            return PRTE_ERR_UNPACK_FAILURE;
+        }
+        memcpy(hdr->routed, buf + offset, rlen);
+    }
+    return PRTE_SUCCESS;
+}
@@ -86,4 +86,41 @@ typedef struct {
     (h)->tag = PRTE_RML_TAG_HTON((h)->tag);     \
     (h)->nbytes = htonl((h)->nbytes);
 
+/* capabilities advertised in the connect-ack. These are
+ * carried in a single byte that follows the version string
+ * so that older peers (who stop at the NULL terminator)
+ * simply ignore them */
+#define PRTE_OOB_TCP_CAP_COMPACT_HDR 0x01
+
+/* compact header. When both sides of a connection advertise
+ * PRTE_OOB_TCP_CAP_COMPACT_HDR, each message is preceded by
+ * a 16-bit (network order) length followed by that many
+ * bytes of encoded header:
+ *
+ *    uint8   type
+ *    uint8   flags
+ *    varint  origin nspace id [varint len + nspace if defined here]
+ *    varint  origin rank
+ *    varint  dst nspace id [varint len + nspace if defined here]
+ *    varint  dst rank
+ *    varint  tag
+ *    varint  seq_num
+ *    varint  nbytes
+ *    [uint8 len + routed, if present]
+ *
+ * Namespaces are interned per connection - the first time
+ * a namespace is sent on a connection, it is transmitted in
+ * full along with the id the receiver is to associate with
+ * it. Thereafter, only the id is sent. An id of zero means
+ * the namespace was sent in full and is not to be retained.
+ */
+#define PRTE_OOB_TCP_CHDR_ORIGIN_NS 0x01
+#define PRTE_OOB_TCP_CHDR_DST_NS    0x02
+#define PRTE_OOB_TCP_CHDR_ROUTED    0x04
+
+#define PRTE_OOB_TCP_VARINT_MAX 5
+#define PRTE_OOB_TCP_CHDR_MAX                                                \
+    (4 + 2 * (3 * PRTE_OOB_TCP_VARINT_MAX + PMIX_MAX_NSLEN + 1)              \
+     + 3 * PRTE_OOB_TCP_VARINT_MAX + 1 + PRTE_MAX_RTD_SIZE)
+
 #endif /* _MCA_OOB_TCP_HDR_H_ */
@@ -30,6 +30,8 @@
 
 #include "prte_config.h"
 
+#include "src/class/pmix_hash_table.h"
+#include "src/class/pmix_pointer_array.h"
 #include "src/event/event-internal.h"
 
 #include "oob_tcp.h"
@@ -64,9 +66,15 @@ typedef struct {
     bool recv_ev_active;
     prte_event_t timer_event; /**< timer for retrying connection failures */
     bool timer_ev_active;
-    pmix_list_t send_queue;        /**< list of messages to send */
-    prte_oob_tcp_send_t *send_msg; /**< current send in progress */
-    prte_oob_tcp_recv_t *recv_msg; /**< current recv in progress */
+    pmix_list_t send_queue;             /**< list of messages to send */
+    prte_oob_tcp_send_t *send_msg;      /**< current send in progress */
+    prte_oob_tcp_recv_t *recv_msg;      /**< current recv in progress */
+    bool compact_hdr;                   /**< both sides agreed to use the compact header */
+    pmix_hash_table_t send_nspaces;     /**< nspaces we have interned on this connection */
+    uint32_t next_nspace_id;            /**< next id to assign to an nspace we send */
+    uint32_t hdr_epoch;                 /**< incremented each time the interning tables are reset */
+    pmix_pointer_array_t recv_nspaces;  /**< nspaces interned by the peer, indexed by id */
+    uint32_t next_recv_id;              /**< next id the peer will assign to an nspace it sends */
 } prte_oob_tcp_peer_t;
 PMIX_CLASS_DECLARATION(prte_oob_tcp_peer_t);
 
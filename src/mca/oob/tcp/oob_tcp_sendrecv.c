@@ -111,11 +111,45 @@ void prte_oob_tcp_queue_msg(int sd, short args, void *cbdata)
     }
 }
 
+/* select the header encoding for this message based on the
+ * connection it is about to go out on. This can only be done
+ * before any part of the header has been written, and must be
+ * done only once per connection as packing the compact header
+ * interns the nspaces */
+static void prep_hdr(prte_oob_tcp_peer_t *peer, prte_oob_tcp_send_t *msg)
+{
+    if (msg->hdr_sent || msg->hdr_epoch == peer->hdr_epoch) {
+        return;
+    }
+    if (msg->hdr_packed) {
+        if (msg->sdptr != (char *) msg->chdr || msg->sdbytes != msg->chdr_size) {
+            return;
+        }
+    } else if (msg->sdptr != (char *) &msg->hdr || msg->sdbytes != sizeof(prte_oob_tcp_hdr_t)) {
+        return;
+    }
+
+    msg->hdr_epoch = peer->hdr_epoch;
+    if (peer->compact_hdr) {
+        msg->chdr_size = prte_oob_tcp_hdr_pack(peer, &msg->hdr, msg->chdr);
+        msg->sdptr = (char *) msg->chdr;
+        msg->sdbytes = msg->chdr_size;
+        msg->hdr_packed = true;
+    } else {
+        msg->sdptr = (char *) &msg->hdr;
+        msg->sdbytes = sizeof(prte_oob_tcp_hdr_t);
+        msg->hdr_packed = false;
+    }
+}
+
 static int send_msg(prte_oob_tcp_peer_t *peer, prte_oob_tcp_send_t *msg)
 {
     struct iovec iov[2];
     int iov_count, retries = 0;
-    ssize_t remain = msg->sdbytes, rc;
+    ssize_t remain, rc;
+
+    prep_hdr(peer, msg);
+    remain = msg->sdbytes;
 
     iov[0].iov_base = msg->sdptr;
     iov[0].iov_len = msg->sdbytes;
@@ -448,9 +482,41 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
                 return;
             }
-            /* start by reading the header */
-            peer->recv_msg->rdptr = (char *) &peer->recv_msg->hdr;
-            peer->recv_msg->rdbytes = sizeof(prte_oob_tcp_hdr_t);
+            /* start by reading the header - if we are using the
+             * compact form, then that begins with its length */
+            if (peer->compact_hdr) {
+                peer->recv_msg->rdptr = (char *) &peer->recv_msg->chdr_len;
+                peer->recv_msg->rdbytes = sizeof(uint16_t);
+            } else {
+                peer->recv_msg->rdptr = (char *) &peer->recv_msg->hdr;
+                peer->recv_msg->rdbytes = sizeof(prte_oob_tcp_hdr_t);
+            }
+        }
+        /* if we are reading a compact header, get its length first */
+        if (peer->compact_hdr && !peer->recv_msg->chdr_len_recvd) {
+            if (PRTE_SUCCESS == (rc = read_bytes(peer))) {
+                peer->recv_msg->chdr_len_recvd = true;
+                peer->recv_msg->chdr_len = ntohs(peer->recv_msg->chdr_len);
+                if (PRTE_OOB_TCP_CHDR_MAX < peer->recv_msg->chdr_len) {
+                    pmix_output(0, "%s-%s prte_oob_tcp_peer_recv_handler: invalid header length %d",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)),
+                                (int) peer->recv_msg->chdr_len);
+                    prte_oob_tcp_peer_close(peer);
+                    return;
+                }
+                peer->recv_msg->rdptr = (char *) peer->recv_msg->chdr;
+                peer->recv_msg->rdbytes = peer->recv_msg->chdr_len;
+            } else if (PRTE_ERR_RESOURCE_BUSY == rc || PRTE_ERR_WOULD_BLOCK == rc) {
+                /* exit this event and let the event lib progress */
+                return;
+            } else {
+                /* close the connection */
+                pmix_output_verbose(OOB_TCP_DEBUG_CONNECT, prte_oob_base_framework.framework_output,
+                                    "%s:tcp:recv:handler error reading bytes - closing connection",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
+                prte_oob_tcp_peer_close(peer);
+                return;
+            }
         }
         /* if the header hasn't been completely read, read it */
         if (!peer->recv_msg->hdr_recvd) {
@@ -460,7 +526,18 @@ void prte_oob_tcp_recv_handler(int sd, short flags, void *cbdata)
                 /* completed reading the header */
                 peer->recv_msg->hdr_recvd = true;
                 /* convert the header */
-                MCA_OOB_TCP_HDR_NTOH(&peer->recv_msg->hdr);
+                if (peer->compact_hdr) {
+                    rc = prte_oob_tcp_hdr_unpack(peer, peer->recv_msg->chdr,
+                                                 peer->recv_msg->chdr_len, &peer->recv_msg->hdr);
+                    if (PRTE_SUCCESS != rc) {
+                        pmix_output(0, "%s-%s prte_oob_tcp_peer_recv_handler: unable to decode header",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&(peer->name)));
+                        prte_oob_tcp_peer_close(peer);
+                        return;
+                    }
+                } else {
+                    MCA_OOB_TCP_HDR_NTOH(&peer->recv_msg->hdr);
+                }
                 /* if this is a zero-byte message, then we are done */
                 if (0 == peer->recv_msg->hdr.nbytes) {
                     pmix_output_verbose(OOB_TCP_DEBUG_CONNECT,
@@ -580,6 +657,9 @@ static void snd_cons(prte_oob_tcp_send_t *ptr)
     ptr->msg = NULL;
     ptr->data = NULL;
     ptr->hdr_sent = false;
+    ptr->hdr_packed = false;
+    ptr->hdr_epoch = 0;
+    ptr->chdr_size = 0;
     ptr->iovnum = 0;
     ptr->sdptr = NULL;
     ptr->sdbytes = 0;
@@ -602,6 +682,8 @@ static void rcv_cons(prte_oob_tcp_recv_t *ptr)
 {
     memset(&ptr->hdr, 0, sizeof(prte_oob_tcp_hdr_t));
     ptr->hdr_recvd = false;
+    ptr->chdr_len_recvd = false;
+    ptr->chdr_len = 0;
     ptr->rdptr = NULL;
     ptr->rdbytes = 0;
 }
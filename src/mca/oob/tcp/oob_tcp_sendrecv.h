@@ -49,6 +49,10 @@ typedef struct {
     prte_rml_send_t *msg;
     char *data;
     bool hdr_sent;
+    bool hdr_packed;     // hdr has been encoded into chdr
+    uint32_t hdr_epoch;  // connection epoch the hdr was prepared for
+    size_t chdr_size;
+    uint8_t chdr[PRTE_OOB_TCP_CHDR_MAX];
     int iovnum;
     char *sdptr;
     size_t sdbytes;
@@ -60,6 +64,9 @@ typedef struct {
     pmix_list_item_t super;
     prte_oob_tcp_hdr_t hdr;
     bool hdr_recvd;
+    bool chdr_len_recvd; // length of the compact hdr has been read
+    uint16_t chdr_len;
+    uint8_t chdr[PRTE_OOB_TCP_CHDR_MAX];
     char *data;
     char *rdptr;
     size_t rdbytes;
@@ -1110,7 +1110,7 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t *sender,
     int rc, idx;
     char *sig;
     prte_proc_t *daemon = NULL, *dptr, *dnxt;
-    prte_topology_t *t, *t2;
+    prte_topology_t *t;
     int i;
     prte_job_t *jdata;
     uint8_t flag;
@@ -1182,18 +1182,7 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t *sender,
     }
 
     /* find it in the array */
-    t = NULL;
-    for (i = 0; i < prte_node_topologies->size; i++) {
-        t2 = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, i);
-        if (NULL == t2) {
-            continue;
-        }
-        /* just check the signature */
-        if (0 == strcmp(sig, t2->sig)) {
-            t = t2;
-            break;
-        }
-    }
+    t = prte_topology_lookup(sig);
     free(sig);
     if (NULL == t) {
         /* should never happen */
@@ -1218,6 +1207,7 @@ void prte_plm_base_daemon_topology(int status, pmix_proc_t *sender,
     PMIX_DATA_BUFFER_DESTRUCT(data);
     /* record the final topology */
     t->topo = topo;
+    prte_hwloc_base_topo_cache_store(t->sig, topo);
     /* update the node's available processors */
     if (NULL != daemon->node->available) {
         hwloc_bitmap_free(daemon->node->available);
@@ -1428,6 +1418,8 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
             PMIX_ARGV_APPEND_UNIQUE_COMPAT(&daemon->node->aliases, alias);
             free(alias);
         }
+        /* the node may now be known by other names */
+        prte_node_index(daemon->node);
 
         if (0 < pmix_output_get_verbosity(prte_plm_base_framework.framework_output)) {
             pmix_output(0, "ALIASES FOR NODE %s (%s)", daemon->node->name, nodename);
@@ -1534,6 +1526,7 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
                 PMIX_TOPOLOGY_DESTRUCT(&ptopo);
                 /* cleanup */
                 PMIX_DATA_BUFFER_DESTRUCT(data);
+                prte_hwloc_base_topo_cache_store(sig, topo);
             }
         }
 
@@ -1598,37 +1591,31 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
 
         /* do we already have this topology from some other node? */
         found = false;
-        for (i = 0; i < prte_node_topologies->size; i++) {
-            t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, i);
-            if (NULL == t) {
-                continue;
+        t = prte_topology_lookup(sig);
+        if (NULL != t) {
+            PMIX_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
+                                 "%s TOPOLOGY SIGNATURE ALREADY RECORDED IN POSN %d",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), t->index));
+            daemon->node->topology = t;
+            found = true;
+            /* the topology in this struct can be NULL in the case
+             * where an earlier daemon other than daemon1 reported the
+             * signature but did not include its topology */
+            if (NULL == t->topo && 1 == dname.rank) {
+                /* we will have received its topology */
+                t->topo = topo;
             }
-            /* just check the signature */
-            if (0 == strcmp(sig, t->sig)) {
-                PMIX_OUTPUT_VERBOSE((5, prte_plm_base_framework.framework_output,
-                                     "%s TOPOLOGY SIGNATURE ALREADY RECORDED IN POSN %d",
-                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), i));
-                daemon->node->topology = t;
-                found = true;
-                /* the topology in this struct can be NULL in the case
-                 * where an earlier daemon other than daemon1 reported the
-                 * signature but did not include its topology */
-                if (NULL == t->topo) {
-                    if (1 == dname.rank) {
-                        /* we will have received its topology */
-                        t->topo = topo;
-                    } else {
-                        break;
-                    }
-                }
+            if (NULL != t->topo) {
                 /* update the node's available processors */
                 if (NULL != daemon->node->available) {
                     hwloc_bitmap_free(daemon->node->available);
                 }
                 daemon->node->available = prte_hwloc_base_filter_cpus(t->topo);
                 free(sig);
-                break;
             }
+        } else if (NULL == topo) {
+            /* we may have seen it in a prior DVM */
+            topo = prte_hwloc_base_topo_cache_load(sig);
         }
 
         if (1 == dname.rank) {
@@ -1643,6 +1630,12 @@ void prte_plm_base_daemon_callback(int status, pmix_proc_t *sender, pmix_data_bu
                     dptr->node->topology = t;
                     dptr->node->available = prte_hwloc_base_filter_cpus(topo);
                     jdatorted->num_reported++;
+                } else if (NULL != dptr->node->topology->topo ||
+                           NULL != (dptr->node->topology->topo =
+                                    prte_hwloc_base_topo_cache_load(dptr->node->topology->sig))) {
+                    /* we already had it from a prior DVM */
+                    dptr->node->available = prte_hwloc_base_filter_cpus(dptr->node->topology->topo);
+                    jdatorted->num_reported++;
                 } else {
                     /* see if this topology has already been requested */
                     compressed = false;
@@ -49,6 +49,7 @@
 #include "src/mca/ras/base/base.h"
 #include "src/rml/rml.h"
 #include "src/mca/schizo/base/base.h"
+#include "src/mca/state/base/base.h"
 #include "src/mca/state/state.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
@@ -133,6 +134,8 @@ void prte_plm_base_recv(int status, pmix_proc_t *sender,
     char **env;
     char *prefix_dir, *tmp;
     pmix_rank_t tgt, *tptr;
+    pmix_rank_t *ranks = NULL;
+    size_t nranks = 0;
     pmix_value_t pidval = PMIX_VALUE_STATIC_INIT;
     PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
 
@@ -425,11 +428,32 @@ void prte_plm_base_recv(int status, pmix_proc_t *sender,
                      * state against the prior proc state */
                     proc->pid = pid;
                     proc->exit_code = exit_code;
-                    PRTE_ACTIVATE_PROC_STATE(&name, state);
+                    if (PRTE_PROC_STATE_TERMINATED != state) {
+                        PRTE_ACTIVATE_PROC_STATE(&name, state);
+                    } else {
+                        /* normal terminations are tracked together */
+                        if (NULL == ranks) {
+                            ranks = (pmix_rank_t *) malloc(jdata->num_procs * sizeof(pmix_rank_t));
+                        }
+                        if (NULL != ranks && nranks < jdata->num_procs) {
+                            ranks[nranks++] = vpid;
+                        } else {
+                            PRTE_ACTIVATE_PROC_STATE(&name, state);
+                        }
+                    }
                 }
                 /* get entry from next rank */
+                count = 1;
                 rc = PMIx_Data_unpack(NULL, buffer, &vpid, &count, PMIX_PROC_RANK);
             }
+            if (0 < nranks) {
+                prte_state_base_activate_proc_states(job, ranks, nranks,
+                                                     PRTE_PROC_STATE_TERMINATED);
+            } else if (NULL != ranks) {
+                free(ranks);
+            }
+            ranks = NULL;
+            nranks = 0;
             /* prepare for next job */
             count = 1;
             rc = PMIx_Data_unpack(NULL, buffer, &job, &count, PMIX_PROC_NSPACE);
@@ -650,6 +674,9 @@ void prte_plm_base_recv(int status, pmix_proc_t *sender,
     }
 
 CLEANUP:
+    if (NULL != ranks) {
+        free(ranks);
+    }
     /* see if an error occurred - if so, wakeup the HNP so we can exit */
     if (PRTE_PROC_IS_MASTER && PRTE_SUCCESS != rc) {
         jdata = NULL;
@@ -988,6 +988,7 @@ static void process_launch_list(int fd, short args, void *cbdata)
             caddy->daemon->state = PRTE_PROC_STATE_RUNNING;
             /* record the pid of the ssh fork */
             caddy->daemon->pid = pid;
+            prte_wait_track(caddy->daemon);
 
             PMIX_OUTPUT_VERBOSE((1, prte_plm_base_framework.framework_output,
                                  "%s plm:ssh: recording launch of daemon %s",
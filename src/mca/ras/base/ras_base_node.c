@@ -102,6 +102,7 @@ int prte_ras_base_node_insert(pmix_list_t *nodes, prte_job_t *jdata)
                     free(hnp_node->name);
                 }
                 hnp_node->name = strdup("prte");
+                prte_node_index(hnp_node);
                 skiphnp = true;
                 PRTE_SET_MAPPING_DIRECTIVE(prte_rmaps_base.mapping, PRTE_MAPPING_NO_USE_LOCAL);
                 PRTE_FLAG_SET(hnp_node, PRTE_NODE_NON_USABLE); // leave this node out of mapping operations
@@ -131,7 +132,7 @@ int prte_ras_base_node_insert(pmix_list_t *nodes, prte_job_t *jdata)
             hnp_node->slots = node->slots;
             hnp_node->slots_max = node->slots_max;
             /* copy across any attributes */
-            PMIX_LIST_FOREACH(kv, &node->attributes, prte_attribute_t)
+            PRTE_ATTR_FOREACH(kv, &node->attributes)
             {
                 prte_set_attribute(&node->attributes, kv->key,
                                    PRTE_ATTR_LOCAL,
@@ -147,6 +148,7 @@ int prte_ras_base_node_insert(pmix_list_t *nodes, prte_job_t *jdata)
             }
             /* if the node name is different, store it as an alias */
             PMIX_ARGV_APPEND_UNIQUE_COMPAT(&hnp_node->aliases, node->name);
+            prte_node_index(hnp_node);
             if (NULL != node->rawname) {
                 if (NULL != hnp_node->rawname) {
                     free(hnp_node->rawname);
@@ -163,6 +165,7 @@ int prte_ras_base_node_insert(pmix_list_t *nodes, prte_job_t *jdata)
                 }
                 PRTE_FLAG_UNSET(node, PRTE_NODE_FLAG_DAEMON_LAUNCHED);
                 node->index = pmix_pointer_array_add(prte_node_pool, node);
+                prte_node_index(node);
             }
         } else {
             /* insert the object onto the prte_nodes global array */
@@ -182,6 +185,7 @@ int prte_ras_base_node_insert(pmix_list_t *nodes, prte_job_t *jdata)
                 PRTE_ERROR_LOG(rc);
                 return rc;
             }
+            prte_node_index(node);
             if (prte_get_attribute(&djob->attributes, PRTE_JOB_DO_NOT_LAUNCH, NULL, PMIX_BOOL)) {
                 /* create a daemon for this node since we won't be launching
                  * and the mapper needs to see a daemon - this is used solely
@@ -209,6 +213,7 @@ int prte_ras_base_node_insert(pmix_list_t *nodes, prte_job_t *jdata)
                     return rc;
                 }
                 nptr->index = pmix_pointer_array_add(prte_node_pool, nptr);
+                prte_node_index(nptr);
             }
         }
     }
@@ -79,6 +79,9 @@ typedef struct {
     char *default_mapping_policy;
     /* whether or not to require hwtcpus due to topology limitations */
     bool require_hwtcpus;
+    /* wall time spent computing vpids, accumulated across
+     * calls so tools can separate ranking from mapping */
+    double rank_time;
 } prte_rmaps_base_t;
 
 /**
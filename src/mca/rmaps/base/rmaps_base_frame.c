@@ -63,7 +63,8 @@ prte_rmaps_base_t prte_rmaps_base = {
     .file = NULL,
     .available = NULL,
     .baseset = NULL,
-    .default_mapping_policy = NULL
+    .default_mapping_policy = NULL,
+    .rank_time = 0.0
 };
 
 /*
@@ -30,6 +30,9 @@
 #    include <unistd.h>
 #endif /* HAVE_UNISTD_H */
 #include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
 
 #include "src/class/pmix_pointer_array.h"
 #include "src/hwloc/hwloc-internal.h"
@@ -70,8 +73,8 @@ static void compute_app_rank(prte_job_t *jdata)
     }
 }
 
-int prte_rmaps_base_compute_vpids(prte_job_t *jdata,
-                                  prte_rmaps_options_t *options)
+static int compute_vpids(prte_job_t *jdata,
+                         prte_rmaps_options_t *options)
 {
     int m, n;
     unsigned k, nobjs, pass;
@@ -293,6 +296,20 @@ int prte_rmaps_base_compute_vpids(prte_job_t *jdata,
     return PRTE_ERR_NOT_IMPLEMENTED;
 }
 
+int prte_rmaps_base_compute_vpids(prte_job_t *jdata,
+                                  prte_rmaps_options_t *options)
+{
+    struct timeval start, end;
+    int rc;
+
+    gettimeofday(&start, NULL);
+    rc = compute_vpids(jdata, options);
+    gettimeofday(&end, NULL);
+    prte_rmaps_base.rank_time += (double) (end.tv_sec - start.tv_sec) +
+                                 (double) (end.tv_usec - start.tv_usec) / 1000000.0;
+    return rc;
+}
+
 /* when we restart a process on a different node, we have to
  * ensure that the node and local ranks assigned to the proc
  * don't overlap with any pre-existing proc on that node. If
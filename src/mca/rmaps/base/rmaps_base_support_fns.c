@@ -51,6 +51,43 @@
 #include "src/mca/rmaps/base/base.h"
 #include "src/mca/rmaps/base/rmaps_private.h"
 
+/* can this node from the pool be used for the mapping? A node
+ * marked do-not-use is left marked so it stays excluded for the
+ * rest of this lookup - the caller resets it */
+static bool target_usable(prte_node_t *node, bool novm)
+{
+    /* ignore nodes that are non-usable */
+    if (PRTE_FLAG_TEST(node, PRTE_NODE_NON_USABLE)) {
+        return false;
+    }
+    /* ignore nodes that are marked as do-not-use for this mapping */
+    if (PRTE_NODE_STATE_DO_NOT_USE == node->state) {
+        PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_USE", node->name));
+        return false;
+    }
+    if (PRTE_NODE_STATE_DOWN == node->state) {
+        PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s IS DOWN", node->name));
+        return false;
+    }
+    if (PRTE_NODE_STATE_NOT_INCLUDED == node->state) {
+        PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s IS MARKED NO_INCLUDE", node->name));
+        /* not to be used */
+        return false;
+    }
+    /* if this node wasn't included in the vm (e.g., by -host), ignore it,
+     * unless we are mapping prior to launching the vm
+     */
+    if (NULL == node->daemon && !novm) {
+        PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                             "NODE %s HAS NO DAEMON", node->name));
+        return false;
+    }
+    return true;
+}
+
 int prte_rmaps_base_filter_nodes(prte_app_context_t *app, pmix_list_t *nodes, bool remove)
 {
     int rc = PRTE_ERR_TAKE_NEXT_OPTION;
@@ -190,47 +227,31 @@ int prte_rmaps_base_get_target_nodes(pmix_list_t *allocated_nodes,
          */
         PMIX_LIST_FOREACH_SAFE(nptr, next, &nodes, prte_node_t)
         {
-            for (i = 0; i < prte_node_pool->size; i++) {
-                node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, i);
-                if (NULL == node) {
-                    continue;
-                }
-                /* ignore nodes that are non-usable */
-                if (PRTE_FLAG_TEST(node, PRTE_NODE_NON_USABLE)) {
-                    continue;
-                }
-                /* ignore nodes that are marked as do-not-use for this mapping */
-                if (PRTE_NODE_STATE_DO_NOT_USE == node->state) {
-                    PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_USE", node->name));
-                    /* reset the state so it can be used another time */
-                    node->state = PRTE_NODE_STATE_UP;
-                    continue;
-                }
-                if (PRTE_NODE_STATE_DOWN == node->state) {
-                    PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS DOWN", node->name));
-                    continue;
-                }
-                if (PRTE_NODE_STATE_NOT_INCLUDED == node->state) {
-                    PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s IS MARKED NO_INCLUDE", node->name));
-                    /* not to be used */
-                    continue;
-                }
-                /* if this node wasn't included in the vm (e.g., by -host), ignore it,
-                 * unless we are mapping prior to launching the vm
-                 */
-                if (NULL == node->daemon && !novm) {
-                    PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s HAS NO DAEMON", node->name));
-                    continue;
-                }
-                if (!prte_nptr_match(node, nptr)) {
-                    PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
-                                         "NODE %s DOESNT MATCH NODE %s", node->name, nptr->name));
-                    continue;
+            /* go straight to the matching node in the pool */
+            node = prte_node_pool_match(nptr);
+            if (NULL != node && !target_usable(node, novm)) {
+                /* the pool can hold more than one node of the
+                 * same name, so look for another we can use */
+                node = NULL;
+                for (i = 0; i < prte_node_pool->size; i++) {
+                    node = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, i);
+                    if (NULL != node && prte_nptr_match(node, nptr)) {
+                        if (target_usable(node, novm)) {
+                            break;
+                        }
+                        /* we won't visit it again during this lookup, so
+                         * reset the state so it can be used another time */
+                        if (PRTE_NODE_STATE_DO_NOT_USE == node->state) {
+                            node->state = PRTE_NODE_STATE_UP;
+                        }
+                    }
+                    node = NULL;
                 }
+            }
+            if (NULL == node) {
+                PMIX_OUTPUT_VERBOSE((10, prte_rmaps_base_framework.framework_output,
+                                     "NO USABLE NODE MATCHES NODE %s", nptr->name));
+            } else {
                 /* retain a copy for our use in case the item gets
                  * destructed along the way
                  */
@@ -245,7 +266,6 @@ int prte_rmaps_base_get_target_nodes(pmix_list_t *allocated_nodes,
                 /* the list is ordered as per user direction using -host
                  * or the listing in -hostfile - preserve that ordering */
                 pmix_list_append(allocated_nodes, &node->super);
-                break;
             }
             /* remove the item from the list as we have allocated it */
             pmix_list_remove_item(&nodes, (pmix_list_item_t *) nptr);
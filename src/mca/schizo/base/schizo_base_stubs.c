@@ -544,7 +544,7 @@ int prte_schizo_base_setup_fork(prte_job_t *jdata, prte_app_context_t *app)
      * ones as the app-specific ones can override them. We have to
      * process them in the order they were given to ensure we wind
      * up in the desired final state */
-    PMIX_LIST_FOREACH(attr, &jdata->attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(attr, &jdata->attributes)
     {
         if (PRTE_JOB_SET_ENVAR == attr->key) {
             PMIX_SETENV_COMPAT(attr->data.data.envar.envar,
@@ -614,7 +614,7 @@ int prte_schizo_base_setup_fork(prte_job_t *jdata, prte_app_context_t *app)
     }
 
     /* now do the same thing for any app-level attributes */
-    PMIX_LIST_FOREACH(attr, &app->attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(attr, &app->attributes)
     {
         if (PRTE_APP_SET_ENVAR == attr->key) {
             PMIX_SETENV_COMPAT(attr->data.data.envar.envar,
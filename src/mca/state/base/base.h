@@ -30,6 +30,7 @@
 #include "src/mca/mca.h"
 #include "src/mca/rmaps/rmaps_types.h"
 #include "src/mca/state/state.h"
+#include "src/rml/rml_types.h"
 
 BEGIN_C_DECLS
 
@@ -47,6 +48,11 @@ typedef struct {
     bool show_launch_progress;
     bool notifyerrors;
     bool autorestart;
+    int report_window;
+    /* pass reports up the routing tree even without a window - set
+     * by components whose own traffic up the tree must not be
+     * overtaken by the reports */
+    bool report_relay;
 } prte_state_base_t;
 PRTE_EXPORT extern prte_state_base_t prte_state_base;
 
@@ -79,6 +85,12 @@ PRTE_EXPORT void prte_util_print_job_state_machine(void);
 
 PRTE_EXPORT void prte_state_base_activate_proc_state(pmix_proc_t *proc, prte_proc_state_t state);
 
+/* activate a state for a set of procs in one job - takes
+ * ownership of the ranks array */
+PRTE_EXPORT void prte_state_base_activate_proc_states(const pmix_nspace_t nspace,
+                                                      pmix_rank_t *ranks, size_t nranks,
+                                                      prte_proc_state_t state);
+
 PRTE_EXPORT int prte_state_base_add_proc_state(prte_proc_state_t state, prte_state_cbfunc_t cbfunc);
 
 PRTE_EXPORT int prte_state_base_set_proc_state_callback(prte_proc_state_t state,
@@ -97,6 +109,15 @@ PRTE_EXPORT void prte_state_base_check_all_complete(int fd, short args, void *cb
 PRTE_EXPORT void prte_state_base_check_fds(prte_job_t *jdata);
 PRTE_EXPORT void prte_state_base_notify_data_server(pmix_proc_t *target);
 
+/* reporting of local proc states by the daemons to the HNP - the
+ * reports are batched by job and sent after report_window msec */
+PRTE_EXPORT int prte_state_base_report_proc(prte_proc_t *child);
+PRTE_EXPORT int prte_state_base_report_job(prte_job_t *jdata, bool unreported);
+PRTE_EXPORT void prte_state_base_relay_reports(int status, pmix_proc_t *sender,
+                                               pmix_data_buffer_t *buffer,
+                                               prte_rml_tag_t tag, void *cbdata);
+PRTE_EXPORT void prte_state_base_report_finalize(void);
+
 END_C_DECLS
 
 #endif
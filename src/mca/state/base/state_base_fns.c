@@ -244,6 +244,40 @@ void prte_state_base_activate_proc_state(pmix_proc_t *proc, prte_proc_state_t st
     PRTE_PMIX_THREADSHIFT(caddy, prte_event_base, s->cbfunc);
 }
 
+/* only the base tracker knows how to handle a set of procs in
+ * one pass - anyone else gets them one at a time */
+void prte_state_base_activate_proc_states(const pmix_nspace_t nspace, pmix_rank_t *ranks,
+                                          size_t nranks, prte_proc_state_t state)
+{
+    prte_state_t *s;
+    prte_state_caddy_t *caddy;
+    pmix_proc_t proc;
+    size_t n;
+
+    PMIX_LIST_FOREACH(s, &prte_proc_states, prte_state_t) {
+        if (s->proc_state == state && prte_state_base_track_procs == s->cbfunc) {
+            PMIX_OUTPUT_VERBOSE((1, prte_state_base_framework.framework_output,
+                                 "%s ACTIVATE %u PROCS OF JOB %s STATE %s",
+                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned) nranks,
+                                 PRTE_JOBID_PRINT(nspace), prte_proc_state_to_str(state)));
+            caddy = PMIX_NEW(prte_state_caddy_t);
+            PMIX_LOAD_PROCID(&caddy->name, nspace, PMIX_RANK_WILDCARD);
+            caddy->proc_state = state;
+            caddy->ranks = ranks;
+            caddy->nranks = nranks;
+            PRTE_PMIX_THREADSHIFT(caddy, prte_event_base, s->cbfunc);
+            return;
+        }
+    }
+
+    PMIX_LOAD_NSPACE(proc.nspace, nspace);
+    for (n = 0; n < nranks; n++) {
+        proc.rank = ranks[n];
+        PRTE_ACTIVATE_PROC_STATE(&proc, state);
+    }
+    free(ranks);
+}
+
 int prte_state_base_add_proc_state(prte_proc_state_t state, prte_state_cbfunc_t cbfunc)
 {
     pmix_list_item_t *item;
@@ -420,33 +454,20 @@ static void opcbfunc(pmix_status_t status, void *cbdata)
     PRTE_PMIX_WAKEUP_THREAD(lock);
 }
 
-void prte_state_base_track_procs(int fd, short argc, void *cbdata)
+/* returns false if no further procs should be tracked */
+static bool track_proc(prte_job_t *jdata, pmix_proc_t *proc, prte_proc_state_t state)
 {
-    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
-    pmix_proc_t *proc;
-    pmix_rank_t tgt, *tptr;
-    prte_proc_state_t state;
-    prte_job_t *jdata;
     prte_proc_t *pdata;
     int i;
     pmix_proc_t target;
     prte_pmix_lock_t lock;
     pmix_rank_t threshold;
-    PRTE_HIDE_UNUSED_PARAMS(fd, argc);
-
-    PMIX_ACQUIRE_OBJECT(caddy);
-    proc = &caddy->name;
-    state = caddy->proc_state;
 
     pmix_output_verbose(5, prte_state_base_framework.framework_output,
                         "%s state:base:track_procs called for proc %s state %s",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(proc),
                         prte_proc_state_to_str(state));
 
-    /* get the job object for this proc */
-    if (NULL == (jdata = prte_get_job_data_object(proc->nspace))) {
-        goto cleanup;
-    }
     if (PRTE_PROC_STATE_READY_FOR_DEBUG == state) {
         if (prte_get_attribute(&jdata->attributes, PRTE_JOB_STOP_ON_EXEC, NULL, PMIX_BOOL) ||
             prte_get_attribute(&jdata->attributes, PRTE_JOB_STOP_IN_INIT, NULL, PMIX_BOOL) ||
@@ -462,7 +483,7 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
                 jdata->num_ready_for_debug++;
             }
             if (jdata->num_ready_for_debug < threshold) {
-                goto cleanup;
+                return true;
             }
             PMIX_OUTPUT_VERBOSE((2, prte_state_base_framework.framework_output,
                                  "%s state:base all local %s procs on node %s ready for debug",
@@ -471,12 +492,12 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
             /* let the DVM master know we are ready */
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_READY_FOR_DEBUG);
         }
-        goto cleanup;
+        return true;
     }
 
     pdata = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, proc->rank);
     if (NULL == pdata) {
-        goto cleanup;
+        return true;
     }
 
     if (PRTE_PROC_STATE_RUNNING == state) {
@@ -528,7 +549,7 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
                                 "%s state:base:track_procs proc %s already in state %s. Skip transition.",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(proc),
                                 prte_proc_state_to_str(state));
-            goto cleanup;
+            return true;
         }
 
         /* update the proc state */
@@ -552,7 +573,7 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
                 if (NULL != pdata &&
                     PRTE_FLAG_TEST(pdata, PRTE_PROC_FLAG_ALIVE)) {
                     /* at least one is still alive */
-                    goto cleanup;
+                    return true;
                 }
             }
             /* call our appropriate exit procedure */
@@ -560,7 +581,7 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
                                  "%s state:base all routes and children gone - exiting",
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
             PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_DAEMONS_TERMINATED);
-            goto cleanup;
+            return false;
         }
         /* track job status */
         jdata->num_terminated++;
@@ -578,6 +599,34 @@ void prte_state_base_track_procs(int fd, short argc, void *cbdata)
             PRTE_ACTIVATE_JOB_STATE(jdata, PRTE_JOB_STATE_TERMINATED);
         }
     }
+    return true;
+}
+
+void prte_state_base_track_procs(int fd, short argc, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    prte_job_t *jdata;
+    pmix_proc_t proc;
+    size_t n;
+    PRTE_HIDE_UNUSED_PARAMS(fd, argc);
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+
+    /* get the job object for these procs */
+    if (NULL == (jdata = prte_get_job_data_object(caddy->name.nspace))) {
+        goto cleanup;
+    }
+    if (NULL == caddy->ranks) {
+        track_proc(jdata, &caddy->name, caddy->proc_state);
+        goto cleanup;
+    }
+    PMIX_LOAD_NSPACE(proc.nspace, caddy->name.nspace);
+    for (n = 0; n < caddy->nranks; n++) {
+        proc.rank = caddy->ranks[n];
+        if (!track_proc(jdata, &proc, caddy->proc_state)) {
+            break;
+        }
+    }
 
 cleanup:
     PMIX_RELEASE(caddy);
@@ -47,7 +47,8 @@ prte_state_base_t prte_state_base = {
     .run_fdcheck = false,
     .recoverable = false,
     .max_restarts = 0,
-    .continuous = false
+    .continuous = false,
+    .report_relay = false
 };
 prte_state_base_module_t prte_state = {0};
 
@@ -103,6 +104,17 @@ static int prte_state_base_register(pmix_mca_base_register_flag_t flags)
                                PMIX_MCA_BASE_VAR_TYPE_BOOL,
                                &prte_state_base.autorestart);
 
+    prte_state_base.report_window = 0;
+    pmix_mca_base_var_register("prte", "state", "base", "report_window",
+                               "Time (in msec) daemons collect proc state changes before reporting "
+                               "them, merging the reports of their children in the routing tree "
+                               "along the way (0 => report once pending events are processed)",
+                               PMIX_MCA_BASE_VAR_TYPE_INT,
+                               &prte_state_base.report_window);
+    if (0 > prte_state_base.report_window) {
+        prte_state_base.report_window = 0;
+    }
+
     return PRTE_SUCCESS;
 }
 
@@ -112,6 +124,7 @@ static int prte_state_base_close(void)
     if (NULL != prte_state.finalize) {
         prte_state.finalize();
     }
+    prte_state_base_report_finalize();
 
     return pmix_mca_base_framework_components_close(&prte_state_base_framework, NULL);
 }
@@ -143,6 +156,8 @@ static void prte_state_caddy_construct(prte_state_caddy_t *caddy)
 {
     memset(&caddy->ev, 0, sizeof(prte_event_t));
     caddy->jdata = NULL;
+    caddy->ranks = NULL;
+    caddy->nranks = 0;
 }
 static void prte_state_caddy_destruct(prte_state_caddy_t *caddy)
 {
@@ -150,6 +165,9 @@ static void prte_state_caddy_destruct(prte_state_caddy_t *caddy)
     if (NULL != caddy->jdata) {
         PMIX_RELEASE(caddy->jdata);
     }
+    if (NULL != caddy->ranks) {
+        free(caddy->ranks);
+    }
 }
 PMIX_CLASS_INSTANCE(prte_state_caddy_t, pmix_object_t, prte_state_caddy_construct,
                     prte_state_caddy_destruct);
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Batched reporting of local proc states by the daemons. Reports
+ * are collected per job and sent to the HNP as a single
+ * PRTE_PLM_UPDATE_PROC_STATE message once the pending events have
+ * been processed. If a report window is given, the reports are held
+ * for that long and passed up the routing tree instead, with each
+ * daemon merging those from its children into its own. They also
+ * take the tree when report_relay is set, but without the wait.
+ */
+
+#include "prte_config.h"
+#include "constants.h"
+
+#include <string.h>
+
+#include "src/class/pmix_list.h"
+#include "src/event/event-internal.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/util/name_fns.h"
+#include "src/util/pmix_output.h"
+
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/plm/plm_types.h"
+#include "src/rml/rml.h"
+#include "src/runtime/prte_globals.h"
+
+#include "src/mca/state/base/base.h"
+
+typedef struct {
+    pmix_list_item_t super;
+    pmix_nspace_t nspace;
+    pmix_data_buffer_t procs;
+} prte_state_report_t;
+static void rpcon(prte_state_report_t *p)
+{
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->procs);
+}
+static void rpdes(prte_state_report_t *p)
+{
+    PMIX_DATA_BUFFER_DESTRUCT(&p->procs);
+}
+static PMIX_CLASS_INSTANCE(prte_state_report_t, pmix_list_item_t, rpcon, rpdes);
+
+static pmix_list_t reports;
+static prte_event_t report_ev;
+static bool reports_init = false;
+static bool report_active = false;
+
+static void send_reports(int fd, short args, void *cbdata);
+
+static prte_state_report_t *get_report(const pmix_nspace_t nspace)
+{
+    prte_state_report_t *rep;
+
+    if (!reports_init) {
+        PMIX_CONSTRUCT(&reports, pmix_list_t);
+        prte_event_evtimer_set(prte_event_base, &report_ev, send_reports, NULL);
+        reports_init = true;
+    }
+    PMIX_LIST_FOREACH(rep, &reports, prte_state_report_t) {
+        if (PMIX_CHECK_NSPACE(rep->nspace, nspace)) {
+            return rep;
+        }
+    }
+    rep = PMIX_NEW(prte_state_report_t);
+    if (NULL == rep) {
+        return NULL;
+    }
+    PMIX_LOAD_NSPACE(rep->nspace, nspace);
+    pmix_list_append(&reports, &rep->super);
+    return rep;
+}
+
+static void schedule_reports(void)
+{
+    struct timeval tv;
+
+    if (report_active) {
+        return;
+    }
+    report_active = true;
+    if (0 < prte_state_base.report_window) {
+        tv.tv_sec = prte_state_base.report_window / 1000;
+        tv.tv_usec = (prte_state_base.report_window % 1000) * 1000;
+        prte_event_evtimer_add(&report_ev, &tv);
+    } else {
+        prte_event_active(&report_ev, PRTE_EV_WRITE, 1);
+    }
+}
+
+static int pack_entry(pmix_data_buffer_t *buf, pmix_rank_t rank, pid_t pid,
+                      prte_proc_state_t state, prte_exit_code_t exit_code)
+{
+    int rc;
+
+    rc = PMIx_Data_pack(NULL, buf, &rank, 1, PMIX_PROC_RANK);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &pid, 1, PMIX_PID);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &state, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, buf, &exit_code, 1, PMIX_INT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+int prte_state_base_report_proc(prte_proc_t *child)
+{
+    prte_state_report_t *rep;
+    int rc;
+
+    rep = get_report(child->name.nspace);
+    if (NULL == rep) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    rc = pack_entry(&rep->procs, child->name.rank, child->pid, child->state, child->exit_code);
+    schedule_reports();
+    return rc;
+}
+
+/* report all local procs in the job - if unreported is true, then
+ * skip those whose termination was already reported and mark the
+ * rest as having been reported */
+int prte_state_base_report_job(prte_job_t *jdata, bool unreported)
+{
+    prte_state_report_t *rep;
+    prte_proc_t *child;
+    int i, rc = PRTE_SUCCESS;
+
+    /* the job is included even if none of its procs are so
+     * the HNP hears from us */
+    rep = get_report(jdata->nspace);
+    if (NULL == rep) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (i = 0; i < prte_local_children->size; i++) {
+        child = (prte_proc_t *) pmix_pointer_array_get_item(prte_local_children, i);
+        if (NULL == child || !PMIX_CHECK_NSPACE(child->name.nspace, jdata->nspace)) {
+            continue;
+        }
+        if (unreported && PRTE_FLAG_TEST(child, PRTE_PROC_FLAG_TERM_REPORTED)) {
+            continue;
+        }
+        rc = pack_entry(&rep->procs, child->name.rank, child->pid, child->state,
+                        child->exit_code);
+        if (PRTE_SUCCESS != rc) {
+            break;
+        }
+        if (unreported) {
+            PRTE_FLAG_SET(child, PRTE_PROC_FLAG_TERM_REPORTED);
+        }
+    }
+    schedule_reports();
+    return rc;
+}
+
+static void send_reports(int fd, short args, void *cbdata)
+{
+    prte_state_report_t *rep;
+    pmix_data_buffer_t *buf;
+    prte_plm_cmd_flag_t cmd = PRTE_PLM_UPDATE_PROC_STATE;
+    pmix_rank_t null = PMIX_RANK_INVALID, target;
+    prte_rml_tag_t tag = PRTE_RML_TAG_PLM;
+    int rc = PMIX_SUCCESS;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args, cbdata);
+
+    report_active = false;
+    if (0 == pmix_list_get_size(&reports)) {
+        return;
+    }
+
+    /* if we are windowed, let our parent merge these with the
+     * reports from the rest of its subtree */
+    target = PRTE_PROC_MY_HNP->rank;
+    if (0 < prte_state_base.report_window || prte_state_base.report_relay) {
+        target = prte_rml_get_route(PRTE_PROC_MY_HNP->rank);
+        if (PMIX_RANK_INVALID == target) {
+            target = PRTE_PROC_MY_HNP->rank;
+        } else if (target != PRTE_PROC_MY_HNP->rank) {
+            tag = PRTE_RML_TAG_PROC_STATE;
+        }
+    }
+
+    PMIX_DATA_BUFFER_CREATE(buf);
+    if (PRTE_RML_TAG_PLM == tag) {
+        rc = PMIx_Data_pack(NULL, buf, &cmd, 1, PMIX_UINT8);
+    }
+    while (NULL != (rep = (prte_state_report_t *) pmix_list_remove_first(&reports))) {
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buf, &rep->nspace, 1, PMIX_PROC_NSPACE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_copy_payload(buf, &rep->procs);
+        }
+        /* flag the end of the job so the receiver can know */
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, buf, &null, 1, PMIX_PROC_RANK);
+        }
+        PMIX_RELEASE(rep);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+        return;
+    }
+
+    PMIX_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                         "%s state:base sending proc state reports to %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_VPID_PRINT(target)));
+
+    PRTE_RML_SEND(rc, target, buf, tag);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(buf);
+    }
+}
+
+/* merge the reports from a child daemon into our own */
+void prte_state_base_relay_reports(int status, pmix_proc_t *sender,
+                                   pmix_data_buffer_t *buffer,
+                                   prte_rml_tag_t tag, void *cbdata)
+{
+    prte_state_report_t *rep;
+    pmix_nspace_t nspace;
+    pmix_rank_t rank;
+    pid_t pid;
+    prte_proc_state_t state;
+    prte_exit_code_t exit_code;
+    int32_t cnt;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tag, cbdata);
+
+    PMIX_OUTPUT_VERBOSE((5, prte_state_base_framework.framework_output,
+                         "%s state:base relaying proc state reports from %s",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender)));
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_PROC_NSPACE);
+    while (PMIX_SUCCESS == rc) {
+        if (NULL == (rep = get_report(nspace))) {
+            rc = PMIX_ERR_NOMEM;
+            break;
+        }
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &rank, &cnt, PMIX_PROC_RANK);
+        while (PMIX_SUCCESS == rc && PMIX_RANK_INVALID != rank) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &pid, &cnt, PMIX_PID);
+            if (PMIX_SUCCESS == rc) {
+                cnt = 1;
+                rc = PMIx_Data_unpack(NULL, buffer, &state, &cnt, PMIX_UINT32);
+            }
+            if (PMIX_SUCCESS == rc) {
+                cnt = 1;
+                rc = PMIx_Data_unpack(NULL, buffer, &exit_code, &cnt, PMIX_INT32);
+            }
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            if (PRTE_SUCCESS != pack_entry(&rep->procs, rank, pid, state, exit_code)) {
+                rc = PMIX_ERR_PACK_FAILURE;
+                break;
+            }
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, buffer, &rank, &cnt, PMIX_PROC_RANK);
+        }
+        if (PMIX_SUCCESS != rc) {
+            break;
+        }
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, buffer, &nspace, &cnt, PMIX_PROC_NSPACE);
+    }
+    if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    if (reports_init && 0 < pmix_list_get_size(&reports)) {
+        schedule_reports();
+    }
+}
+
+void prte_state_base_report_finalize(void)
+{
+    if (!reports_init) {
+        return;
+    }
+    if (report_active) {
+        prte_event_del(&report_ev);
+        report_active = false;
+    }
+    PMIX_LIST_DESTRUCT(&reports);
+    reports_init = false;
+}
@@ -32,6 +32,7 @@
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/filem/filem.h"
+#include "src/mca/grpcomm/base/base.h"
 #include "src/mca/grpcomm/grpcomm.h"
 #include "src/mca/iof/base/base.h"
 #include "src/mca/odls/odls_types.h"
@@ -256,6 +257,76 @@ static void init_complete(int sd, short args, void *cbdata)
     PMIX_RELEASE(caddy);
 }
 
+/* pack the contact info for the daemons starting at the given rank */
+static int pack_wireup(pmix_data_buffer_t *buf, pmix_rank_t first)
+{
+    prte_job_t *jptr;
+    prte_proc_t *dmn;
+    pmix_value_t *val;
+    pmix_status_t ret;
+    int32_t v;
+
+    jptr = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    for (v = first; v < jptr->procs->size; v++) {
+        if (NULL == (dmn = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, v))) {
+            continue;
+        }
+        val = NULL;
+        if (PMIX_SUCCESS != (ret = PMIx_Get(&dmn->name, PMIX_PROC_URI, NULL, 0, &val)) ||
+            NULL == val) {
+            PMIX_ERROR_LOG(ret);
+            return PRTE_ERR_NOT_FOUND;
+        }
+        ret = PMIx_Data_pack(NULL, buf, &dmn->name, 1, PMIX_PROC);
+        if (PMIX_SUCCESS == ret) {
+            ret = PMIx_Data_pack(NULL, buf, &val->data.string, 1, PMIX_STRING);
+        }
+        PMIX_VALUE_RELEASE(val);
+        if (PMIX_SUCCESS != ret) {
+            PMIX_ERROR_LOG(ret);
+            return ret;
+        }
+    }
+    return PRTE_SUCCESS;
+}
+
+/* send the full node map and contact info directly to the
+ * daemons that joined since the last update */
+static int send_full_wireup(pmix_rank_t first_new)
+{
+    pmix_data_buffer_t full, *buf;
+    pmix_rank_t v;
+    int rc;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&full);
+    rc = prte_util_nidmap_create(prte_node_pool, &full);
+    if (PRTE_SUCCESS == rc) {
+        rc = pack_wireup(&full, 0);
+    }
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&full);
+        return rc;
+    }
+    for (v = first_new; v < prte_process_info.num_daemons; v++) {
+        PMIX_DATA_BUFFER_CREATE(buf);
+        rc = PMIx_Data_copy_payload(buf, &full);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+            break;
+        }
+        PRTE_RML_SEND(rc, v, buf, PRTE_RML_TAG_WIREUP);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+            break;
+        }
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&full);
+    return rc;
+}
+
 static void vm_ready(int fd, short args, void *cbdata)
 {
     prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
@@ -263,10 +334,7 @@ static void vm_ready(int fd, short args, void *cbdata)
     pmix_data_buffer_t buf;
     prte_grpcomm_signature_t sig;
     prte_job_t *jptr;
-    prte_proc_t *dmn;
-    int32_t v;
-    pmix_value_t *val;
-    pmix_status_t ret;
+    pmix_rank_t first_new;
     PRTE_HIDE_UNUSED_PARAMS(fd, args, cbdata);
 
     PMIX_ACQUIRE_OBJECT(caddy);
@@ -278,45 +346,32 @@ static void vm_ready(int fd, short args, void *cbdata)
             && 1 < prte_process_info.num_daemons) {
             /* send the daemon map to every daemon in this DVM - we
              * do this here so we don't have to do it for every
-             * job we are going to launch */
+             * job we are going to launch. If the DVM has grown, this
+             * is just what changed and only the new daemons need
+             * to be sent everything */
             PMIX_DATA_BUFFER_CONSTRUCT(&buf);
-            rc = prte_util_nidmap_create(prte_node_pool, &buf);
+            rc = prte_util_nidmap_create_update(prte_node_pool, &buf, &first_new);
             if (PRTE_SUCCESS != rc) {
                 PRTE_ERROR_LOG(rc);
                 PMIX_DATA_BUFFER_DESTRUCT(&buf);
                 PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
                 return;
             }
-            /* get wireup info for daemons */
-            jptr = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
-            for (v = 0; v < jptr->procs->size; v++) {
-                if (NULL == (dmn = (prte_proc_t *) pmix_pointer_array_get_item(jptr->procs, v))) {
-                    continue;
-                }
-                val = NULL;
-                if (PMIX_SUCCESS != (ret = PMIx_Get(&dmn->name, PMIX_PROC_URI, NULL, 0, &val)) ||
-                    NULL == val) {
-                    PMIX_ERROR_LOG(ret);
+            if (PMIX_RANK_INVALID != first_new) {
+                rc = send_full_wireup(first_new);
+                if (PRTE_SUCCESS != rc) {
                     PMIX_DATA_BUFFER_DESTRUCT(&buf);
                     PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
                     return;
                 }
-                rc = PMIx_Data_pack(NULL, &buf, &dmn->name, 1, PMIX_PROC);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&buf);
-                    PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                    return;
-                }
-                rc = PMIx_Data_pack(NULL, &buf, &val->data.string, 1, PMIX_STRING);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&buf);
-                    PMIX_VALUE_RELEASE(val);
-                    PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
-                    return;
-                }
-                PMIX_VALUE_RELEASE(val);
+            }
+            /* get wireup info for daemons - those already running
+             * only need to hear about the new ones */
+            rc = pack_wireup(&buf, (PMIX_RANK_INVALID == first_new) ? 0 : first_new);
+            if (PRTE_SUCCESS != rc) {
+                PMIX_DATA_BUFFER_DESTRUCT(&buf);
+                PRTE_ACTIVATE_JOB_STATE(NULL, PRTE_JOB_STATE_FORCED_EXIT);
+                return;
             }
 
             /* goes to all daemons */
@@ -590,6 +645,7 @@ static void check_complete(int fd, short args, void *cbdata)
     /* cleanup any pending server ops */
     PMIX_LOAD_PROCID(&pname, jdata->nspace, PMIX_RANK_WILDCARD);
     prte_pmix_server_clear(&pname);
+    prte_grpcomm_base_purge_sig_info(jdata->nspace);
 
     /* cleanup the local procs as these are gone */
     for (i = 0; i < prte_local_children->size; i++) {
@@ -72,6 +72,10 @@ typedef struct {
     prte_job_state_t job_state;
     pmix_proc_t name;
     prte_proc_state_t proc_state;
+    /* if given, the ranks in name.nspace that all
+     * reached proc_state */
+    pmix_rank_t *ranks;
+    size_t nranks;
 } prte_state_caddy_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_state_caddy_t);
 
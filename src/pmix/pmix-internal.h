@@ -245,12 +245,55 @@ static inline __prte_attribute_always_inline__ void pmix_proc_hton_intr(pmix_pro
 typedef uint16_t prte_attribute_key_t;
 #define PRTE_ATTR_KEY_T PRTE_UINT16
 typedef struct {
-    pmix_list_item_t super;   /* required for this to be on lists */
     prte_attribute_key_t key; /* key identifier */
     bool local;               // whether or not to pack/send this value
     pmix_value_t data;
 } prte_attribute_t;
-PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_attribute_t);
+
+#define PRTE_ATTRIBUTE_CONSTRUCT(a)                 \
+    do {                                            \
+        (a)->key = 0;                               \
+        (a)->local = true;                          \
+        memset(&(a)->data, 0, sizeof((a)->data));   \
+    } while (0)
+
+#define PRTE_ATTRIBUTE_DESTRUCT(a)          \
+    do {                                    \
+        PMIX_VALUE_DESTRUCT(&(a)->data);    \
+    } while (0)
+
+/* the attributes of an object, held by value in a single array
+ * in the order they were added. Objects only carry a handful of
+ * attributes, so searching the array is faster than walking a
+ * list - and the store doesn't need an object header of its own */
+typedef struct {
+    prte_attribute_t *attrs;
+    uint32_t num_attrs;
+    uint32_t size;
+} prte_attr_list_t;
+
+#define PRTE_ATTR_LIST_CONSTRUCT(l) \
+    do {                            \
+        (l)->attrs = NULL;          \
+        (l)->num_attrs = 0;         \
+        (l)->size = 0;              \
+    } while (0)
+
+#define PRTE_ATTR_LIST_DESTRUCT(l)                      \
+    do {                                                \
+        uint32_t _n;                                    \
+        for (_n = 0; _n < (l)->num_attrs; _n++) {       \
+            PRTE_ATTRIBUTE_DESTRUCT(&(l)->attrs[_n]);   \
+        }                                               \
+        free((l)->attrs);                               \
+        PRTE_ATTR_LIST_CONSTRUCT(l);                    \
+    } while (0)
+
+/* iterate over the attributes - the store must not be
+ * changed during the loop */
+#define PRTE_ATTR_FOREACH(kv, l)                                                    \
+    for ((kv) = (l)->attrs; NULL != (kv) && (kv) < (l)->attrs + (l)->num_attrs; \
+         (kv)++)
 
 /* some helper functions */
 PRTE_EXPORT pmix_proc_state_t prte_pmix_convert_state(int state);
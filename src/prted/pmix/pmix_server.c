@@ -584,6 +584,10 @@ int pmix_server_init(void)
     PMIX_CONSTRUCT(&prte_pmix_server_globals.remote_reqs, pmix_pointer_array_t);
     pmix_pointer_array_init(&prte_pmix_server_globals.remote_reqs, 128, INT_MAX, 2);
     PMIX_CONSTRUCT(&prte_pmix_server_globals.notifications, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.dmdx_batches, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_pmix_server_globals.dmdx_batch_index, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_pmix_server_globals.dmdx_batch_index, 64);
+    prte_pmix_server_globals.dmdx_flush_active = false;
     prte_pmix_server_globals.server = *PRTE_NAME_INVALID;
     prte_pmix_server_globals.scheduler_connected = false;
     prte_pmix_server_globals.scheduler_set_as_server = false;
@@ -982,11 +986,93 @@ void pmix_server_finalize(void)
     PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.psets);
     PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.groups);
     PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.tools);
+    if (prte_pmix_server_globals.dmdx_flush_active) {
+        prte_event_del(&prte_pmix_server_globals.dmdx_flush);
+        prte_pmix_server_globals.dmdx_flush_active = false;
+    }
+    PMIX_DESTRUCT(&prte_pmix_server_globals.dmdx_batch_index);
+    PMIX_LIST_DESTRUCT(&prte_pmix_server_globals.dmdx_batches);
 
     /* shutdown the local server */
     prte_pmix_server_globals.initialized = false;
 }
 
+/* send everything that was queued for each daemon
+ * during the last pass of the event loop */
+static void dmdx_flush(int sd, short args, void *cbdata)
+{
+    pmix_server_dmdx_batch_t *batch;
+    pmix_data_buffer_t *buf;
+    pmix_byte_object_t bo;
+    pmix_status_t prc;
+    int rc;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args, cbdata);
+
+    prte_pmix_server_globals.dmdx_flush_active = false;
+    pmix_hash_table_remove_all(&prte_pmix_server_globals.dmdx_batch_index);
+
+    while (NULL != (batch = (pmix_server_dmdx_batch_t *)
+                        pmix_list_remove_first(&prte_pmix_server_globals.dmdx_batches))) {
+        pmix_output_verbose(2, prte_pmix_server_globals.output,
+                            "%s dmdx:flush sending %d msgs with tag %u to %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), batch->nmsgs,
+                            (unsigned) batch->tag, PRTE_VPID_PRINT(batch->target));
+        prc = PMIx_Data_unload(&batch->msgs, &bo);
+        if (PMIX_SUCCESS != prc) {
+            PMIX_ERROR_LOG(prc);
+            PMIX_RELEASE(batch);
+            continue;
+        }
+        PMIX_DATA_BUFFER_CREATE(buf);
+        PMIX_DATA_BUFFER_LOAD(buf, bo.bytes, bo.size);
+        PRTE_RML_SEND(rc, batch->target, buf, batch->tag);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(buf);
+        }
+        PMIX_RELEASE(batch);
+    }
+}
+
+/* add a direct modex request or response to the batch for the
+ * given daemon - the caller retains ownership of the msg.
+ * NOTE: this function must be called from within an event! */
+int pmix_server_dmdx_queue(pmix_rank_t target, prte_rml_tag_t tag, pmix_data_buffer_t *msg)
+{
+    pmix_server_dmdx_batch_t *batch;
+    uint64_t key;
+    void *ptr;
+    pmix_status_t prc;
+
+    key = ((uint64_t) tag << 32) | (uint64_t) target;
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint64(&prte_pmix_server_globals.dmdx_batch_index,
+                                                         key, &ptr)) {
+        batch = (pmix_server_dmdx_batch_t *) ptr;
+    } else {
+        batch = PMIX_NEW(pmix_server_dmdx_batch_t);
+        batch->target = target;
+        batch->tag = tag;
+        pmix_list_append(&prte_pmix_server_globals.dmdx_batches, &batch->super);
+        pmix_hash_table_set_value_uint64(&prte_pmix_server_globals.dmdx_batch_index, key, batch);
+    }
+    prc = PMIx_Data_copy_payload(&batch->msgs, msg);
+    if (PMIX_SUCCESS != prc) {
+        PMIX_ERROR_LOG(prc);
+        return prte_pmix_convert_status(prc);
+    }
+    ++batch->nmsgs;
+
+    if (!prte_pmix_server_globals.dmdx_flush_active) {
+        /* anything else queued before this event fires
+         * will go out with this msg */
+        prte_pmix_server_globals.dmdx_flush_active = true;
+        prte_event_set(prte_event_base, &prte_pmix_server_globals.dmdx_flush, -1,
+                       PRTE_EV_WRITE, dmdx_flush, NULL);
+        prte_event_active(&prte_pmix_server_globals.dmdx_flush, PRTE_EV_WRITE, 1);
+    }
+    return PRTE_SUCCESS;
+}
+
 static void send_error(int status, pmix_proc_t *idreq, pmix_proc_t *remote, int remote_index)
 {
     pmix_data_buffer_t *reply;
@@ -1015,11 +1101,11 @@ static void send_error(int status, pmix_proc_t *idreq, pmix_proc_t *remote, int
     }
 
     /* send the response */
-    PRTE_RML_SEND(prc, remote->rank, reply, PRTE_RML_TAG_DIRECT_MODEX_RESP);
+    prc = pmix_server_dmdx_queue(remote->rank, PRTE_RML_TAG_DIRECT_MODEX_RESP, reply);
     if (PRTE_SUCCESS != prc) {
         PRTE_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
     }
+    PMIX_DATA_BUFFER_RELEASE(reply);
 }
 
 static void _mdxresp(int sd, short args, void *cbdata)
@@ -1078,11 +1164,11 @@ static void _mdxresp(int sd, short args, void *cbdata)
     }
 
     /* send the response */
-    PRTE_RML_SEND(prc, req->proxy.rank, reply, PRTE_RML_TAG_DIRECT_MODEX_RESP);
+    prc = pmix_server_dmdx_queue(req->proxy.rank, PRTE_RML_TAG_DIRECT_MODEX_RESP, reply);
     if (PRTE_SUCCESS != prc) {
         PRTE_ERROR_LOG(prc);
-        PMIX_DATA_BUFFER_RELEASE(reply);
     }
+    PMIX_DATA_BUFFER_RELEASE(reply);
 
 error:
     PMIX_RELEASE(req);
@@ -1125,25 +1211,172 @@ static void modex_resp(pmix_status_t status, char *data, size_t sz, void *cbdata
     prte_event_active(&(req->ev), PRTE_EV_WRITE, 1);
 }
 
+/* drop a remote request we are no longer going to serve */
+static void dmdx_drop(pmix_server_req_t *req)
+{
+    if (req->event_active) {
+        /* delete the timeout event */
+        prte_event_del(&req->ev);
+        req->event_active = false;
+    }
+    if (req->cycle_active) {
+        prte_event_del(&req->cycle);
+        req->cycle_active = false;
+    }
+    pmix_pointer_array_set_item(&prte_pmix_server_globals.remote_reqs, req->local_index, NULL);
+    PMIX_RELEASE(req);
+}
+
+static void dmdx_check(int sd, short args, void *cbdata);
+
+/* the local client has not posted the required key, and we
+ * have no way of being told when it posts more data once it
+ * has committed - so check back with an increasing delay */
+static void dmdx_backoff(pmix_server_req_t *req)
+{
+    struct timeval tv;
+    long usec;
+
+    usec = 10000L << (req->ncycles < 8 ? req->ncycles : 8);
+    if (2000000L < usec) {
+        usec = 2000000L;
+    }
+    ++req->ncycles;
+    tv.tv_sec = usec / 1000000L;
+    tv.tv_usec = usec % 1000000L;
+    prte_event_evtimer_set(prte_event_base, &req->cycle, dmdx_check, req);
+    req->cycle_active = true;
+    PMIX_POST_OBJECT(req);
+    prte_event_evtimer_add(&req->cycle, &tv);
+}
+
+static void dmdx_committed(int sd, short args, void *cbdata)
+{
+    pmix_server_req_t *req = (pmix_server_req_t *) cbdata;
+    pmix_value_t *pval = NULL;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(req);
+    req->inprogress = false;
+    req->cycle_active = false;
+
+    if (req != pmix_pointer_array_get_item(&prte_pmix_server_globals.remote_reqs,
+                                           req->local_index)) {
+        /* the request was cleared while we were waiting */
+        if (NULL != req->data) {
+            free(req->data);
+            req->data = NULL;
+        }
+        PMIX_RELEASE(req);
+        return;
+    }
+    if (req->timed_out) {
+        if (NULL != req->data) {
+            free(req->data);
+            req->data = NULL;
+        }
+        dmdx_drop(req);
+        return;
+    }
+
+    if (PMIX_SUCCESS == req->pstatus) {
+        if (PMIX_SUCCESS != PMIx_Get(&req->tproc, req->key, req->info, req->ninfo, &pval)) {
+            pmix_output_verbose(2, prte_pmix_server_globals.output,
+                                "%s dmdx:commit key %s still not found - resetting wait",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), req->key);
+            if (NULL != req->data) {
+                free(req->data);
+                req->data = NULL;
+            }
+            req->sz = 0;
+            dmdx_backoff(req);
+            return;
+        }
+        PMIX_VALUE_RELEASE(pval);
+    }
+
+    /* the payload we were given includes the key, so send it */
+    if (req->event_active) {
+        prte_event_del(&req->ev);
+        req->event_active = false;
+    }
+    _mdxresp(-1, 0, req);
+}
+
+/* the PMIx server holds a dmodex request for a local proc until
+ * that proc commits its data, so use it to wake us up when the
+ * client posts - executes in the PMIx server's progress thread */
+static void dmdx_commit_cbfunc(pmix_status_t status, char *data, size_t sz, void *cbdata)
+{
+    pmix_server_req_t *req = (pmix_server_req_t *) cbdata;
+
+    PMIX_ACQUIRE_OBJECT(req);
+
+    req->pstatus = status;
+    if (PMIX_SUCCESS == status && NULL != data) {
+        /* we need to preserve the data as the caller
+         * will free it upon our return */
+        req->data = (char *) malloc(sz);
+        if (NULL == req->data) {
+            PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        } else {
+            memcpy(req->data, data, sz);
+            req->sz = sz;
+        }
+    }
+    prte_event_set(prte_event_base, &(req->cycle), -1, PRTE_EV_WRITE, dmdx_committed, req);
+    req->cycle_active = true;
+    PMIX_POST_OBJECT(req);
+    prte_event_active(&(req->cycle), PRTE_EV_WRITE, 1);
+}
+
+/* wait for the local client to post the key the
+ * remote proc requires */
+static void dmdx_await_key(pmix_server_req_t *req)
+{
+    pmix_status_t rc;
+
+    if (0 < req->ncycles) {
+        /* the client has already committed at least
+         * once, so the PMIx server will not hold us */
+        dmdx_backoff(req);
+        return;
+    }
+    req->inprogress = true;
+    rc = PMIx_server_dmodex_request(&req->tproc, dmdx_commit_cbfunc, req);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        req->inprogress = false;
+        send_error(rc, &req->tproc, &req->proxy, req->remote_index);
+        dmdx_drop(req);
+    }
+}
+
 static void dmdx_check(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t*)cbdata;
     prte_job_t *jdata;
     prte_proc_t *proc;
-    struct timeval tv = {2, 0};
     pmix_value_t *pval = NULL;
     pmix_status_t rc;
     PRTE_HIDE_UNUSED_PARAMS(sd, args);
 
+    PMIX_ACQUIRE_OBJECT(req);
+    req->cycle_active = false;
+
+    if (req->timed_out) {
+        /* the requestor has already been told */
+        dmdx_drop(req);
+        return;
+    }
+
     /* do we know about this job? */
     jdata = prte_get_job_data_object(req->tproc.nspace);
     if (NULL == jdata) {
-        /* wait some more */
+        /* we will be woken up when it is registered */
         pmix_output_verbose(2, prte_pmix_server_globals.output,
                             "%s dmdx:recv dmdx_check cannot find job object - delaying",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-        PMIX_POST_OBJECT(req);
-        prte_event_evtimer_add(&req->cycle, &tv);
         return;
     }
 
@@ -1152,23 +1385,13 @@ static void dmdx_check(int sd, short args, void *cbdata)
     if (NULL == proc) {
         /* this is truly an error, so notify the sender */
         send_error(PRTE_ERR_NOT_FOUND, &req->tproc, &req->proxy, req->remote_index);
-        if (req->event_active) {
-            /* delete the timeout event */
-            prte_event_del(&req->ev);
-        }
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.remote_reqs, req->local_index, NULL);
-        PMIX_RELEASE(req);
+        dmdx_drop(req);
         return;
     }
     if (!PRTE_FLAG_TEST(proc, PRTE_PROC_FLAG_LOCAL)) {
         /* send back an error - they obviously have made a mistake */
         send_error(PRTE_ERR_NOT_FOUND, &req->tproc, &req->proxy, req->remote_index);
-        if (req->event_active) {
-            /* delete the timeout event */
-            prte_event_del(&req->ev);
-        }
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.remote_reqs, req->local_index, NULL);
-        PMIX_RELEASE(req);
+        dmdx_drop(req);
         return;
     }
 
@@ -1181,8 +1404,7 @@ static void dmdx_check(int sd, short args, void *cbdata)
             pmix_output_verbose(2, prte_pmix_server_globals.output,
                                 "%s dmdx:recv key %s not found - resetting wait",
                                 PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), req->key);
-            PMIX_POST_OBJECT(req);
-            prte_event_evtimer_add(&req->cycle, &tv);
+            dmdx_await_key(req);
             return;
         }
         PMIX_VALUE_RELEASE(pval);
@@ -1196,22 +1418,42 @@ static void dmdx_check(int sd, short args, void *cbdata)
         PMIX_ERROR_LOG(rc);
         req->inprogress = false;
         send_error(rc, &req->tproc, &req->proxy, req->remote_index);
-        if (req->event_active) {
-            /* delete the timeout event */
-            prte_event_del(&req->ev);
-        }
-        pmix_pointer_array_set_item(&prte_pmix_server_globals.remote_reqs, req->local_index, NULL);
-        PMIX_RELEASE(req);
+        dmdx_drop(req);
         return;
     }
     return;
 }
 
-static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
-                                  pmix_data_buffer_t *buffer,
-                                  prte_rml_tag_t tg, void *cbdata)
+/* NOTE: this function must be called from within an event! */
+void prte_pmix_server_dmdx_job_ready(const pmix_nspace_t nspace)
+{
+    int n;
+    pmix_server_req_t *req;
+
+    /* wake up the requests that were waiting for this job to
+     * be registered - anything in progress or already waiting
+     * on a key is left alone */
+    for (n = 0; n < prte_pmix_server_globals.remote_reqs.size; n++) {
+        req = (pmix_server_req_t*)pmix_pointer_array_get_item(&prte_pmix_server_globals.remote_reqs, n);
+        if (NULL == req || req->inprogress || req->cycle_active || 0 < req->ncycles ||
+            !PMIX_CHECK_NSPACE(req->tproc.nspace, nspace)) {
+            continue;
+        }
+        pmix_output_verbose(2, prte_pmix_server_globals.output,
+                            "%s dmdx:job %s registered - checking request for rank %u",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), nspace, req->tproc.rank);
+        prte_event_evtimer_set(prte_event_base, &req->cycle, dmdx_check, req);
+        req->cycle_active = true;
+        PMIX_POST_OBJECT(req);
+        prte_event_active(&req->cycle, PRTE_EV_TIMEOUT, 1);
+    }
+}
+
+/* process one request from a batch - returns an error only if
+ * the request could not be unpacked */
+static pmix_status_t dmdx_recv_one(pmix_proc_t *sender, pmix_data_buffer_t *buffer)
 {
-    int rc, index;
+    int index;
     int32_t cnt, timeout = 0;
     struct timeval tv = {0, 0};
     prte_job_t *jdata;
@@ -1225,12 +1467,13 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
     size_t sz, n, refreshidx;
     bool refresh_cache = false;
     pmix_value_t *pval = NULL;
-    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
 
     cnt = 1;
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC))) {
-        PMIX_ERROR_LOG(prc);
-        return;
+        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != prc) {
+            PMIX_ERROR_LOG(prc);
+        }
+        return prc;
     }
     pmix_output_verbose(2, prte_pmix_server_globals.output,
                         "%s dmdx:recv processing request from proc %s for proc %s:%u",
@@ -1240,19 +1483,20 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
     cnt = 1;
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &index, &cnt, PMIX_INT))) {
         PMIX_ERROR_LOG(prc);
-        return;
+        return prc;
     }
     cnt = 1;
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &ninfo, &cnt, PMIX_SIZE))) {
         PMIX_ERROR_LOG(prc);
-        return;
+        return prc;
     }
     if (0 < ninfo) {
         PMIX_INFO_CREATE(info, ninfo);
         cnt = ninfo;
         if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, info, &cnt, PMIX_INFO))) {
             PMIX_ERROR_LOG(prc);
-            return;
+            PMIX_INFO_FREE(info, ninfo);
+            return prc;
         }
     }
 
@@ -1271,7 +1515,7 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
                     if (NULL != info) {
                         PMIX_INFO_FREE(info, ninfo);
                     }
-                    return;
+                    return PMIX_SUCCESS;
                 }
                 continue;
             }
@@ -1331,13 +1575,8 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
         /* store it in my remote reqs, assigning the index in that array
          * to the req->local_index as this is MY index to the request */
         req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.remote_reqs, req);
-
-        /* setup the cycle timer so we periodically wake up and try again */
-        prte_event_evtimer_set(prte_event_base, &req->cycle, dmdx_check, req);
-        req->cycle_active = true;
+        /* we will be woken up once the job has been registered */
         PMIX_POST_OBJECT(req);
-        tv.tv_sec = 2;
-        prte_event_evtimer_add(&req->cycle, &tv);
 
         /* if they asked for a timeout, then set that too */
         if (0 < timeout) {
@@ -1345,9 +1584,9 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
             req->event_active = true;
             PMIX_POST_OBJECT(req);
             tv.tv_sec = timeout;
-            prte_event_evtimer_add(&req->cycle, &tv);
+            prte_event_evtimer_add(&req->ev, &tv);
         }
-        return;
+        return PMIX_SUCCESS;
     }
 
     /* we know about this job - look for the proc */
@@ -1355,12 +1594,12 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
     if (NULL == proc) {
         /* this is truly an error, so notify the sender */
         send_error(PRTE_ERR_NOT_FOUND, &pproc, sender, index);
-        return;
+        return PMIX_SUCCESS;
     }
     if (!PRTE_FLAG_TEST(proc, PRTE_PROC_FLAG_LOCAL)) {
         /* send back an error - they obviously have made a mistake */
         send_error(PRTE_ERR_NOT_FOUND, &pproc, sender, index);
-        return;
+        return PMIX_SUCCESS;
     }
 
     if (NULL != key) {
@@ -1386,13 +1625,6 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
              * to the req->local_index as this is MY index to the request */
             req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.remote_reqs, req);
 
-            /* setup the cycle timer so we periodically wake up and try again */
-            prte_event_evtimer_set(prte_event_base, &req->cycle, dmdx_check, req);
-            req->cycle_active = true;
-            PMIX_POST_OBJECT(req);
-            tv.tv_sec = 2;
-            prte_event_evtimer_add(&req->cycle, &tv);
-
             /* if they asked for a timeout, then set that too */
             if (0 < timeout) {
                 prte_event_evtimer_set(prte_event_base, &req->ev, timeout_cbfunc, req);
@@ -1401,7 +1633,10 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
                 tv.tv_sec = timeout;
                 prte_event_evtimer_add(&req->ev, &tv);
             }
-            return;
+
+            /* have the PMIx server tell us when the client posts */
+            dmdx_await_key(req);
+            return PMIX_SUCCESS;
         }
         /* we do already have it, so go get the payload */
         PMIX_VALUE_RELEASE(pval);
@@ -1451,10 +1686,23 @@ static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
         }
         req->inprogress = false;
         pmix_pointer_array_set_item(&prte_pmix_server_globals.remote_reqs, req->local_index, NULL);
-        send_error(rc, &pproc, sender, index);
-        return;
+        send_error(prte_pmix_convert_status(prc), &pproc, sender, index);
+        return PMIX_SUCCESS;
     }
-    return;
+    return PMIX_SUCCESS;
+}
+
+static void pmix_server_dmdx_recv(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tg, void *cbdata)
+{
+    pmix_status_t prc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    /* the daemon may have sent any number of requests */
+    do {
+        prc = dmdx_recv_one(sender, buffer);
+    } while (PMIX_SUCCESS == prc);
 }
 
 typedef struct {
@@ -1484,9 +1732,9 @@ static void relcbfunc(void *relcbdata)
     PMIX_RELEASE(d);
 }
 
-static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
-                                  pmix_data_buffer_t *buffer,
-                                  prte_rml_tag_t tg, void *cbdata)
+/* process one response from a batch - returns an error only
+ * if the response could not be unpacked */
+static pmix_status_t dmdx_resp_one(pmix_data_buffer_t *buffer)
 {
     int index, n;
     int32_t cnt;
@@ -1495,21 +1743,17 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
     pmix_proc_t pproc;
     size_t psz;
     pmix_status_t prc, pret;
-    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
-
-    pmix_output_verbose(2, prte_pmix_server_globals.output,
-                        "%s dmdx:recv response recvd from proc %s with %d bytes",
-                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender),
-                        (int) buffer->bytes_used);
 
     d = PMIX_NEW(datacaddy_t);
 
     /* unpack the status */
     cnt = 1;
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pret, &cnt, PMIX_STATUS))) {
-        PMIX_ERROR_LOG(prc);
+        if (PMIX_ERR_UNPACK_READ_PAST_END_OF_BUFFER != prc) {
+            PMIX_ERROR_LOG(prc);
+        }
         PMIX_RELEASE(d);
-        return;
+        return prc;
     }
 
     /* unpack the id of the target whose info we just received */
@@ -1517,7 +1761,7 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &pproc, &cnt, PMIX_PROC))) {
         PMIX_ERROR_LOG(prc);
         PMIX_RELEASE(d);
-        return;
+        return prc;
     }
 
     /* unpack our tracking index */
@@ -1525,16 +1769,16 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
     if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &index, &cnt, PMIX_INT))) {
         PMIX_ERROR_LOG(prc);
         PMIX_RELEASE(d);
-        return;
+        return prc;
     }
 
-    /* unload the remainder of the buffer */
+    /* unpack any returned data */
     if (PMIX_SUCCESS == pret) {
         cnt = 1;
         if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, &psz, &cnt, PMIX_SIZE))) {
             PMIX_ERROR_LOG(prc);
             PMIX_RELEASE(d);
-            return;
+            return prc;
         }
         if (0 < psz) {
             d->ndata = psz;
@@ -1546,7 +1790,7 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
             if (PMIX_SUCCESS != (prc = PMIx_Data_unpack(NULL, buffer, d->data, &cnt, PMIX_BYTE))) {
                 PMIX_ERROR_LOG(prc);
                 PMIX_RELEASE(d);
-                return;
+                return prc;
             }
         }
     }
@@ -1583,6 +1827,25 @@ static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
         }
     }
     PMIX_RELEASE(d); // maintain accounting
+    return PMIX_SUCCESS;
+}
+
+static void pmix_server_dmdx_resp(int status, pmix_proc_t *sender,
+                                  pmix_data_buffer_t *buffer,
+                                  prte_rml_tag_t tg, void *cbdata)
+{
+    pmix_status_t prc;
+    PRTE_HIDE_UNUSED_PARAMS(status, tg, cbdata);
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s dmdx:recv response recvd from proc %s with %d bytes",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(sender),
+                        (int) buffer->bytes_used);
+
+    /* the daemon may have sent any number of responses */
+    do {
+        prc = dmdx_resp_one(buffer);
+    } while (PMIX_SUCCESS == prc);
 }
 
 
@@ -1942,6 +2205,12 @@ static void rqcon(pmix_server_req_t *p)
     p->jdata = NULL;
     PMIX_DATA_BUFFER_CONSTRUCT(&p->msg);
     p->timeout = prte_pmix_server_globals.timeout;
+    p->ncycles = 0;
+    p->parent = NULL;
+    p->nshards = 0;
+    p->waiting = false;
+    p->keys = NULL;
+    p->need = 0;
     p->opcbfunc = NULL;
     p->mdxcbfunc = NULL;
     p->spcbfunc = NULL;
@@ -1965,6 +2234,12 @@ static void rqdes(pmix_server_req_t *p)
     if (NULL != p->jdata) {
         PMIX_RELEASE(p->jdata);
     }
+    if (NULL != p->parent) {
+        PMIX_RELEASE(p->parent);
+    }
+    if (NULL != p->keys) {
+        PMIX_ARGV_FREE_COMPAT(p->keys);
+    }
     PMIX_DATA_BUFFER_DESTRUCT(&p->msg);
 }
 PMIX_CLASS_INSTANCE(pmix_server_req_t,
@@ -1980,6 +2255,7 @@ static void mdcon(prte_pmix_mdx_caddy_t *p)
     p->nprocs = 0;
     p->info = NULL;
     p->ninfo = 0;
+    p->symmetric = false;
     p->cbdata = NULL;
     p->grpcbfunc = NULL;
     p->mdxcbfunc = NULL;
@@ -2022,3 +2298,18 @@ PMIX_CLASS_INSTANCE(pmix_server_pset_t,
 PMIX_CLASS_INSTANCE(prte_pmix_tool_t,
                     pmix_list_item_t,
                     NULL, NULL);
+
+static void dbcon(pmix_server_dmdx_batch_t *p)
+{
+    p->target = PMIX_RANK_INVALID;
+    p->tag = PRTE_RML_TAG_INVALID;
+    p->nmsgs = 0;
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->msgs);
+}
+static void dbdes(pmix_server_dmdx_batch_t *p)
+{
+    PMIX_DATA_BUFFER_DESTRUCT(&p->msgs);
+}
+PMIX_CLASS_INSTANCE(pmix_server_dmdx_batch_t,
+                    pmix_list_item_t,
+                    dbcon, dbdes);
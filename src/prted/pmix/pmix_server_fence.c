@@ -99,6 +99,9 @@ pmix_status_t pmix_server_fencenb_fn(const pmix_proc_t procs[], size_t nprocs,
     cd->cbdata = cbdata;
     cd->grpcbfunc = pmix_server_release;
     cd->buf = PMIx_Data_buffer_create();
+    /* a fence only exchanges data, so any participant
+     * can assemble the result */
+    cd->symmetric = true;
 
     /* compute the signature of this collective */
     if (NULL != procs) {
@@ -199,14 +202,16 @@ static void dmodex_req(int sd, short args, void *cbdata)
         }
     }
 
-    /* has anyone already requested data for this target? If so,
-     * then the data is already on its way */
+    /* has anyone already requested the same data for this target? If
+     * so, then the data is already on its way */
     for (rnum = 0; rnum < prte_pmix_server_globals.local_reqs.size; rnum++) {
         r = (pmix_server_req_t*)pmix_pointer_array_get_item(&prte_pmix_server_globals.local_reqs, rnum);
         if (NULL == r) {
             continue;
         }
-        if (PMIX_CHECK_PROCID(&r->target, &req->tproc)) {
+        if (PMIX_CHECK_PROCID(&r->tproc, &req->tproc) &&
+            (r->key == req->key || (NULL != r->key && NULL != req->key &&
+                                    0 == strcmp(r->key, req->key)))) {
             /* save the request in the array until the
              * data is returned */
             req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
@@ -305,12 +310,13 @@ static void dmodex_req(int sd, short args, void *cbdata)
         }
     }
 
-    /* send it to the host daemon */
-    PRTE_RML_SEND(rc, dmn->name.rank, buf, PRTE_RML_TAG_DIRECT_MODEX);
+    /* send it to the host daemon along with any other
+     * requests for it that arrive during this pass */
+    rc = pmix_server_dmdx_queue(dmn->name.rank, PRTE_RML_TAG_DIRECT_MODEX, buf);
+    PMIX_DATA_BUFFER_RELEASE(buf);
     if (PRTE_SUCCESS != rc) {
         PRTE_ERROR_LOG(rc);
         pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, req->local_index, NULL);
-        PMIX_DATA_BUFFER_RELEASE(buf);
         prc = prte_pmix_convert_rc(rc);
         goto callback;
     }
@@ -40,6 +40,7 @@
 #endif
 #include <pmix_server.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_hotel.h"
 #include "src/event/event-internal.h"
 #include "src/mca/base/pmix_base.h"
@@ -56,7 +57,7 @@ BEGIN_C_DECLS
 
 /* object for tracking requests so we can
  * correctly route the eventual reply */
-typedef struct {
+typedef struct pmix_server_req_s {
     pmix_object_t super;
     prte_event_t ev;
     bool event_active;
@@ -70,6 +71,7 @@ typedef struct {
     int status;
     pmix_status_t pstatus;
     int timeout;
+    int ncycles;
     int local_index;
     int remote_index;
     bool flag;
@@ -96,6 +98,12 @@ typedef struct {
     pmix_tool_connection_cbfunc_t toolcbfunc;
     pmix_info_cbfunc_t infocbfunc;
     void *cbdata;
+    /* requests split across the daemons of a distributed data server */
+    struct pmix_server_req_s *parent;
+    int nshards;
+    bool waiting;
+    char **keys;
+    size_t need;
 } pmix_server_req_t;
 PMIX_CLASS_DECLARATION(pmix_server_req_t);
 
@@ -138,6 +146,17 @@ typedef struct {
 } prte_pmix_tool_t;
 PMIX_CLASS_DECLARATION(prte_pmix_tool_t);
 
+/* direct modex messages headed for the same daemon
+ * are collected here and sent together */
+typedef struct {
+    pmix_list_item_t super;
+    pmix_rank_t target;
+    prte_rml_tag_t tag;
+    int nmsgs;
+    pmix_data_buffer_t msgs;
+} pmix_server_dmdx_batch_t;
+PMIX_CLASS_DECLARATION(pmix_server_dmdx_batch_t);
+
 #define PRTE_IO_OP(t, nt, b, fn, cfn, cbd)                                         \
     do {                                                                           \
         prte_pmix_server_op_caddy_t *_cd;                                          \
@@ -319,6 +338,9 @@ PRTE_EXPORT extern int prte_pmix_server_register_tool(pmix_nspace_t nspace);
 
 PRTE_EXPORT extern int pmix_server_cache_job_info(prte_job_t *jdata, pmix_info_t *info);
 
+PRTE_EXPORT extern int pmix_server_dmdx_queue(pmix_rank_t target, prte_rml_tag_t tag,
+                                              pmix_data_buffer_t *msg);
+
 #if PMIX_NUMERIC_VERSION >= 0x00050000
 PRTE_EXPORT extern pmix_status_t
 pmix_server_session_ctrl_fn(const pmix_proc_t *requestor,
@@ -359,6 +381,10 @@ typedef struct {
     pmix_list_t tools;
     pmix_list_t psets;
     pmix_list_t groups;
+    pmix_list_t dmdx_batches;
+    pmix_hash_table_t dmdx_batch_index;
+    prte_event_t dmdx_flush;
+    bool dmdx_flush_active;
 } pmix_server_globals_t;
 
 extern pmix_server_globals_t prte_pmix_server_globals;
@@ -33,6 +33,7 @@
 #    include <unistd.h>
 #endif
 
+#include "src/include/hash_string.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/util/pmix_argv.h"
 #include "src/util/pmix_output.h"
@@ -136,6 +137,688 @@ static int init_server(void)
     return PRTE_SUCCESS;
 }
 
+/* when the data server is distributed, each key is placed by
+ * rendezvous hashing: every live daemon is given a score for
+ * the key, and the key is held by the highest scoring daemon
+ * plus the next nreplicas. Adding daemons to the DVM only moves
+ * the keys that a new daemon now outscores, and daemons known
+ * to have failed are never scored */
+static uint32_t shard_score(uint32_t hash, pmix_rank_t vpid)
+{
+    uint32_t h = hash ^ ((uint32_t) vpid * 0x9e3779b9U);
+
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+static bool outscores(uint32_t hash, pmix_rank_t a, pmix_rank_t b)
+{
+    uint32_t sa = shard_score(hash, a);
+    uint32_t sb = shard_score(hash, b);
+
+    return (sa > sb || (sa == sb && a < b));
+}
+
+/* the daemons holding a key. With history set, return every
+ * daemon that was among the top nreplicas+1 at the time it
+ * joined the DVM instead - the DVM only grows by adding vpids,
+ * so this includes wherever the key was placed by a daemon with
+ * an older (smaller) view of the DVM. There are only about
+ * ln(num_procs) such daemons per copy. The "top" array must
+ * hold nreplicas+1 entries */
+static int shard_targets(prte_job_t *daemons, uint32_t hash, int nreplicas,
+                         bool history, pmix_rank_t *top, pmix_rank_t *targets)
+{
+    prte_proc_t *dmn;
+    pmix_rank_t vpid;
+    int k, ntop = 0, ntgt = 0;
+
+    for (vpid = 0; vpid < daemons->num_procs; vpid++) {
+        dmn = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, vpid);
+        if (NULL == dmn || PRTE_PROC_STATE_UNTERMINATED < dmn->state) {
+            continue;
+        }
+        k = ntop;
+        while (0 < k && outscores(hash, vpid, top[k - 1])) {
+            --k;
+        }
+        if (nreplicas < k) {
+            continue;
+        }
+        if (history) {
+            targets[ntgt++] = vpid;
+        }
+        if (ntop <= nreplicas) {
+            ++ntop;
+        }
+        memmove(&top[k + 1], &top[k], (ntop - 1 - k) * sizeof(pmix_rank_t));
+        top[k] = vpid;
+    }
+    if (!history) {
+        memcpy(targets, top, ntop * sizeof(pmix_rank_t));
+        ntgt = ntop;
+    }
+    return ntgt;
+}
+
+static bool is_directive(const char *key)
+{
+    return (0 == strcmp(key, PMIX_RANGE) ||
+            0 == strcmp(key, PMIX_PERSISTENCE) ||
+            0 == strcmp(key, PMIX_USERID));
+}
+
+static pmix_server_req_t *get_shard(pmix_server_req_t *req, pmix_server_req_t **shards,
+                                    pmix_rank_t vpid, int timeout)
+{
+    pmix_server_req_t *child;
+
+    if (NULL == shards[vpid]) {
+        child = PMIX_NEW(pmix_server_req_t);
+        pmix_asprintf(&child->operation, "%s SHARD %s", req->operation,
+                      PRTE_VPID_PRINT(vpid));
+        PMIX_LOAD_PROCID(&child->target, PRTE_PROC_MY_NAME->nspace, vpid);
+        child->range = req->range;
+        child->timeout = timeout;
+        PMIX_RETAIN(req);
+        child->parent = req;
+        shards[vpid] = child;
+    }
+    return shards[vpid];
+}
+
+static void shard_timeout(int sd, short args, void *cbdata);
+
+/* send a shard to its daemon - the shard holds the keys (or
+ * infos) it is responsible for. Any PMIX_WAIT in a lookup's
+ * directives is replaced by one asking for "wait" of the
+ * shard's keys, or dropped if "wait" is zero */
+static pmix_status_t send_shard(pmix_server_req_t *child, uint8_t cmd, pmix_proc_t *proc,
+                                pmix_info_t *info, size_t ninfo, size_t wait)
+{
+    pmix_data_buffer_t *xfer;
+    pmix_info_t *sinfo = NULL;
+    size_t n, m, cnt;
+    int32_t k;
+    pmix_status_t rc;
+    struct timeval tv;
+    int ret, iwait;
+
+    child->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, child);
+
+    PMIX_DATA_BUFFER_CREATE(xfer);
+    rc = PMIx_Data_pack(NULL, xfer, &child->local_index, 1, PMIX_INT);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, xfer, &cmd, 1, PMIX_UINT8);
+    }
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(NULL, xfer, proc, 1, PMIX_PROC);
+    }
+    /* the data server unpacks the infos as a single array, so
+     * they must be packed that way */
+    if (PRTE_PMIX_PUBLISH_CMD == cmd) {
+        /* every shard needs the directives along with its data */
+        cnt = child->sz;
+        for (n = 0; n < ninfo; n++) {
+            if (is_directive(info[n].key)) {
+                ++cnt;
+            }
+        }
+        PMIX_INFO_CREATE(sinfo, cnt);
+        m = 0;
+        for (n = 0; n < ninfo; n++) {
+            if (is_directive(info[n].key)) {
+                PMIX_INFO_XFER(&sinfo[m], &info[n]);
+                ++m;
+            }
+        }
+        for (n = 0; PMIX_SUCCESS == rc && n < child->sz; n++) {
+            k = 1;
+            rc = PMIx_Data_unpack(NULL, &child->msg, &sinfo[m], &k, PMIX_INFO);
+            ++m;
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, xfer, &cnt, 1, PMIX_SIZE);
+        }
+    } else {
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, xfer, &child->sz, 1, PMIX_SIZE);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_copy_payload(xfer, &child->msg);
+        }
+        cnt = (0 < wait) ? 1 : 0;
+        for (n = 0; n < ninfo; n++) {
+            if (!PMIX_CHECK_KEY(&info[n], PMIX_WAIT)) {
+                ++cnt;
+            }
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, xfer, &cnt, 1, PMIX_SIZE);
+        }
+        if (0 < cnt) {
+            PMIX_INFO_CREATE(sinfo, cnt);
+        }
+        m = 0;
+        for (n = 0; n < ninfo; n++) {
+            if (!PMIX_CHECK_KEY(&info[n], PMIX_WAIT)) {
+                PMIX_INFO_XFER(&sinfo[m], &info[n]);
+                ++m;
+            }
+        }
+        if (0 < wait) {
+            iwait = (int) wait;
+            PMIX_INFO_LOAD(&sinfo[m], PMIX_WAIT, &iwait, PMIX_INT);
+        }
+    }
+    if (PMIX_SUCCESS == rc && 0 < cnt) {
+        rc = PMIx_Data_pack(NULL, xfer, sinfo, cnt, PMIX_INFO);
+    }
+    if (NULL != sinfo) {
+        PMIX_INFO_FREE(sinfo, cnt);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(xfer);
+        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, child->local_index, NULL);
+        return rc;
+    }
+
+    pmix_output_verbose(1, prte_pmix_server_globals.output,
+                        "%s orted:pmix:server sending %d keys to data server shard %s",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (int) child->sz,
+                        PRTE_VPID_PRINT(child->target.rank));
+
+    PRTE_RML_SEND(ret, child->target.rank, xfer, PRTE_RML_TAG_DATA_SERVER);
+    if (PRTE_SUCCESS != ret) {
+        PRTE_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_RELEASE(xfer);
+        pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, child->local_index, NULL);
+        return prte_pmix_convert_rc(ret);
+    }
+
+    /* don't let a lost daemon hang the request */
+    if (0 < child->timeout) {
+        prte_event_evtimer_set(prte_event_base, &child->ev, shard_timeout, child);
+        child->event_active = true;
+        PMIX_POST_OBJECT(child);
+        tv.tv_sec = child->timeout;
+        tv.tv_usec = 0;
+        prte_event_evtimer_add(&child->ev, &tv);
+    }
+    return PMIX_SUCCESS;
+}
+
+/* take a key off the list of those a lookup is still missing */
+static bool found_key(pmix_server_req_t *req, const char *key)
+{
+    size_t k, cnt;
+
+    if (NULL == req->keys) {
+        return false;
+    }
+    cnt = PMIX_ARGV_COUNT_COMPAT(req->keys);
+    for (k = 0; k < cnt; k++) {
+        if (0 == strncmp(req->keys[k], key, PMIX_MAX_KEYLEN)) {
+            free(req->keys[k]);
+            memmove(&req->keys[k], &req->keys[k + 1], (cnt - k) * sizeof(char *));
+            return true;
+        }
+    }
+    return false;
+}
+
+/* run the original request's callback with everything the
+ * shards returned. A key can come back from more than one daemon
+ * if it was published while the DVM was growing - keep the copy
+ * from the daemon that ranks highest for it */
+static void shard_complete(pmix_server_req_t *req)
+{
+    pmix_pdata_t *answers = NULL;
+    pmix_rank_t *src = NULL;
+    pmix_status_t status, rc;
+    size_t n, m, nanswers = 0;
+    uint32_t hash;
+    int32_t cnt;
+
+    status = req->pstatus;
+    if (NULL != req->lkcbfunc && 0 < req->sz) {
+        PMIX_PDATA_CREATE(answers, req->sz);
+        src = (pmix_rank_t *) malloc(req->sz * sizeof(pmix_rank_t));
+        for (n = 0; n < req->sz; n++) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &req->msg, &src[nanswers], &cnt, PMIX_PROC_RANK);
+            if (PMIX_SUCCESS == rc) {
+                cnt = 1;
+                rc = PMIx_Data_unpack(NULL, &req->msg, &answers[nanswers], &cnt, PMIX_PDATA);
+            }
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                status = rc;
+                break;
+            }
+            for (m = 0; m < nanswers; m++) {
+                if (PMIX_CHECK_KEY(&answers[m], answers[nanswers].key)) {
+                    break;
+                }
+            }
+            if (m == nanswers) {
+                ++nanswers;
+                continue;
+            }
+            PRTE_HASH_STR(answers[m].key, hash);
+            if (outscores(hash, src[nanswers], src[m])) {
+                PMIX_PDATA_DESTRUCT(&answers[m]);
+                memcpy(&answers[m], &answers[nanswers], sizeof(pmix_pdata_t));
+                src[m] = src[nanswers];
+            } else {
+                PMIX_PDATA_DESTRUCT(&answers[nanswers]);
+            }
+            PMIX_PDATA_CONSTRUCT(&answers[nanswers]);
+        }
+    }
+    if (NULL != req->lkcbfunc && PMIX_SUCCESS == status) {
+        if (0 == nanswers) {
+            status = PMIX_ERR_NOT_FOUND;
+        } else if (NULL != req->keys && NULL != req->keys[0]) {
+            status = PMIX_QUERY_PARTIAL_SUCCESS;
+        }
+    } else if (NULL != req->lkcbfunc && 0 < nanswers) {
+        /* some of the shards failed, but we have data */
+        status = PMIX_QUERY_PARTIAL_SUCCESS;
+    }
+
+    if (NULL != req->opcbfunc) {
+        req->opcbfunc(status, req->cbdata);
+    } else if (NULL != req->lkcbfunc) {
+        if (0 < nanswers) {
+            req->lkcbfunc(status, answers, nanswers, req->cbdata);
+        } else {
+            req->lkcbfunc(status, NULL, 0, req->cbdata);
+        }
+    }
+    /* any shard still out will be ignored when it answers */
+    req->opcbfunc = NULL;
+    req->lkcbfunc = NULL;
+    if (NULL != answers) {
+        PMIX_PDATA_FREE(answers, req->sz);
+    }
+    if (NULL != src) {
+        free(src);
+    }
+    if (NULL != req->info) {
+        PMIX_INFO_FREE(req->info, req->ninfo);
+        req->ninfo = 0;
+    }
+    /* release the reference held while the shards were out */
+    PMIX_RELEASE(req);
+}
+
+static void shard_done(pmix_server_req_t *child, pmix_status_t status,
+                       pmix_pdata_t *pdata, size_t npdata);
+
+/* a lookup that asked to wait is first answered from whatever
+ * the daemons already hold. The keys that are still missing are
+ * then sent to the daemon that currently owns each of them, and
+ * that daemon holds its part of the request until enough of them
+ * are published - but never for more keys than the lookup still
+ * needs */
+static pmix_status_t scatter_wait(pmix_server_req_t *req)
+{
+    prte_job_t *daemons;
+    pmix_server_req_t **shards, *child;
+    pmix_rank_t owner, top;
+    uint32_t hash;
+    size_t k;
+    int nshards = 0;
+    pmix_status_t rc;
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    if (NULL == daemons || 0 == daemons->num_procs) {
+        return PMIX_ERR_UNREACH;
+    }
+    shards = (pmix_server_req_t **) calloc(daemons->num_procs, sizeof(pmix_server_req_t *));
+    if (NULL == shards) {
+        return PMIX_ERR_NOMEM;
+    }
+    for (k = 0; NULL != req->keys && NULL != req->keys[k]; k++) {
+        PRTE_HASH_STR(req->keys[k], hash);
+        if (0 == shard_targets(daemons, hash, 0, false, &top, &owner)) {
+            continue;
+        }
+        child = get_shard(req, shards, owner, req->timeout);
+        rc = PMIx_Data_pack(NULL, &child->msg, &req->keys[k], 1, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        if (1 == ++child->sz) {
+            ++nshards;
+        }
+    }
+    if (0 == nshards) {
+        rc = PMIX_ERR_NOT_FOUND;
+        goto cleanup;
+    }
+
+    req->waiting = true;
+    req->nshards = nshards;
+    for (owner = 0; owner < daemons->num_procs; owner++) {
+        if (NULL == (child = shards[owner])) {
+            continue;
+        }
+        shards[owner] = NULL;
+        rc = send_shard(child, PRTE_PMIX_LOOKUP_CMD, &req->tproc, req->info, req->ninfo,
+                        (req->need < child->sz) ? req->need : child->sz);
+        if (PMIX_SUCCESS != rc) {
+            shard_done(child, rc, NULL, 0);
+            PMIX_RELEASE(child);
+        }
+    }
+    rc = PMIX_SUCCESS;
+
+cleanup:
+    for (owner = 0; owner < daemons->num_procs; owner++) {
+        if (NULL != shards[owner]) {
+            PMIX_RELEASE(shards[owner]);
+        }
+    }
+    free(shards);
+    return rc;
+}
+
+/* record the reply from one shard, completing the original
+ * request once all of its shards have answered - or, for a
+ * lookup waiting on its keys, once it has as many as it needs */
+static void shard_done(pmix_server_req_t *child, pmix_status_t status,
+                       pmix_pdata_t *pdata, size_t npdata)
+{
+    pmix_server_req_t *req = child->parent;
+    size_t n;
+    pmix_status_t rc;
+
+    if (child->event_active) {
+        prte_event_del(&child->ev);
+        child->event_active = false;
+    }
+    --req->nshards;
+    if (NULL == req->opcbfunc && NULL == req->lkcbfunc) {
+        /* the request has already been answered */
+        return;
+    }
+
+    /* not every daemon asked about a key will hold it */
+    if (PMIX_ERR_NOT_FOUND != status && PMIX_QUERY_PARTIAL_SUCCESS != status &&
+        PMIX_SUCCESS != status && PMIX_SUCCESS == req->pstatus) {
+        req->pstatus = status;
+    }
+    /* the parent's msg buffer collects the returned data
+     * along with the daemon that returned it */
+    for (n = 0; NULL != req->lkcbfunc && n < npdata; n++) {
+        rc = PMIx_Data_pack(NULL, &req->msg, &child->target.rank, 1, PMIX_PROC_RANK);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, &req->msg, &pdata[n], 1, PMIX_PDATA);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            req->pstatus = rc;
+            break;
+        }
+        ++req->sz;
+        if (found_key(req, pdata[n].key) && 0 < req->need) {
+            --req->need;
+        }
+    }
+
+    if (0 < req->nshards && !(req->waiting && 0 == req->need)) {
+        return;
+    }
+    if (0 == req->nshards && !req->waiting && 0 < req->need &&
+        PMIX_SUCCESS == req->pstatus) {
+        /* a lookup that asked to wait for its missing keys */
+        if (PMIX_SUCCESS == scatter_wait(req)) {
+            return;
+        }
+    }
+    shard_complete(req);
+}
+
+/* a shard that doesn't answer in time counts as failed */
+static void shard_timeout(int sd, short args, void *cbdata)
+{
+    pmix_server_req_t *child = (pmix_server_req_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(sd, args);
+
+    PMIX_ACQUIRE_OBJECT(child);
+    child->event_active = false;
+    child->timed_out = true;
+
+    pmix_output_verbose(2, prte_pmix_server_globals.output,
+                        "%s orted:pmix:server data server shard %s timed out",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        PRTE_VPID_PRINT(child->target.rank));
+
+    /* a late reply will no longer find the shard */
+    pmix_pointer_array_set_item(&prte_pmix_server_globals.local_reqs, child->local_index, NULL);
+    shard_done(child, PMIX_ERR_TIMEOUT, NULL, 0);
+    PMIX_RELEASE(child);
+}
+
+/* split a request across the daemons holding its keys. Publishes
+ * go to the daemons that currently own each key - including the
+ * replicas for data that must outlive the publisher. Lookups and
+ * unpublishes go to every daemon that could have owned the key
+ * while the DVM was smaller, so data placed before the DVM grew
+ * is still found and removed */
+static pmix_status_t scatter(pmix_server_req_t *req)
+{
+    prte_job_t *daemons;
+    pmix_server_req_t **shards = NULL, *child;
+    pmix_rank_t *targets = NULL, *top = NULL, vpid;
+    pmix_proc_t proc;
+    pmix_info_t *info = NULL, *sinfo;
+    char *key, **keys = NULL;
+    size_t n, ninfo = 0, nsinfo, nkeys = 0, need = 0;
+    uint8_t cmd;
+    uint32_t hash;
+    int32_t cnt;
+    int nrep, ntgt, k, nshards, timeout;
+    bool wait = false;
+    pmix_status_t rc;
+
+    daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    if (NULL == daemons || 0 == daemons->num_procs) {
+        return PMIX_ERR_UNREACH;
+    }
+
+    /* unpack what we need from the original message */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, &req->msg, &cmd, &cnt, PMIX_UINT8);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &req->msg, &proc, &cnt, PMIX_PROC);
+    }
+    if (PMIX_SUCCESS == rc && PRTE_PMIX_PUBLISH_CMD != cmd) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &req->msg, &nkeys, &cnt, PMIX_SIZE);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    shards = (pmix_server_req_t **) calloc(daemons->num_procs, sizeof(pmix_server_req_t *));
+    nrep = (PRTE_PMIX_LOOKUP_CMD == cmd) ? 0 : prte_data_server_replicas;
+    targets = (pmix_rank_t *) malloc(daemons->num_procs * sizeof(pmix_rank_t));
+    top = (pmix_rank_t *) malloc((nrep + 1) * sizeof(pmix_rank_t));
+    if (NULL == shards || NULL == targets || NULL == top) {
+        rc = PMIX_ERR_NOMEM;
+        goto cleanup;
+    }
+    /* a daemon that was lost must not hang the request */
+    timeout = (0 < req->timeout) ? req->timeout : prte_data_server_shard_timeout;
+
+    if (PRTE_PMIX_PUBLISH_CMD == cmd) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &req->msg, &ninfo, &cnt, PMIX_SIZE);
+        if (PMIX_SUCCESS == rc && 0 < ninfo) {
+            PMIX_INFO_CREATE(info, ninfo);
+            cnt = ninfo;
+            rc = PMIx_Data_unpack(NULL, &req->msg, info, &cnt, PMIX_INFO);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        /* data that dies with its publisher isn't worth copying */
+        for (n = 0; n < ninfo; n++) {
+            if (0 == strcmp(info[n].key, PMIX_PERSISTENCE) &&
+                (PMIX_PERSIST_PROC == info[n].value.data.persist ||
+                 PMIX_PERSIST_FIRST_READ == info[n].value.data.persist)) {
+                nrep = 0;
+            }
+        }
+        for (n = 0; n < ninfo; n++) {
+            if (is_directive(info[n].key)) {
+                continue;
+            }
+            PRTE_HASH_STR(info[n].key, hash);
+            ntgt = shard_targets(daemons, hash, nrep, false, top, targets);
+            for (k = 0; k < ntgt; k++) {
+                child = get_shard(req, shards, targets[k], timeout);
+                rc = PMIx_Data_pack(NULL, &child->msg, &info[n], 1, PMIX_INFO);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    goto cleanup;
+                }
+                ++child->sz;
+            }
+        }
+    } else {
+        for (n = 0; n < nkeys; n++) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, &req->msg, &key, &cnt, PMIX_STRING);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+                goto cleanup;
+            }
+            PRTE_HASH_STR(key, hash);
+            ntgt = shard_targets(daemons, hash, nrep, true, top, targets);
+            for (k = 0; k < ntgt; k++) {
+                child = get_shard(req, shards, targets[k], timeout);
+                rc = PMIx_Data_pack(NULL, &child->msg, &key, 1, PMIX_STRING);
+                if (PMIX_SUCCESS != rc) {
+                    PMIX_ERROR_LOG(rc);
+                    free(key);
+                    goto cleanup;
+                }
+                ++child->sz;
+            }
+            if (PRTE_PMIX_LOOKUP_CMD == cmd) {
+                PMIX_ARGV_APPEND_NOSIZE_COMPAT(&keys, key);
+            }
+            free(key);
+        }
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, &req->msg, &ninfo, &cnt, PMIX_SIZE);
+        if (PMIX_SUCCESS == rc && 0 < ninfo) {
+            PMIX_INFO_CREATE(info, ninfo);
+            cnt = ninfo;
+            rc = PMIx_Data_unpack(NULL, &req->msg, info, &cnt, PMIX_INFO);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            goto cleanup;
+        }
+        /* the data server treats any PMIX_WAIT as a request to
+         * wait, optionally for a given number of the keys */
+        for (n = 0; PRTE_PMIX_LOOKUP_CMD == cmd && n < ninfo; n++) {
+            if (PMIX_CHECK_KEY(&info[n], PMIX_WAIT)) {
+                wait = true;
+                if (PMIX_INT == info[n].value.type && 0 < info[n].value.data.integer) {
+                    need = info[n].value.data.integer;
+                }
+            }
+        }
+    }
+
+    nshards = 0;
+    for (vpid = 0; vpid < daemons->num_procs; vpid++) {
+        if (NULL != shards[vpid]) {
+            ++nshards;
+        }
+    }
+    if (0 == nshards) {
+        /* nothing to store or no daemon left to hold it */
+        rc = PMIX_ERR_BAD_PARAM;
+        goto cleanup;
+    }
+
+    /* the request now just collects the replies */
+    PMIX_DATA_BUFFER_DESTRUCT(&req->msg);
+    PMIX_DATA_BUFFER_CONSTRUCT(&req->msg);
+    req->sz = 0;
+    req->pstatus = PMIX_SUCCESS;
+    req->nshards = nshards;
+    sinfo = info;
+    nsinfo = ninfo;
+    if (PRTE_PMIX_LOOKUP_CMD == cmd) {
+        /* a lookup that waits counts down the keys it needs, and
+         * keeps what it takes to ask again for the missing ones */
+        req->keys = keys;
+        keys = NULL;
+        if (wait) {
+            req->need = (0 < need && need < nkeys) ? need : nkeys;
+        }
+        req->tproc = proc;
+        req->info = info;
+        req->ninfo = ninfo;
+        info = NULL;
+    }
+    for (vpid = 0; vpid < daemons->num_procs; vpid++) {
+        if (NULL == (child = shards[vpid])) {
+            continue;
+        }
+        shards[vpid] = NULL;
+        /* the tracker array holds the shard until its reply arrives -
+         * nobody waits on the first pass of a lookup */
+        rc = send_shard(child, cmd, &proc, sinfo, nsinfo, 0);
+        if (PMIX_SUCCESS != rc) {
+            /* count it as answered so the request still completes */
+            shard_done(child, rc, NULL, 0);
+            PMIX_RELEASE(child);
+        }
+    }
+    rc = PMIX_SUCCESS;
+
+cleanup:
+    if (NULL != shards) {
+        for (vpid = 0; vpid < daemons->num_procs; vpid++) {
+            if (NULL != shards[vpid]) {
+                PMIX_RELEASE(shards[vpid]);
+            }
+        }
+        free(shards);
+    }
+    if (NULL != targets) {
+        free(targets);
+    }
+    if (NULL != top) {
+        free(top);
+    }
+    if (NULL != keys) {
+        PMIX_ARGV_FREE_COMPAT(keys);
+    }
+    if (NULL != info) {
+        PMIX_INFO_FREE(info, ninfo);
+    }
+    return rc;
+}
+
 static void execute(int sd, short args, void *cbdata)
 {
     pmix_server_req_t *req = (pmix_server_req_t *) cbdata;
@@ -156,6 +839,17 @@ static void execute(int sd, short args, void *cbdata)
         }
     }
 
+    /* a distributed data server holds all but node-local data
+     * on the daemons selected by each key */
+    if (prte_data_server_distributed && NULL == prte_data_server_uri &&
+        PMIX_RANGE_LOCAL != req->range) {
+        rc = scatter(req);
+        if (PMIX_SUCCESS == rc) {
+            return;
+        }
+        goto callback;
+    }
+
     /* add this request to our tracker array */
     req->local_index = pmix_pointer_array_add(&prte_pmix_server_globals.local_reqs, req);
     stored = true;
@@ -571,7 +1265,10 @@ release:
 
     if (NULL != req) {
         /* pass down the response */
-        if (NULL != req->opcbfunc) {
+        if (NULL != req->parent) {
+            /* this was one shard of a distributed request */
+            shard_done(req, ret, pdata, npdata);
+        } else if (NULL != req->opcbfunc) {
             req->opcbfunc(ret, req->cbdata);
         } else if (NULL != req->lkcbfunc) {
             req->lkcbfunc(ret, pdata, npdata, req->cbdata);
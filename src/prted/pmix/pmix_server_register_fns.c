@@ -641,6 +641,10 @@ int prte_pmix_server_register_nspace(prte_job_t *jdata)
         return rc;
     }
 
+    /* let any direct modex requests that arrived ahead of
+     * the job know that we can now serve them */
+    prte_pmix_server_dmdx_job_ready(pproc.nspace);
+
     /* if the user has connected us to an external server, then we must
      * assume there is going to be some cross-mpirun exchange, and so
      * we protect against that situation by publishing the job info
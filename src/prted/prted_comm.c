@@ -501,6 +501,7 @@ void prte_daemon_recv(int status, pmix_proc_t *sender,
         /* cleanup any pending server ops */
         PMIX_LOAD_PROCID(&pname, job, PMIX_RANK_WILDCARD);
         prte_pmix_server_clear(&pname);
+        prte_grpcomm_base_purge_sig_info(job);
 
         PMIX_RELEASE(jdata);
         break;
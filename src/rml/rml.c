@@ -34,12 +34,22 @@
 prte_rml_base_t prte_rml_base = {
     .rml_output = -1,
     .routed_output = -1,
-    .posted_recvs = PMIX_LIST_STATIC_INIT,
-    .unmatched_msgs = PMIX_LIST_STATIC_INIT,
+    .posted_recvs = PMIX_HASH_TABLE_STATIC_INIT,
+    .unmatched_msgs = PMIX_HASH_TABLE_STATIC_INIT,
+    .num_posted_recvs = 0,
+    .num_unmatched_msgs = 0,
+    .max_unmatched_msgs = 0,
     .max_retries = 0,
     .lifeline = PMIX_RANK_INVALID,
     .children = PMIX_LIST_STATIC_INIT,
+    .tree_version = 0,
+    .tree_size = 0,
+    .tree_order = NULL,
+    .tree_index = NULL,
+    .failed = PMIX_HASH_TABLE_STATIC_INIT,
     .radix = 64,
+    .locality = false,
+    .reparent = false,
     .static_ports = false
 };
 
@@ -82,13 +92,55 @@ void prte_rml_register(void)
     pmix_mca_base_var_register_synonym(ret, "prte", "routed", "radix", NULL,
                                        PMIX_MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    pmix_mca_base_var_register("prte", "rml", "base", "locality",
+                               "Lay out the routing tree in hostname order so that each "
+                               "subtree covers a contiguous block of nodes (e.g., a rack) "
+                               "instead of ordering the daemons by rank",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_rml_base.locality);
+
+    pmix_mca_base_var_register("prte", "rml", "base", "reparent",
+                               "Route around a lost daemon by attaching its children to "
+                               "the nearest surviving ancestor instead of aborting. Loss "
+                               "of the HNP remains fatal",
+                               PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                               &prte_rml_base.reparent);
+
+}
+
+static void release_buckets(pmix_hash_table_t *table)
+{
+    uint32_t key;
+    pmix_list_t *bucket;
+
+    for (void *_nptr = NULL;
+         PRTE_SUCCESS
+         == pmix_hash_table_get_next_key_uint32(table, &key, (void **) &bucket, _nptr, &_nptr);) {
+        PMIX_LIST_RELEASE(bucket);
+    }
+    PMIX_DESTRUCT(table);
 }
 
 void prte_rml_close(void)
 {
-    PMIX_LIST_DESTRUCT(&prte_rml_base.posted_recvs);
-    PMIX_LIST_DESTRUCT(&prte_rml_base.unmatched_msgs);
+    pmix_output_verbose(1, prte_rml_base.rml_output,
+                        "%s rml:close posted recvs %lu unmatched msgs %lu (max %lu)",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                        (unsigned long) prte_rml_base.num_posted_recvs,
+                        (unsigned long) prte_rml_base.num_unmatched_msgs,
+                        (unsigned long) prte_rml_base.max_unmatched_msgs);
+    release_buckets(&prte_rml_base.posted_recvs);
+    release_buckets(&prte_rml_base.unmatched_msgs);
     PMIX_LIST_DESTRUCT(&prte_rml_base.children);
+    PMIX_DESTRUCT(&prte_rml_base.failed);
+    if (NULL != prte_rml_base.tree_order) {
+        free(prte_rml_base.tree_order);
+        prte_rml_base.tree_order = NULL;
+    }
+    if (NULL != prte_rml_base.tree_index) {
+        free(prte_rml_base.tree_index);
+        prte_rml_base.tree_index = NULL;
+    }
     if (0 <= prte_rml_base.rml_output) {
         pmix_output_close(prte_rml_base.rml_output);
     }
@@ -97,9 +149,16 @@ void prte_rml_close(void)
 void prte_rml_open(void)
 {
     /* construct object for holding the active plugin modules */
-    PMIX_CONSTRUCT(&prte_rml_base.posted_recvs, pmix_list_t);
-    PMIX_CONSTRUCT(&prte_rml_base.unmatched_msgs, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_rml_base.posted_recvs, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_rml_base.posted_recvs, 128);
+    PMIX_CONSTRUCT(&prte_rml_base.unmatched_msgs, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_rml_base.unmatched_msgs, 128);
+    prte_rml_base.num_posted_recvs = 0;
+    prte_rml_base.num_unmatched_msgs = 0;
+    prte_rml_base.max_unmatched_msgs = 0;
     PMIX_CONSTRUCT(&prte_rml_base.children, pmix_list_t);
+    PMIX_CONSTRUCT(&prte_rml_base.failed, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_rml_base.failed, 32);
     prte_rml_base.lifeline = PRTE_PROC_MY_PARENT->rank;
 
     /* compute the routing tree - only thing we need to know is the
@@ -135,10 +194,18 @@ static void send_cons(prte_rml_send_t *ptr)
     ptr->retries = 0;
     ptr->cbdata = NULL;
     ptr->dbuf = NULL;
+    ptr->owner = NULL;
     ptr->seq_num = 0xFFFFFFFF;
 }
 static void send_des(prte_rml_send_t *ptr)
 {
+    if (NULL != ptr->owner) {
+        /* the storage isn't ours to free */
+        if (NULL != ptr->dbuf) {
+            ptr->dbuf->base_ptr = NULL;
+        }
+        PMIX_RELEASE(ptr->owner);
+    }
     if (ptr->dbuf != NULL)
         PMIX_DATA_BUFFER_RELEASE(ptr->dbuf);
 }
@@ -198,12 +265,7 @@ PMIX_CLASS_INSTANCE(prte_rml_recv_request_t, pmix_object_t, prq_cons, prq_des);
 static void rtcon(prte_routed_tree_t *rt)
 {
     rt->rank = PMIX_RANK_INVALID;
-    PMIX_CONSTRUCT(&rt->relatives, pmix_bitmap_t);
-}
-static void rtdes(prte_routed_tree_t *rt)
-{
-    PMIX_DESTRUCT(&rt->relatives);
 }
 PMIX_CLASS_INSTANCE(prte_routed_tree_t,
                     pmix_list_item_t,
-                    rtcon, rtdes);
+                    rtcon, NULL);
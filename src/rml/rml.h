@@ -84,6 +84,35 @@ PRTE_EXPORT int prte_rml_send_buffer_nb(pmix_rank_t rank,
         (_r) = prte_rml_send_buffer_nb(r, b, t);                \
     } while(0)
 
+/**
+ * Send a buffer whose storage is shared
+ *
+ * Identical to send_buffer_nb except that the caller retains
+ * ownership of the buffer. The storage behind the buffer must
+ * be held by the provided refcounted object - the RML retains
+ * the object until the send completes, so the same buffer can
+ * be sent to any number of peers without being copied. The
+ * buffer must not be modified until all such sends complete.
+ *
+ * @param[in] peer   Name of receiving process
+ * @param[in] buffer Pointer to buffer to be sent
+ * @param[in] owner  Refcounted object holding the buffer's storage
+ * @param[in] tag    User defined tag for matching send/recv
+ */
+PRTE_EXPORT int prte_rml_send_shared_nb(pmix_rank_t rank,
+                                        pmix_data_buffer_t *buffer,
+                                        pmix_object_t *owner,
+                                        prte_rml_tag_t tag);
+
+#define PRTE_RML_SEND_SHARED(_r, r, b, o, t)                    \
+    do {                                                        \
+        pmix_output_verbose(2, prte_rml_base.rml_output,        \
+                            "RML-SEND-SHARED(%s:%d): %s:%s:%d", \
+                            PMIX_RANK_PRINT(r), t,              \
+                            __FILE__, __func__, __LINE__);      \
+        (_r) = prte_rml_send_shared_nb(r, b, o, t);             \
+    } while(0)
+
 /**
  * Purge the RML/OOB of contact info and pending messages
  * to/from a specified process. Used when a process aborts
@@ -146,11 +175,33 @@ typedef struct {
     int rml_output;
     int routed_output;
     int max_retries;
-    pmix_list_t posted_recvs;
-    pmix_list_t unmatched_msgs;
+    /* posted recvs and unmatched msgs are each kept in a
+     * table indexed by tag - each entry is a pmix_list_t
+     * holding the recvs/msgs for that tag in the order
+     * they were posted/received */
+    pmix_hash_table_t posted_recvs;
+    pmix_hash_table_t unmatched_msgs;
+    /* queue depths */
+    size_t num_posted_recvs;
+    size_t num_unmatched_msgs;
+    size_t max_unmatched_msgs;
     pmix_rank_t lifeline;
     pmix_list_t children;
+    /* bumped every time the routing tree is recomputed */
+    uint32_t tree_version;
+    /* number of daemons covered by the routing tree */
+    pmix_rank_t tree_size;
+    /* when the tree is built by locality, the daemons are laid
+     * out in hostname order - tree_order maps a position in the
+     * tree to the daemon's rank, and tree_index does the reverse.
+     * Both are NULL when the tree is in plain rank order */
+    pmix_rank_t *tree_order;
+    pmix_rank_t *tree_index;
+    /* daemons we have lost, indexed by rank */
+    pmix_hash_table_t failed;
     int radix;
+    bool locality;
+    bool reparent;
     bool static_ports;
 } prte_rml_base_t;
 
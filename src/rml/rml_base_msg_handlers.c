@@ -52,10 +52,30 @@
 
 static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all);
 
+/* posted recvs and unmatched messages are held in per-tag
+ * lists so that matching only has to consider the entries
+ * that share the message's tag - typically just one. Order
+ * within a tag is preserved, so matching semantics are
+ * unchanged */
+static pmix_list_t *get_bucket(pmix_hash_table_t *table, prte_rml_tag_t tag, bool create)
+{
+    pmix_list_t *bucket = NULL;
+
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(table, tag, (void **) &bucket)) {
+        return bucket;
+    }
+    if (create) {
+        bucket = PMIX_NEW(pmix_list_t);
+        pmix_hash_table_set_value_uint32(table, tag, bucket);
+    }
+    return bucket;
+}
+
 void prte_rml_base_post_recv(int sd, short args, void *cbdata)
 {
     prte_rml_recv_request_t *req = (prte_rml_recv_request_t *) cbdata;
     prte_rml_posted_recv_t *post, *recv;
+    pmix_list_t *bucket;
     PRTE_HIDE_UNUSED_PARAMS(sd, args);
 
     PMIX_ACQUIRE_OBJECT(req);
@@ -77,15 +97,21 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
      * and remove it from our list
      */
     if (req->cancel) {
-        PMIX_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t)
+        bucket = get_bucket(&prte_rml_base.posted_recvs, post->tag, false);
+        if (NULL == bucket) {
+            PMIX_RELEASE(req);
+            return;
+        }
+        PMIX_LIST_FOREACH(recv, bucket, prte_rml_posted_recv_t)
         {
-            if (PMIX_CHECK_PROCID(&post->peer, &recv->peer) && post->tag == recv->tag) {
+            if (PMIX_CHECK_PROCID(&post->peer, &recv->peer)) {
                 pmix_output_verbose(5, prte_rml_base.rml_output,
                                     "%s canceling recv %d for peer %s",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), post->tag,
                                     PRTE_NAME_PRINT(&recv->peer));
                 /* got a match - remove it */
-                pmix_list_remove_item(&prte_rml_base.posted_recvs, &recv->super);
+                pmix_list_remove_item(bucket, &recv->super);
+                --prte_rml_base.num_posted_recvs;
                 PMIX_RELEASE(recv);
                 break;
             }
@@ -95,9 +121,10 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
     }
 
     /* bozo check - cannot have two receives for the same peer/tag combination */
-    PMIX_LIST_FOREACH(recv, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t)
+    bucket = get_bucket(&prte_rml_base.posted_recvs, post->tag, true);
+    PMIX_LIST_FOREACH(recv, bucket, prte_rml_posted_recv_t)
     {
-        if (PMIX_CHECK_PROCID(&post->peer, &recv->peer) && post->tag == recv->tag) {
+        if (PMIX_CHECK_PROCID(&post->peer, &recv->peer)) {
             pmix_output(0, "%s TWO RECEIVES WITH SAME PEER %s AND TAG %d - ABORTING",
                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&post->peer),
                         post->tag);
@@ -111,7 +138,8 @@ void prte_rml_base_post_recv(int sd, short args, void *cbdata)
                         (post->persistent) ? "persistent" : "non-persistent", post->tag,
                         PRTE_NAME_PRINT(&post->peer));
     /* add it to the list of recvs */
-    pmix_list_append(&prte_rml_base.posted_recvs, &post->super);
+    pmix_list_append(bucket, &post->super);
+    ++prte_rml_base.num_posted_recvs;
     req->post = NULL;
     /* handle any messages that may have already arrived for this recv */
     msg_match_recv(post, post->persistent);
@@ -124,13 +152,19 @@ static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
 {
     pmix_list_item_t *item, *next;
     prte_rml_recv_t *msg;
+    pmix_list_t *bucket;
+
+    bucket = get_bucket(&prte_rml_base.unmatched_msgs, rcv->tag, false);
+    if (NULL == bucket) {
+        return;
+    }
 
     /* scan thru the list of unmatched recvd messages and
      * see if any matches this spec - if so, push the first
      * into the recvd msg queue and look no further
      */
-    item = pmix_list_get_first(&prte_rml_base.unmatched_msgs);
-    while (item != pmix_list_get_end(&prte_rml_base.unmatched_msgs)) {
+    item = pmix_list_get_first(bucket);
+    while (item != pmix_list_get_end(bucket)) {
         next = pmix_list_get_next(item);
         msg = (prte_rml_recv_t *) item;
         pmix_output_verbose(5, prte_rml_base.rml_output,
@@ -141,9 +175,10 @@ static void msg_match_recv(prte_rml_posted_recv_t *rcv, bool get_all)
         /* since names could include wildcards, must use
          * the more generalized comparison function
          */
-        if (PMIX_CHECK_PROCID(&msg->sender, &rcv->peer) && msg->tag == rcv->tag) {
+        if (PMIX_CHECK_PROCID(&msg->sender, &rcv->peer)) {
             PRTE_RML_ACTIVATE_MESSAGE(msg);
-            pmix_list_remove_item(&prte_rml_base.unmatched_msgs, item);
+            pmix_list_remove_item(bucket, item);
+            --prte_rml_base.num_unmatched_msgs;
             if (!get_all) {
                 break;
             }
@@ -156,6 +191,7 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
 {
     prte_rml_recv_t *msg = (prte_rml_recv_t *) cbdata;
     prte_rml_posted_recv_t *post;
+    pmix_list_t *bucket;
     PRTE_HIDE_UNUSED_PARAMS(fd, flags);
 
     PMIX_ACQUIRE_OBJECT(msg);
@@ -191,12 +227,16 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
     }
 
     /* see if we have a waiting recv for this message */
-    PMIX_LIST_FOREACH(post, &prte_rml_base.posted_recvs, prte_rml_posted_recv_t)
-    {
-        /* since names could include wildcards, must use
-         * the more generalized comparison function
-         */
-        if (PMIX_CHECK_PROCID(&msg->sender, &post->peer) && msg->tag == post->tag) {
+    bucket = get_bucket(&prte_rml_base.posted_recvs, msg->tag, false);
+    if (NULL != bucket) {
+        PMIX_LIST_FOREACH(post, bucket, prte_rml_posted_recv_t)
+        {
+            /* since names could include wildcards, must use
+             * the more generalized comparison function
+             */
+            if (!PMIX_CHECK_PROCID(&msg->sender, &post->peer)) {
+                continue;
+            }
             /* deliver the data to this location */
             post->cbfunc(PRTE_SUCCESS, &msg->sender, msg->dbuf, msg->tag, post->cbdata);
             /* the user must have unloaded the buffer if they wanted
@@ -214,7 +254,8 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
                                  PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), post->tag));
             /* if the recv is non-persistent, remove it */
             if (!post->persistent) {
-                pmix_list_remove_item(&prte_rml_base.posted_recvs, &post->super);
+                pmix_list_remove_item(bucket, &post->super);
+                --prte_rml_base.num_posted_recvs;
                 /*PMIX_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
                                      "%s non persistent recv %p remove success releasing now",
                                      PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -231,5 +272,10 @@ void prte_rml_base_process_msg(int fd, short flags, void *cbdata)
         (5, prte_rml_base.rml_output,
          "%s message received bytes from %s for tag %d Not Matched adding to unmatched msgs",
          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), PRTE_NAME_PRINT(&msg->sender), msg->tag));
-    pmix_list_append(&prte_rml_base.unmatched_msgs, &msg->super);
+    bucket = get_bucket(&prte_rml_base.unmatched_msgs, msg->tag, true);
+    pmix_list_append(bucket, &msg->super);
+    ++prte_rml_base.num_unmatched_msgs;
+    if (prte_rml_base.max_unmatched_msgs < prte_rml_base.num_unmatched_msgs) {
+        prte_rml_base.max_unmatched_msgs = prte_rml_base.num_unmatched_msgs;
+    }
 }
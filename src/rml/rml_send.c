@@ -90,3 +90,64 @@ int prte_rml_send_buffer_nb(pmix_rank_t rank,
 
     return PRTE_SUCCESS;
 }
+
+int prte_rml_send_shared_nb(pmix_rank_t rank,
+                            pmix_data_buffer_t *buffer,
+                            pmix_object_t *owner,
+                            prte_rml_tag_t tag)
+{
+    pmix_data_buffer_t *view;
+    prte_rml_send_t *snd;
+    pmix_status_t rc;
+
+    PMIX_OUTPUT_VERBOSE((1, prte_rml_base.rml_output,
+         "%s rml_send_shared to peer %s at tag %d",
+         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+         PMIX_RANK_PRINT(rank), tag));
+
+    if (PRTE_RML_TAG_INVALID == tag) {
+        /* cannot send to an invalid tag */
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return PRTE_ERR_BAD_PARAM;
+    }
+    if (PMIX_RANK_INVALID == rank) {
+        /* cannot send to an invalid peer */
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return PRTE_ERR_BAD_PARAM;
+    }
+
+    if (PRTE_PROC_MY_NAME->rank == rank) {
+        /* the recv side takes ownership of the buffer it is
+         * given, so a message to myself needs its own copy */
+        PMIX_DATA_BUFFER_CREATE(view);
+        rc = PMIx_Data_copy_payload(view, buffer);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_RELEASE(view);
+            return prte_pmix_convert_status(rc);
+        }
+        return prte_rml_send_buffer_nb(rank, view, tag);
+    }
+
+    /* point a new buffer at the shared storage - the
+     * OOB only reads the payload, so this is safe */
+    PMIX_DATA_BUFFER_CREATE(view);
+    view->base_ptr = buffer->base_ptr;
+    view->pack_ptr = buffer->pack_ptr;
+    view->unpack_ptr = buffer->base_ptr;
+    view->bytes_allocated = buffer->bytes_allocated;
+    view->bytes_used = buffer->bytes_used;
+
+    snd = PMIX_NEW(prte_rml_send_t);
+    PMIX_LOAD_PROCID(&snd->dst, PRTE_PROC_MY_NAME->nspace, rank);
+    snd->origin = *PRTE_PROC_MY_NAME;
+    snd->tag = tag;
+    snd->dbuf = view;
+    PMIX_RETAIN(owner);
+    snd->owner = owner;
+
+    /* activate the OOB send state */
+    PRTE_OOB_SEND(snd);
+
+    return PRTE_SUCCESS;
+}
@@ -44,6 +44,7 @@
 #endif
 
 #include "src/class/pmix_bitmap.h"
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/pmix/pmix-internal.h"
 
@@ -110,6 +111,10 @@ typedef void (*prte_rml_buffer_callback_fn_t)(int status, pmix_proc_t *peer,
 
 #define PRTE_RML_TAG_RML_ROUTE 14
 #define PRTE_RML_TAG_XCAST     15
+#define PRTE_RML_TAG_XCAST_FRAG 16
+
+/* batched output being forwarded up the routing tree */
+#define PRTE_RML_TAG_IOF_BATCH 17
 
 #define PRTE_RML_TAG_UPDATE_ROUTE_ACK 19
 #define PRTE_RML_TAG_SYNC             20
@@ -223,6 +228,9 @@ typedef void (*prte_rml_buffer_callback_fn_t)(int status, pmix_proc_t *peer,
 /* scheduler requests */
 #define PRTE_RML_TAG_SCHED 72
 
+/* proc state reports relayed up the routing tree */
+#define PRTE_RML_TAG_PROC_STATE 73
+
 
 #define PRTE_RML_TAG_MAX 100
 
@@ -266,6 +274,10 @@ typedef struct {
 
     /* data buffer */
     pmix_data_buffer_t *dbuf;
+    /* if not NULL, the object that owns the storage
+     * behind dbuf - we hold a reference to it until
+     * the send completes */
+    pmix_object_t *owner;
     /* msg seq number */
     uint32_t seq_num;
 } prte_rml_send_t;
@@ -314,7 +326,6 @@ PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_rml_recv_request_t);
 typedef struct {
     pmix_list_item_t super;
     pmix_rank_t rank;
-    pmix_bitmap_t relatives;
 } prte_routed_tree_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_routed_tree_t);
 
@@ -23,19 +23,202 @@
 #include "prte_config.h"
 #include "constants.h"
 
+#include <ctype.h>
 #include <stddef.h>
+#include <string.h>
 
-#include "src/class/pmix_bitmap.h"
 #include "src/util/pmix_output.h"
 
+#include "src/mca/errmgr/errmgr.h"
 #include "src/rml/rml.h"
 #include "src/runtime/prte_globals.h"
 #include "src/util/name_fns.h"
 
+/* The tree is defined over positions 0..tree_size-1, with the
+ * HNP always at the root (position 0). In the default layout a
+ * daemon's position is its rank and the tree is the usual
+ * breadth-first radix tree. When built by locality, the daemons
+ * are first sorted by hostname and laid out depth-first, so each
+ * subtree occupies a contiguous range of positions - and hence a
+ * contiguous block of nodes. Either way, parents and children are
+ * computed arithmetically as needed so we don't have to store the
+ * membership of each subtree. */
+
+static inline pmix_rank_t rank_of(pmix_rank_t pos)
+{
+    if (NULL == prte_rml_base.tree_order) {
+        return pos;
+    }
+    return prte_rml_base.tree_order[pos];
+}
+
+static inline pmix_rank_t pos_of(pmix_rank_t rank)
+{
+    if (NULL == prte_rml_base.tree_index) {
+        return rank;
+    }
+    return prte_rml_base.tree_index[rank];
+}
+
+static inline bool is_failed(pmix_rank_t rank)
+{
+    void *ptr;
+
+    if (0 == pmix_hash_table_get_size(&prte_rml_base.failed)) {
+        return false;
+    }
+    return (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&prte_rml_base.failed, rank, &ptr));
+}
+
+/* locate the depth-first subtree holding the given position,
+ * returning the parent of that position and the end of its range */
+static pmix_rank_t dfs_locate(pmix_rank_t pos, pmix_rank_t *end)
+{
+    size_t start = 0, stop = prte_rml_base.tree_size;
+    size_t n, nk, q, r, off, k = prte_rml_base.radix;
+    pmix_rank_t parent = PMIX_RANK_INVALID;
+
+    while (start != pos) {
+        /* the rest of this subtree is split into (up to) radix
+         * ranges, the first r of which are one larger */
+        n = stop - start - 1;
+        nk = (n < k) ? n : k;
+        q = n / nk;
+        r = n % nk;
+        off = pos - start - 1;
+        parent = start;
+        if (off < r * (q + 1)) {
+            start = start + 1 + (off / (q + 1)) * (q + 1);
+            stop = start + q + 1;
+        } else {
+            start = start + 1 + r * (q + 1) + ((off - r * (q + 1)) / q) * q;
+            stop = start + q;
+        }
+    }
+    if (NULL != end) {
+        *end = stop;
+    }
+    return parent;
+}
+
+/* compute the number of positions at the level of the
+ * given one, and the position at which that level starts */
+static size_t radix_level(pmix_rank_t pos, size_t *first)
+{
+    size_t Sum = 1, NInLevel = 1;
+
+    while (Sum < (size_t) pos + 1) {
+        NInLevel *= prte_rml_base.radix;
+        Sum += NInLevel;
+    }
+    if (NULL != first) {
+        *first = Sum - NInLevel;
+    }
+    return NInLevel;
+}
+
+static pmix_rank_t tree_parent(pmix_rank_t pos)
+{
+    size_t Sum, NInLevel, NInPrevLevel;
+
+    if (0 == pos) {
+        return PMIX_RANK_INVALID;
+    }
+    if (prte_rml_base.locality) {
+        return dfs_locate(pos, NULL);
+    }
+    NInLevel = radix_level(pos, &Sum);
+    NInPrevLevel = NInLevel / prte_rml_base.radix;
+    return (pmix_rank_t) ((pos - Sum) % NInPrevLevel + (Sum - NInPrevLevel));
+}
+
+/* return the position of the i'th child of the given
+ * position, or PMIX_RANK_INVALID if there is none */
+static pmix_rank_t tree_child(pmix_rank_t pos, size_t i)
+{
+    size_t n, nk, q, r, start, NInLevel;
+    pmix_rank_t end;
+
+    if ((size_t) prte_rml_base.radix <= i) {
+        return PMIX_RANK_INVALID;
+    }
+    if (prte_rml_base.locality) {
+        dfs_locate(pos, &end);
+        n = end - pos - 1;
+        if (n <= i) {
+            return PMIX_RANK_INVALID;
+        }
+        nk = (n < (size_t) prte_rml_base.radix) ? n : (size_t) prte_rml_base.radix;
+        q = n / nk;
+        r = n % nk;
+        if (nk <= i) {
+            return PMIX_RANK_INVALID;
+        }
+        if (i < r) {
+            start = pos + 1 + i * (q + 1);
+        } else {
+            start = pos + 1 + r * (q + 1) + (i - r) * q;
+        }
+        return (pmix_rank_t) start;
+    }
+    /* our children start at our position + num_in_level */
+    NInLevel = radix_level(pos, NULL);
+    start = pos + (i + 1) * NInLevel;
+    if (prte_rml_base.tree_size <= start) {
+        return PMIX_RANK_INVALID;
+    }
+    return (pmix_rank_t) start;
+}
+
+/* the nearest ancestor of the given daemon that is still alive */
+static pmix_rank_t live_parent(pmix_rank_t rank)
+{
+    pmix_rank_t pos;
+
+    if (prte_rml_base.tree_size <= rank) {
+        return PMIX_RANK_INVALID;
+    }
+    pos = tree_parent(pos_of(rank));
+    while (PMIX_RANK_INVALID != pos && 0 != pos && is_failed(rank_of(pos))) {
+        pos = tree_parent(pos);
+    }
+    if (PMIX_RANK_INVALID == pos) {
+        return PMIX_RANK_INVALID;
+    }
+    return rank_of(pos);
+}
+
+/* the daemon we must step through to reach the target if it
+ * lies beneath us, or PMIX_RANK_INVALID if it does not */
+static pmix_rank_t next_hop_down(pmix_rank_t target)
+{
+    pmix_rank_t pos, mypos, hop, rank;
+
+    if (prte_rml_base.tree_size <= target ||
+        prte_rml_base.tree_size <= PRTE_PROC_MY_NAME->rank) {
+        return PMIX_RANK_INVALID;
+    }
+    mypos = pos_of(PRTE_PROC_MY_NAME->rank);
+    pos = pos_of(target);
+    hop = target;
+    /* parents always precede their children, so we can
+     * stop climbing as soon as we pass our own position */
+    while (mypos < pos) {
+        pos = tree_parent(pos);
+        if (pos == mypos) {
+            return hop;
+        }
+        rank = rank_of(pos);
+        if (!is_failed(rank)) {
+            hop = rank;
+        }
+    }
+    return PMIX_RANK_INVALID;
+}
+
 pmix_rank_t prte_rml_get_route(pmix_rank_t target)
 {
     pmix_rank_t ret;
-    prte_routed_tree_t *child;
 
     /* if it is me, then the route is just direct */
     if (PRTE_PROC_MY_NAME->rank == target) {
@@ -54,20 +237,10 @@ pmix_rank_t prte_rml_get_route(pmix_rank_t target)
         goto found;
     }
 
-    /* search routing tree for next step to that daemon */
-    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
-    {
-        if (child->rank == target) {
-            /* the child is the target */
-            ret = target;
-            goto found;
-        }
-        /* otherwise, see if the daemon we need is below the child */
-        if (pmix_bitmap_is_set_bit(&child->relatives, target)) {
-            /* yep - we need to step through this child */
-            ret = child->rank;
-            goto found;
-        }
+    /* see if the target lies beneath one of our children */
+    ret = next_hop_down(target);
+    if (PMIX_RANK_INVALID != ret) {
+        goto found;
     }
 
     /* if we get here, then the target daemon is not beneath
@@ -85,15 +258,58 @@ found:
     return ret;
 }
 
+static bool is_child(pmix_rank_t rank)
+{
+    prte_routed_tree_t *child;
+
+    PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
+    {
+        if (child->rank == rank) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* add the children of the given position to our list, adopting
+ * the children of any that have failed in their place */
+static void add_children(pmix_rank_t pos)
+{
+    prte_routed_tree_t *child;
+    pmix_rank_t peer, rank;
+    size_t i;
+
+    for (i = 0; PMIX_RANK_INVALID != (peer = tree_child(pos, i)); i++) {
+        rank = rank_of(peer);
+        if (is_failed(rank)) {
+            add_children(peer);
+            continue;
+        }
+        if (is_child(rank)) {
+            continue;
+        }
+        child = PMIX_NEW(prte_routed_tree_t);
+        child->rank = rank;
+        pmix_list_append(&prte_rml_base.children, &child->super);
+    }
+}
+
 int prte_rml_route_lost(pmix_rank_t route)
 {
     prte_routed_tree_t *child;
+    pmix_rank_t parent;
 
     PMIX_OUTPUT_VERBOSE((2, prte_rml_base.routed_output,
                          "%s route to %s lost",
                          PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                          PRTE_VPID_PRINT(route)));
 
+    if (prte_rml_base.reparent && !prte_finalizing &&
+        route != PRTE_PROC_MY_HNP->rank && route < prte_rml_base.tree_size) {
+        /* remember it so we route around it from now on */
+        pmix_hash_table_set_value_uint32(&prte_rml_base.failed, route, (void *) 1);
+    }
+
     /* if we lose the connection to the lifeline and we are NOT already,
      * in finalize, tell the OOB to abort.
      * NOTE: we cannot call abort from here as the OOB needs to first
@@ -104,7 +320,23 @@ int prte_rml_route_lost(pmix_rank_t route)
                              "%s routed:radix: Connection to lifeline %s lost",
                              PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                              PRTE_VPID_PRINT(prte_rml_base.lifeline)));
-        return PRTE_ERR_FATAL;
+        if (!prte_rml_base.reparent || route == PRTE_PROC_MY_HNP->rank) {
+            return PRTE_ERR_FATAL;
+        }
+        /* attach ourselves to the nearest surviving ancestor - it
+         * will adopt us when it sees the same daemon go away */
+        parent = live_parent(PRTE_PROC_MY_NAME->rank);
+        if (PMIX_RANK_INVALID == parent) {
+            return PRTE_ERR_FATAL;
+        }
+        PRTE_PROC_MY_PARENT->rank = parent;
+        prte_rml_base.lifeline = parent;
+        ++prte_rml_base.tree_version;
+        PMIX_OUTPUT_VERBOSE((2, prte_rml_base.routed_output,
+                             "%s routed:radix: new lifeline %s",
+                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                             PRTE_VPID_PRINT(parent)));
+        return PRTE_SUCCESS;
     }
 
     /* see if it is one of our children - if so, remove it */
@@ -113,6 +345,12 @@ int prte_rml_route_lost(pmix_rank_t route)
         if (child->rank == route) {
             pmix_list_remove_item(&prte_rml_base.children, &child->super);
             PMIX_RELEASE(child);
+            if (prte_rml_base.reparent && !prte_finalizing &&
+                route < prte_rml_base.tree_size) {
+                /* take in the orphaned subtrees */
+                add_children(pos_of(route));
+                ++prte_rml_base.tree_version;
+            }
             return PRTE_SUCCESS;
         }
     }
@@ -121,86 +359,134 @@ int prte_rml_route_lost(pmix_rank_t route)
     return PRTE_SUCCESS;
 }
 
-static void radix_tree(int rank,
-                       pmix_list_t *children,
-                       pmix_bitmap_t *relatives)
+/* compare hostnames so that embedded numbers sort by value,
+ * e.g., node2 comes before node10 */
+static int natural_cmp(const char *a, const char *b)
 {
-    int i, peer, Sum, NInLevel;
-    prte_routed_tree_t *child;
-    pmix_bitmap_t *relations;
+    size_t la, lb;
+    int rc;
 
-    /* compute how many procs are at my level */
-    Sum = 1;
-    NInLevel = 1;
+    while ('\0' != *a && '\0' != *b) {
+        if (isdigit((unsigned char) *a) && isdigit((unsigned char) *b)) {
+            while ('0' == *a) {
+                ++a;
+            }
+            while ('0' == *b) {
+                ++b;
+            }
+            for (la = 0; isdigit((unsigned char) a[la]); la++);
+            for (lb = 0; isdigit((unsigned char) b[lb]); lb++);
+            if (la != lb) {
+                return (la < lb) ? -1 : 1;
+            }
+            if (0 != (rc = strncmp(a, b, la))) {
+                return rc;
+            }
+            a += la;
+            b += lb;
+            continue;
+        }
+        if (*a != *b) {
+            return (unsigned char) *a - (unsigned char) *b;
+        }
+        ++a;
+        ++b;
+    }
+    return (unsigned char) *a - (unsigned char) *b;
+}
 
-    while (Sum < (rank + 1)) {
-        NInLevel *= prte_rml_base.radix;
-        Sum += NInLevel;
+static prte_job_t *order_dmns = NULL;
+
+static const char *dmn_host(pmix_rank_t rank)
+{
+    prte_proc_t *d;
+
+    d = (prte_proc_t *) pmix_pointer_array_get_item(order_dmns->procs, rank);
+    if (NULL == d || NULL == d->node) {
+        return NULL;
     }
+    return d->node->name;
+}
 
-    /* our children start at our rank + num_in_level */
-    peer = rank + NInLevel;
-    for (i = 0; i < prte_rml_base.radix; i++) {
-        if (peer < (int) prte_process_info.num_daemons) {
-            child = PMIX_NEW(prte_routed_tree_t);
-            child->rank = peer;
-            if (NULL != children) {
-                /* this is a direct child - add it to my list */
-                pmix_list_append(children, &child->super);
-                /* setup the relatives bitmap */
-                pmix_bitmap_init(&child->relatives, prte_process_info.num_daemons);
-                /* point to the relatives */
-                relations = &child->relatives;
-            } else {
-                /* we are recording someone's relatives - set the bit */
-                if (PRTE_SUCCESS != pmix_bitmap_set_bit(relatives, peer)) {
-                    pmix_output(0, "%s Error: could not set relations bit!",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                }
-                /* point to this relations */
-                relations = relatives;
-                PMIX_RELEASE(child);
-            }
-            /* search for this child's relatives */
-            radix_tree(peer, NULL, relations);
+static int locality_cmp(const void *a, const void *b)
+{
+    pmix_rank_t ra = *(const pmix_rank_t *) a;
+    pmix_rank_t rb = *(const pmix_rank_t *) b;
+    const char *ha, *hb;
+    int rc;
+
+    ha = dmn_host(ra);
+    hb = dmn_host(rb);
+    /* daemons whose location we don't know yet go last */
+    if (NULL != ha && NULL != hb) {
+        if (0 != (rc = natural_cmp(ha, hb))) {
+            return rc;
         }
-        peer += NInLevel;
+    } else if (NULL != ha) {
+        return -1;
+    } else if (NULL != hb) {
+        return 1;
+    }
+    return (ra < rb) ? -1 : ((ra > rb) ? 1 : 0);
+}
+
+static void locality_order(void)
+{
+    pmix_rank_t n, N = prte_rml_base.tree_size;
+
+    if (NULL != prte_rml_base.tree_order) {
+        free(prte_rml_base.tree_order);
+        prte_rml_base.tree_order = NULL;
+    }
+    if (NULL != prte_rml_base.tree_index) {
+        free(prte_rml_base.tree_index);
+        prte_rml_base.tree_index = NULL;
+    }
+    if (!prte_rml_base.locality || N < 3) {
+        return;
+    }
+    prte_rml_base.tree_order = (pmix_rank_t *) malloc(N * sizeof(pmix_rank_t));
+    prte_rml_base.tree_index = (pmix_rank_t *) malloc(N * sizeof(pmix_rank_t));
+    if (NULL == prte_rml_base.tree_order || NULL == prte_rml_base.tree_index) {
+        PRTE_ERROR_LOG(PRTE_ERR_OUT_OF_RESOURCE);
+        free(prte_rml_base.tree_order);
+        free(prte_rml_base.tree_index);
+        prte_rml_base.tree_order = NULL;
+        prte_rml_base.tree_index = NULL;
+        return;
+    }
+    for (n = 0; n < N; n++) {
+        prte_rml_base.tree_order[n] = n;
+    }
+    /* the HNP always stays at the root */
+    order_dmns = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
+    if (NULL != order_dmns) {
+        qsort(&prte_rml_base.tree_order[1], N - 1, sizeof(pmix_rank_t), locality_cmp);
+        order_dmns = NULL;
+    }
+    for (n = 0; n < N; n++) {
+        prte_rml_base.tree_index[prte_rml_base.tree_order[n]] = n;
     }
 }
 
 void prte_rml_compute_routing_tree(void)
 {
     prte_routed_tree_t *child;
-    int j;
-    int Level, Sum, NInLevel, Ii;
-    int NInPrevLevel;
     prte_job_t *dmns;
     prte_proc_t *d;
+    pmix_rank_t parent;
 
-    /* compute my parent */
-    Ii = PRTE_PROC_MY_NAME->rank;
-    Level = 0;
-    Sum = 1;
-    NInLevel = 1;
-
-    while (Sum < (Ii + 1)) {
-        Level++;
-        NInLevel *= prte_rml_base.radix;
-        Sum += NInLevel;
-    }
-    Sum -= NInLevel;
-
-    NInPrevLevel = NInLevel / prte_rml_base.radix;
+    prte_rml_base.tree_size = prte_process_info.num_daemons;
+    locality_order();
 
-    if (0 == Ii) {
+    /* compute my parent */
+    if (0 == PRTE_PROC_MY_NAME->rank) {
         PRTE_PROC_MY_PARENT->rank = -1;
-    } else {
-        PRTE_PROC_MY_PARENT->rank = (Ii - Sum) % NInPrevLevel;
-        PRTE_PROC_MY_PARENT->rank += (Sum - NInPrevLevel);
+    } else if (PMIX_RANK_INVALID != (parent = live_parent(PRTE_PROC_MY_NAME->rank))) {
+        PRTE_PROC_MY_PARENT->rank = parent;
     }
 
-    /* compute my direct children and the bitmap that shows which vpids
-     * lie underneath their branch.  destroy list if it is not empty.
+    /* compute my direct children. destroy list if it is not empty.
      * this situation can arise when the DVM is being resized.
      */
 
@@ -209,7 +495,10 @@ void prte_rml_compute_routing_tree(void)
         PMIX_CONSTRUCT(&prte_rml_base.children, pmix_list_t);
     }
 
-    radix_tree(Ii, &prte_rml_base.children, NULL);
+    if (PRTE_PROC_MY_NAME->rank < prte_rml_base.tree_size) {
+        add_children(pos_of(PRTE_PROC_MY_NAME->rank));
+    }
+    ++prte_rml_base.tree_version;
 
     if (0 < pmix_output_get_verbosity(prte_rml_base.routed_output)) {
         pmix_output(0, "%s: parent %d num_children %d",
@@ -219,7 +508,8 @@ void prte_rml_compute_routing_tree(void)
         dmns = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
         PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t)
         {
-            d = (prte_proc_t *) pmix_pointer_array_get_item(dmns->procs, child->rank);
+            d = (NULL == dmns) ? NULL :
+                (prte_proc_t *) pmix_pointer_array_get_item(dmns->procs, child->rank);
             if (NULL == d || NULL == d->node || NULL == d->node->name) {
                 pmix_output(0, "%s: \tchild %d ",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
@@ -228,11 +518,6 @@ void prte_rml_compute_routing_tree(void)
             }
             pmix_output(0, "%s: \tchild %d node %s", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
                         child->rank, d->node->name);
-            for (j = 0; j < (int) prte_process_info.num_daemons; j++) {
-                if (pmix_bitmap_is_set_bit(&child->relatives, j)) {
-                    pmix_output(0, "%s: \t\trelation %d", PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), j);
-                }
-            }
         }
     }
 }
@@ -249,12 +534,9 @@ int prte_rml_get_num_contributors(pmix_rank_t *dmns, size_t ndmns)
     n = 0;
     PMIX_LIST_FOREACH(child, &prte_rml_base.children, prte_routed_tree_t) {
         for (j = 0; j < (int) ndmns; j++) {
-            /* if the child is one of the daemons, then take it */
-            if (dmns[j] == child->rank) {
-                n++;
-                break;
-            }
-            if (pmix_bitmap_is_set_bit(&child->relatives, dmns[j])) {
+            /* if the child is one of the daemons, or the
+             * daemon lies beneath it, then take it */
+            if (dmns[j] == child->rank || next_hop_down(dmns[j]) == child->rank) {
                 n++;
                 break;
             }
@@ -24,8 +24,10 @@
 #include "prte_config.h"
 #include "types.h"
 
+#include <string.h>
 #include <sys/types.h>
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/hwloc/hwloc-internal.h"
 #include "src/mca/errmgr/errmgr.h"
@@ -35,6 +37,195 @@
 
 #include "src/runtime/prte_globals.h"
 
+/* pack a column of values as a series of (start, stride, count)
+ * runs if that is smaller than packing them directly */
+static int pack_column(pmix_data_buffer_t *bkt, const uint32_t *vals, int32_t n)
+{
+    pmix_status_t rc;
+    uint32_t *runs = NULL, nruns = 0;
+    int32_t i, j;
+    int8_t flag;
+
+    if (0 < n) {
+        runs = (uint32_t *) malloc(3 * n * sizeof(uint32_t));
+        if (NULL == runs) {
+            return PRTE_ERR_OUT_OF_RESOURCE;
+        }
+    }
+    for (i = 0; i < n && 3 * nruns < (uint32_t) n; i = j) {
+        runs[3 * nruns] = vals[i];
+        runs[3 * nruns + 1] = (i + 1 < n) ? vals[i + 1] - vals[i] : 0;
+        for (j = i + 1; j < n && vals[j] - vals[j - 1] == runs[3 * nruns + 1]; j++) {
+            ;
+        }
+        runs[3 * nruns + 2] = j - i;
+        ++nruns;
+    }
+
+    flag = (i == n && 3 * nruns < (uint32_t) n) ? 1 : 0;
+    rc = PMIx_Data_pack(NULL, bkt, &flag, 1, PMIX_INT8);
+    if (PMIX_SUCCESS == rc && 1 == flag) {
+        rc = PMIx_Data_pack(NULL, bkt, &nruns, 1, PMIX_UINT32);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, bkt, runs, 3 * nruns, PMIX_UINT32);
+        }
+    } else if (PMIX_SUCCESS == rc && 0 < n) {
+        rc = PMIx_Data_pack(NULL, bkt, (void *) vals, n, PMIX_UINT32);
+    }
+    if (NULL != runs) {
+        free(runs);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    return PRTE_SUCCESS;
+}
+
+/* The launch message sends the procs of a job as a set of columns
+ * rather than one record per proc. The mappers assign ranks,
+ * parents, local ranks and cpusets in regular patterns, so each
+ * column collapses to a handful of runs and the message grows with
+ * the number of nodes rather than the number of procs. The few procs
+ * that carry attributes to be sent follow as a list of their own */
+static int pack_procs(pmix_data_buffer_t *bkt, prte_job_t *job)
+{
+    pmix_status_t rc;
+    prte_proc_t *proc, **procs;
+    prte_attribute_t *kv;
+    pmix_hash_table_t table;
+    uint32_t *col = NULL, ndict = 0;
+    char **dict = NULL;
+    void *ptr;
+    int32_t i, j, n = 0, count, nattrs = 0;
+    int ret = PRTE_SUCCESS;
+
+    procs = (prte_proc_t **) malloc(job->procs->size * sizeof(prte_proc_t *));
+    if (NULL == procs) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (j = 0; j < job->procs->size; j++) {
+        if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
+            continue;
+        }
+        PRTE_ATTR_FOREACH(kv, &proc->attributes) {
+            if (PRTE_ATTR_GLOBAL == kv->local) {
+                ++nattrs;
+                break;
+            }
+        }
+        procs[n++] = proc;
+    }
+
+    rc = PMIx_Data_pack(NULL, bkt, &n, 1, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        free(procs);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 == n) {
+        free(procs);
+        return PRTE_SUCCESS;
+    }
+    col = (uint32_t *) malloc(n * sizeof(uint32_t));
+    if (NULL == col) {
+        free(procs);
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+
+#define PRTE_PACK_COLUMN(field)                 \
+    do {                                        \
+        for (i = 0; i < n; i++) {               \
+            col[i] = (uint32_t) procs[i]->field; \
+        }                                       \
+        ret = pack_column(bkt, col, n);         \
+        if (PRTE_SUCCESS != ret) {              \
+            goto cleanup;                       \
+        }                                       \
+    } while (0)
+
+    PRTE_PACK_COLUMN(name.rank);
+    PRTE_PACK_COLUMN(parent);
+    PRTE_PACK_COLUMN(local_rank);
+    PRTE_PACK_COLUMN(node_rank);
+    PRTE_PACK_COLUMN(state);
+    PRTE_PACK_COLUMN(app_idx);
+    PRTE_PACK_COLUMN(app_rank);
+#undef PRTE_PACK_COLUMN
+
+    /* the cpusets are sent once each, with each proc
+     * referencing its entry - zero means no cpuset */
+    PMIX_CONSTRUCT(&table, pmix_hash_table_t);
+    pmix_hash_table_init(&table, 64);
+    for (i = 0; i < n; i++) {
+        if (NULL == procs[i]->cpuset) {
+            col[i] = 0;
+        } else if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&table, procs[i]->cpuset,
+                                                                 strlen(procs[i]->cpuset), &ptr)) {
+            col[i] = (uint32_t) (uintptr_t) ptr;
+        } else {
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&dict, procs[i]->cpuset);
+            col[i] = ++ndict;
+            pmix_hash_table_set_value_ptr(&table, procs[i]->cpuset, strlen(procs[i]->cpuset),
+                                          (void *) (uintptr_t) col[i]);
+        }
+    }
+    PMIX_DESTRUCT(&table);
+    rc = PMIx_Data_pack(NULL, bkt, &ndict, 1, PMIX_UINT32);
+    if (PMIX_SUCCESS == rc && 0 < ndict) {
+        rc = PMIx_Data_pack(NULL, bkt, dict, ndict, PMIX_STRING);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    ret = pack_column(bkt, col, n);
+    if (PRTE_SUCCESS != ret) {
+        goto cleanup;
+    }
+
+    /* the attributes of any procs that have them, each
+     * preceded by the position of its proc in the columns */
+    rc = PMIx_Data_pack(NULL, bkt, &nattrs, 1, PMIX_INT32);
+    for (i = 0; PMIX_SUCCESS == rc && 0 < nattrs && i < n; i++) {
+        count = 0;
+        PRTE_ATTR_FOREACH(kv, &procs[i]->attributes) {
+            if (PRTE_ATTR_GLOBAL == kv->local) {
+                ++count;
+            }
+        }
+        if (0 == count) {
+            continue;
+        }
+        rc = PMIx_Data_pack(NULL, bkt, &i, 1, PMIX_INT32);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(NULL, bkt, &count, 1, PMIX_INT32);
+        }
+        PRTE_ATTR_FOREACH(kv, &procs[i]->attributes) {
+            if (PMIX_SUCCESS != rc) {
+                break;
+            }
+            if (PRTE_ATTR_GLOBAL == kv->local) {
+                rc = PMIx_Data_pack(NULL, bkt, &kv->key, 1, PMIX_UINT16);
+                if (PMIX_SUCCESS == rc) {
+                    rc = PMIx_Data_pack(NULL, bkt, &kv->data, 1, PMIX_VALUE);
+                }
+            }
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+    }
+
+cleanup:
+    PMIX_ARGV_FREE_COMPAT(dict);
+    free(col);
+    free(procs);
+    return ret;
+}
+
 /*
  * JOB
  * NOTE: We do not pack all of the job object's fields as many of them have no
@@ -42,7 +233,7 @@
  * sending a job object is to communicate the data required to dynamically
  * spawn another job - so we only pack that limited set of required data
  */
-int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
+static int pack_job(pmix_data_buffer_t *bkt, prte_job_t *job, bool launch)
 {
     pmix_status_t rc;
     int32_t j, count, bookmark;
@@ -67,7 +258,7 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
 
     /* pack the attributes that need to be sent */
     count = 0;
-    PMIX_LIST_FOREACH(kv, &job->attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(kv, &job->attributes)
     {
         if (PRTE_ATTR_GLOBAL == kv->local) {
             ++count;
@@ -78,7 +269,7 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
         PMIX_ERROR_LOG(rc);
         return prte_pmix_convert_status(rc);
     }
-    PMIX_LIST_FOREACH(kv, &job->attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(kv, &job->attributes)
     {
         if (PRTE_ATTR_GLOBAL == kv->local) {
             rc = PMIx_Data_pack(NULL, bkt, (void *) &kv->key, 1, PMIX_UINT16);
@@ -173,7 +364,13 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
         return prte_pmix_convert_status(rc);
     }
 
-    if (0 < job->num_procs) {
+    if (0 < job->num_procs && launch) {
+        j = pack_procs(bkt, job);
+        if (PRTE_SUCCESS != j) {
+            PRTE_ERROR_LOG(j);
+            return j;
+        }
+    } else if (0 < job->num_procs) {
         for (j = 0; j < job->procs->size; j++) {
             if (NULL == (proc = (prte_proc_t *) pmix_pointer_array_get_item(job->procs, j))) {
                 continue;
@@ -259,6 +456,16 @@ int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
     return PRTE_SUCCESS;
 }
 
+int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job)
+{
+    return pack_job(bkt, job, false);
+}
+
+int prte_job_pack_launch(pmix_data_buffer_t *bkt, prte_job_t *job)
+{
+    return pack_job(bkt, job, true);
+}
+
 int prte_node_pack(pmix_data_buffer_t *bkt, prte_node_t *node)
 {
     int rc;
@@ -303,7 +510,7 @@ int prte_node_pack(pmix_data_buffer_t *bkt, prte_node_t *node)
 
     /* pack any shared attributes */
     count = 0;
-    PMIX_LIST_FOREACH(kv, &node->attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(kv, &node->attributes)
     {
         if (PRTE_ATTR_GLOBAL == kv->local) {
             ++count;
@@ -315,7 +522,7 @@ int prte_node_pack(pmix_data_buffer_t *bkt, prte_node_t *node)
         return prte_pmix_convert_status(rc);
     }
     if (0 < count) {
-        PMIX_LIST_FOREACH(kv, &node->attributes, prte_attribute_t)
+        PRTE_ATTR_FOREACH(kv, &node->attributes)
         {
             if (PRTE_ATTR_GLOBAL == kv->local) {
                 rc = PMIx_Data_pack(NULL, bkt, (void *) &kv->key, 1, PMIX_UINT16);
@@ -400,7 +607,7 @@ int prte_proc_pack(pmix_data_buffer_t *bkt, prte_proc_t *proc)
 
     /* pack the attributes that will go */
     count = 0;
-    PMIX_LIST_FOREACH(kv, &proc->attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(kv, &proc->attributes)
     {
         if (PRTE_ATTR_GLOBAL == kv->local) {
             ++count;
@@ -412,7 +619,7 @@ int prte_proc_pack(pmix_data_buffer_t *bkt, prte_proc_t *proc)
         return prte_pmix_convert_status(rc);
     }
     if (0 < count) {
-        PMIX_LIST_FOREACH(kv, &proc->attributes, prte_attribute_t)
+        PRTE_ATTR_FOREACH(kv, &proc->attributes)
         {
             if (PRTE_ATTR_GLOBAL == kv->local) {
                 rc = PMIx_Data_pack(NULL, bkt, (void *) &kv->key, 1, PMIX_UINT16);
@@ -519,7 +726,7 @@ int prte_app_pack(pmix_data_buffer_t *bkt, prte_app_context_t *app)
 
     /* pack attributes */
     count = 0;
-    PMIX_LIST_FOREACH(kv, &app->attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(kv, &app->attributes)
     {
         if (PRTE_ATTR_GLOBAL == kv->local) {
             ++count;
@@ -531,7 +738,7 @@ int prte_app_pack(pmix_data_buffer_t *bkt, prte_app_context_t *app)
         return prte_pmix_convert_status(rc);
     }
     if (0 < count) {
-        PMIX_LIST_FOREACH(kv, &app->attributes, prte_attribute_t)
+        PRTE_ATTR_FOREACH(kv, &app->attributes)
         {
             if (PRTE_ATTR_GLOBAL == kv->local) {
                 rc = PMIx_Data_pack(NULL, bkt, (void *) &kv->key, 1, PMIX_UINT16);
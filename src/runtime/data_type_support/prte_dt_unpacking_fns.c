@@ -34,6 +34,222 @@
 
 #include "src/runtime/prte_globals.h"
 
+/* unpack a column packed by pack_column in prte_dt_packing_fns.c */
+static int unpack_column(pmix_data_buffer_t *bkt, uint32_t *vals, int32_t n)
+{
+    pmix_status_t rc;
+    uint32_t *runs, nruns, r, k;
+    int32_t cnt, i = 0;
+    int8_t flag;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &flag, &cnt, PMIX_INT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 == flag) {
+        if (0 == n) {
+            return PRTE_SUCCESS;
+        }
+        cnt = n;
+        rc = PMIx_Data_unpack(NULL, bkt, vals, &cnt, PMIX_UINT32);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            return prte_pmix_convert_status(rc);
+        }
+        return PRTE_SUCCESS;
+    }
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &nruns, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if ((uint32_t) n < nruns) {
+        PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    runs = (uint32_t *) malloc(3 * nruns * sizeof(uint32_t));
+    if (NULL == runs) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    cnt = 3 * nruns;
+    rc = PMIx_Data_unpack(NULL, bkt, runs, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        free(runs);
+        return prte_pmix_convert_status(rc);
+    }
+    for (r = 0; r < nruns; r++) {
+        if ((uint32_t) (n - i) < runs[3 * r + 2]) {
+            break;
+        }
+        for (k = 0; k < runs[3 * r + 2]; k++) {
+            vals[i++] = runs[3 * r] + k * runs[3 * r + 1];
+        }
+    }
+    free(runs);
+    if (i != n) {
+        PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    return PRTE_SUCCESS;
+}
+
+/* unpack the procs packed by pack_procs in prte_dt_packing_fns.c */
+static int unpack_procs(pmix_data_buffer_t *bkt, prte_job_t *jptr)
+{
+    pmix_status_t rc;
+    prte_proc_t **procs;
+    prte_attribute_t kv;
+    uint32_t *col = NULL, ndict = 0;
+    char **dict = NULL;
+    int32_t cnt, i, k, n, idx, count, nattrs;
+    int ret = PRTE_SUCCESS;
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &n, &cnt, PMIX_INT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return prte_pmix_convert_status(rc);
+    }
+    if (0 >= n) {
+        return PRTE_SUCCESS;
+    }
+    procs = (prte_proc_t **) malloc(n * sizeof(prte_proc_t *));
+    col = (uint32_t *) malloc(n * sizeof(uint32_t));
+    if (NULL == procs || NULL == col) {
+        if (NULL != procs) {
+            free(procs);
+        }
+        if (NULL != col) {
+            free(col);
+        }
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    for (i = 0; i < n; i++) {
+        procs[i] = PMIX_NEW(prte_proc_t);
+        PMIX_LOAD_NSPACE(procs[i]->name.nspace, jptr->nspace);
+    }
+
+#define PRTE_UNPACK_COLUMN(field, type)             \
+    do {                                            \
+        ret = unpack_column(bkt, col, n);           \
+        if (PRTE_SUCCESS != ret) {                  \
+            goto cleanup;                           \
+        }                                           \
+        for (i = 0; i < n; i++) {                   \
+            procs[i]->field = (type) col[i];        \
+        }                                           \
+    } while (0)
+
+    PRTE_UNPACK_COLUMN(name.rank, pmix_rank_t);
+    PRTE_UNPACK_COLUMN(parent, pmix_rank_t);
+    PRTE_UNPACK_COLUMN(local_rank, prte_local_rank_t);
+    PRTE_UNPACK_COLUMN(node_rank, prte_node_rank_t);
+    PRTE_UNPACK_COLUMN(state, prte_proc_state_t);
+    PRTE_UNPACK_COLUMN(app_idx, prte_app_idx_t);
+    PRTE_UNPACK_COLUMN(app_rank, pmix_rank_t);
+#undef PRTE_UNPACK_COLUMN
+
+    /* the cpuset dictionary and each proc's entry in it */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &ndict, &cnt, PMIX_UINT32);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+        goto cleanup;
+    }
+    if ((uint32_t) n < ndict) {
+        ret = PRTE_ERR_UNPACK_FAILURE;
+        PRTE_ERROR_LOG(ret);
+        goto cleanup;
+    }
+    if (0 < ndict) {
+        dict = (char **) calloc(ndict + 1, sizeof(char *));
+        if (NULL == dict) {
+            ret = PRTE_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        cnt = ndict;
+        rc = PMIx_Data_unpack(NULL, bkt, dict, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            ret = prte_pmix_convert_status(rc);
+            goto cleanup;
+        }
+    }
+    ret = unpack_column(bkt, col, n);
+    if (PRTE_SUCCESS != ret) {
+        goto cleanup;
+    }
+    for (i = 0; i < n; i++) {
+        if (0 == col[i]) {
+            continue;
+        }
+        if (ndict < col[i]) {
+            ret = PRTE_ERR_UNPACK_FAILURE;
+            PRTE_ERROR_LOG(ret);
+            goto cleanup;
+        }
+        procs[i]->cpuset = strdup(dict[col[i] - 1]);
+    }
+
+    /* the attributes of any procs that have them */
+    cnt = 1;
+    rc = PMIx_Data_unpack(NULL, bkt, &nattrs, &cnt, PMIX_INT32);
+    for (k = 0; PMIX_SUCCESS == rc && k < nattrs; k++) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(NULL, bkt, &idx, &cnt, PMIX_INT32);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, bkt, &count, &cnt, PMIX_INT32);
+        }
+        if (PMIX_SUCCESS == rc && (0 > idx || n <= idx)) {
+            rc = PMIX_ERR_UNPACK_FAILURE;
+        }
+        for (i = 0; PMIX_SUCCESS == rc && i < count; i++) {
+            PRTE_ATTRIBUTE_CONSTRUCT(&kv);
+            cnt = 1;
+            rc = PMIx_Data_unpack(NULL, bkt, &kv.key, &cnt, PMIX_UINT16);
+            if (PMIX_SUCCESS == rc) {
+                cnt = 1;
+                rc = PMIx_Data_unpack(NULL, bkt, &kv.data, &cnt, PMIX_VALUE);
+            }
+            if (PMIX_SUCCESS != rc) {
+                PRTE_ATTRIBUTE_DESTRUCT(&kv);
+                break;
+            }
+            kv.local = PRTE_ATTR_GLOBAL; // obviously not a local value
+            ret = prte_attr_list_append(&procs[idx]->attributes, &kv);
+            if (PRTE_SUCCESS != ret) {
+                PRTE_ERROR_LOG(ret);
+                PRTE_ATTRIBUTE_DESTRUCT(&kv);
+                goto cleanup;
+            }
+        }
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        ret = prte_pmix_convert_status(rc);
+    }
+
+cleanup:
+    for (i = 0; i < n; i++) {
+        if (PRTE_SUCCESS == ret) {
+            pmix_pointer_array_add(jptr->procs, procs[i]);
+        } else {
+            PMIX_RELEASE(procs[i]);
+        }
+    }
+    PMIX_ARGV_FREE_COMPAT(dict);
+    free(col);
+    free(procs);
+    return ret;
+}
+
 /*
  * JOB
  * NOTE: We do not pack all of the job object's fields as many of them have no
@@ -42,13 +258,13 @@
  * spawn another job - so we only pack that limited set of required data.
  * Therefore, only unpack what was packed
  */
-int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
+static int unpack_job(pmix_data_buffer_t *bkt, prte_job_t **job, bool launch)
 {
     int rc;
     int32_t k, n, count, bookmark;
     prte_job_t *jptr;
     prte_app_idx_t j;
-    prte_attribute_t *kv;
+    prte_attribute_t kv;
     char *tmp;
     prte_info_item_t *val;
     pmix_info_t pval;
@@ -88,24 +304,30 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
         return prte_pmix_convert_status(rc);
     }
     for (k = 0; k < count; k++) {
-        kv = PMIX_NEW(prte_attribute_t);
+        PRTE_ATTRIBUTE_CONSTRUCT(&kv);
         n = 1;
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->key, &n, PMIX_UINT16);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.key, &n, PMIX_UINT16);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(jptr);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->data, &n, PMIX_VALUE);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.data, &n, PMIX_VALUE);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(jptr);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        kv->local = PRTE_ATTR_GLOBAL; // obviously not a local value
-        pmix_list_append(&jptr->attributes, &kv->super);
+        kv.local = PRTE_ATTR_GLOBAL; // obviously not a local value
+        rc = prte_attr_list_append(&jptr->attributes, &kv);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_RELEASE(jptr);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
+            return rc;
+        }
     }
     /* unpack any job info */
     n = 1;
@@ -193,7 +415,14 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
         return prte_pmix_convert_status(rc);
     }
 
-    if (0 < jptr->num_procs) {
+    if (0 < jptr->num_procs && launch) {
+        rc = unpack_procs(bkt, jptr);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_RELEASE(jptr);
+            return rc;
+        }
+    } else if (0 < jptr->num_procs) {
         prte_proc_t *proc;
         for (j = 0; j < jptr->num_procs; j++) {
             n = 1;
@@ -281,6 +510,16 @@ int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
     return PRTE_SUCCESS;
 }
 
+int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job)
+{
+    return unpack_job(bkt, job, false);
+}
+
+int prte_job_unpack_launch(pmix_data_buffer_t *bkt, prte_job_t **job)
+{
+    return unpack_job(bkt, job, true);
+}
+
 /*
  * NODE
  */
@@ -290,7 +529,7 @@ int prte_node_unpack(pmix_data_buffer_t *bkt, prte_node_t **nd)
     int32_t n, k, count;
     prte_node_t *node;
     uint8_t flag;
-    prte_attribute_t *kv;
+    prte_attribute_t kv;
 
     /* create the node object */
     node = PMIX_NEW(prte_node_t);
@@ -347,24 +586,30 @@ int prte_node_unpack(pmix_data_buffer_t *bkt, prte_node_t **nd)
         return prte_pmix_convert_status(rc);
     }
     for (k = 0; k < count; k++) {
-        kv = PMIX_NEW(prte_attribute_t);
+        PRTE_ATTRIBUTE_CONSTRUCT(&kv);
         n = 1;
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->key, &n, PMIX_UINT16);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.key, &n, PMIX_UINT16);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(node);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->data, &n, PMIX_VALUE);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.data, &n, PMIX_VALUE);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(node);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        kv->local = PRTE_ATTR_GLOBAL; // obviously not a local value
-        pmix_list_append(&node->attributes, &kv->super);
+        kv.local = PRTE_ATTR_GLOBAL; // obviously not a local value
+        rc = prte_attr_list_append(&node->attributes, &kv);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_RELEASE(node);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
+            return rc;
+        }
     }
     *nd = node;
     return PRTE_SUCCESS;
@@ -377,7 +622,7 @@ int prte_proc_unpack(pmix_data_buffer_t *bkt, prte_proc_t **pc)
 {
     pmix_status_t rc;
     int32_t n, count, k;
-    prte_attribute_t *kv;
+    prte_attribute_t kv;
     ;
     prte_proc_t *proc;
 
@@ -468,24 +713,30 @@ int prte_proc_unpack(pmix_data_buffer_t *bkt, prte_proc_t **pc)
         return prte_pmix_convert_status(rc);
     }
     for (k = 0; k < count; k++) {
-        kv = PMIX_NEW(prte_attribute_t);
+        PRTE_ATTRIBUTE_CONSTRUCT(&kv);
         n = 1;
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->key, &n, PMIX_UINT16);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.key, &n, PMIX_UINT16);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(proc);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->data, &n, PMIX_VALUE);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.data, &n, PMIX_VALUE);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(proc);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        kv->local = PRTE_ATTR_GLOBAL; // obviously not a local value
-        pmix_list_append(&proc->attributes, &kv->super);
+        kv.local = PRTE_ATTR_GLOBAL; // obviously not a local value
+        rc = prte_attr_list_append(&proc->attributes, &kv);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_RELEASE(proc);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
+            return rc;
+        }
     }
     *pc = proc;
     return PRTE_SUCCESS;
@@ -499,7 +750,7 @@ int prte_app_unpack(pmix_data_buffer_t *bkt, prte_app_context_t **ap)
     int rc;
     prte_app_context_t *app;
     int32_t n, count, k;
-    prte_attribute_t *kv;
+    prte_attribute_t kv;
     char *tmp;
 
     /* create the app_context object */
@@ -610,24 +861,30 @@ int prte_app_unpack(pmix_data_buffer_t *bkt, prte_app_context_t **ap)
         return prte_pmix_convert_status(rc);
     }
     for (k = 0; k < count; k++) {
-        kv = PMIX_NEW(prte_attribute_t);
+        PRTE_ATTRIBUTE_CONSTRUCT(&kv);
         n = 1;
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->key, &n, PMIX_UINT16);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.key, &n, PMIX_UINT16);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(app);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        rc = PMIx_Data_unpack(NULL, bkt, &kv->data, &n, PMIX_VALUE);
+        rc = PMIx_Data_unpack(NULL, bkt, &kv.data, &n, PMIX_VALUE);
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_RELEASE(app);
-            PMIX_RELEASE(kv);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
             return prte_pmix_convert_status(rc);
         }
-        kv->local = PRTE_ATTR_GLOBAL; // obviously not a local value
-        pmix_list_append(&app->attributes, &kv->super);
+        kv.local = PRTE_ATTR_GLOBAL; // obviously not a local value
+        rc = prte_attr_list_append(&app->attributes, &kv);
+        if (PRTE_SUCCESS != rc) {
+            PRTE_ERROR_LOG(rc);
+            PMIX_RELEASE(app);
+            PRTE_ATTRIBUTE_DESTRUCT(&kv);
+            return rc;
+        }
     }
     *ap = app;
     return PRTE_SUCCESS;
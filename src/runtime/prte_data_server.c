@@ -33,6 +33,7 @@
 #    include <sys/time.h>
 #endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_pointer_array.h"
 #include "src/pmix/pmix-internal.h"
 #include "src/util/pmix_argv.h"
@@ -65,6 +66,8 @@ typedef struct {
     /* and the values themselves */
     pmix_info_t *info;
     size_t ninfo;
+    /* number of values not yet removed */
+    size_t nkeys;
     /* the value itself */
 } prte_data_object_t;
 
@@ -77,6 +80,7 @@ static void construct(prte_data_object_t *ptr)
     ptr->persistence = PMIX_PERSIST_SESSION;
     ptr->info = NULL;
     ptr->ninfo = 0;
+    ptr->nkeys = 0;
 }
 
 static void destruct(prte_data_object_t *ptr)
@@ -97,11 +101,15 @@ typedef struct {
     uint32_t uid;
     pmix_data_range_t range;
     char **keys;
+    size_t need;
+    bool done;
     pmix_list_t answers;
 } prte_data_req_t;
 static void rqcon(prte_data_req_t *p)
 {
     p->keys = NULL;
+    p->need = 0;
+    p->done = false;
     PMIX_CONSTRUCT(&p->answers, pmix_list_t);
 }
 static void rqdes(prte_data_req_t *p)
@@ -111,12 +119,411 @@ static void rqdes(prte_data_req_t *p)
 }
 static PMIX_CLASS_INSTANCE(prte_data_req_t, pmix_list_item_t, rqcon, rqdes);
 
+/* the store is indexed by uid and key - each index entry
+ * tracks the values published under that key along with
+ * the lookups that are waiting for it */
+typedef struct {
+    pmix_list_item_t super;
+    prte_data_object_t *data;
+    pmix_info_t *info;
+} prte_data_entry_t;
+static PMIX_CLASS_INSTANCE(prte_data_entry_t, pmix_list_item_t, NULL, NULL);
+
+typedef struct {
+    pmix_list_item_t super;
+    prte_data_req_t *req;
+} prte_data_waiter_t;
+static void wtcon(prte_data_waiter_t *p)
+{
+    p->req = NULL;
+}
+static void wtdes(prte_data_waiter_t *p)
+{
+    if (NULL != p->req) {
+        PMIX_RELEASE(p->req);
+    }
+}
+static PMIX_CLASS_INSTANCE(prte_data_waiter_t, pmix_list_item_t, wtcon, wtdes);
+
+typedef struct {
+    pmix_object_t super;
+    pmix_list_t entries;
+    pmix_list_t waiters;
+} prte_data_key_t;
+static void dkcon(prte_data_key_t *p)
+{
+    PMIX_CONSTRUCT(&p->entries, pmix_list_t);
+    PMIX_CONSTRUCT(&p->waiters, pmix_list_t);
+}
+static void dkdes(prte_data_key_t *p)
+{
+    PMIX_LIST_DESTRUCT(&p->entries);
+    PMIX_LIST_DESTRUCT(&p->waiters);
+}
+static PMIX_CLASS_INSTANCE(prte_data_key_t, pmix_object_t, dkcon, dkdes);
+
 /* local globals */
 static pmix_pointer_array_t prte_data_server_store;
+static pmix_hash_table_t prte_data_server_index;
 static pmix_list_t pending;
 static bool initialized = false;
 static int prte_data_server_output = -1;
 static int prte_data_server_verbosity = -1;
+bool prte_data_server_distributed = false;
+int prte_data_server_replicas = 0;
+int prte_data_server_shard_timeout = 60;
+
+#define PRTE_DS_INDEX_KEYLEN (sizeof(uint32_t) + PMIX_MAX_KEYLEN)
+
+static size_t index_key(uint8_t *hkey, uint32_t uid, const char *key)
+{
+    size_t len;
+
+    memcpy(hkey, &uid, sizeof(uint32_t));
+    len = strnlen(key, PMIX_MAX_KEYLEN);
+    memcpy(hkey + sizeof(uint32_t), key, len);
+    return sizeof(uint32_t) + len;
+}
+
+static prte_data_key_t *get_key(uint32_t uid, const char *key, bool create)
+{
+    uint8_t hkey[PRTE_DS_INDEX_KEYLEN];
+    prte_data_key_t *dk;
+    size_t len;
+    void *ptr;
+
+    len = index_key(hkey, uid, key);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&prte_data_server_index, hkey, len, &ptr)) {
+        return (prte_data_key_t *) ptr;
+    }
+    if (!create) {
+        return NULL;
+    }
+    dk = PMIX_NEW(prte_data_key_t);
+    pmix_hash_table_set_value_ptr(&prte_data_server_index, hkey, len, dk);
+    return dk;
+}
+
+/* remove a key from the index once nothing refers to it */
+static void release_key(uint32_t uid, const char *key, prte_data_key_t *dk)
+{
+    uint8_t hkey[PRTE_DS_INDEX_KEYLEN];
+    size_t len;
+
+    if (0 < pmix_list_get_size(&dk->entries) || 0 < pmix_list_get_size(&dk->waiters)) {
+        return;
+    }
+    len = index_key(hkey, uid, key);
+    pmix_hash_table_remove_value_ptr(&prte_data_server_index, hkey, len);
+    PMIX_RELEASE(dk);
+}
+
+/* discard a value that has already been taken out of
+ * the index, along with its object if it was the last
+ * value that object held */
+static void drop_entry(prte_data_entry_t *ent)
+{
+    prte_data_object_t *data = ent->data;
+
+    memset(ent->info->key, 0, PMIX_MAX_KEYLEN + 1);
+    PMIX_RELEASE(ent);
+    if (0 == --data->nkeys) {
+        pmix_pointer_array_set_item(&prte_data_server_store, data->index, NULL);
+        PMIX_RELEASE(data);
+    }
+}
+
+/* add the values of a newly stored object to the index */
+static void index_data(prte_data_object_t *data)
+{
+    prte_data_key_t *dk;
+    prte_data_entry_t *ent;
+    size_t n;
+
+    for (n = 0; n < data->ninfo; n++) {
+        dk = get_key(data->uid, data->info[n].key, true);
+        ent = PMIX_NEW(prte_data_entry_t);
+        ent->data = data;
+        ent->info = &data->info[n];
+        pmix_list_append(&dk->entries, &ent->super);
+    }
+    data->nkeys = data->ninfo;
+}
+
+/* remove all of an object's values from the index and release it */
+static void remove_data(prte_data_object_t *data)
+{
+    prte_data_key_t *dk;
+    prte_data_entry_t *ent;
+    size_t n;
+
+    for (n = 0; n < data->ninfo; n++) {
+        if ('\0' == data->info[n].key[0]) {
+            continue;
+        }
+        if (NULL == (dk = get_key(data->uid, data->info[n].key, false))) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(ent, &dk->entries, prte_data_entry_t) {
+            if (ent->info == &data->info[n]) {
+                pmix_list_remove_item(&dk->entries, &ent->super);
+                PMIX_RELEASE(ent);
+                break;
+            }
+        }
+        release_key(data->uid, data->info[n].key, dk);
+    }
+    pmix_pointer_array_set_item(&prte_data_server_store, data->index, NULL);
+    PMIX_RELEASE(data);
+}
+
+/* collect the values published under the given keys that are
+ * visible to the requestor - returns the number found */
+static size_t find_values(uint32_t uid, pmix_proc_t *requestor, char **keys,
+                          pmix_list_t *answers)
+{
+    prte_data_key_t *dk;
+    prte_data_entry_t *ent;
+    prte_ds_info_t *rinfo;
+    size_t i;
+
+    for (i = 0; NULL != keys[i]; i++) {
+        pmix_output_verbose(10, prte_data_server_output, "%s data server: looking for %s",
+                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), keys[i]);
+        /* for security reasons, can only access data posted by the same
+         * user id - the index takes care of that for us */
+        if (NULL == (dk = get_key(uid, keys[i], false))) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(ent, &dk->entries, prte_data_entry_t) {
+            /* if the published range is constrained to namespace, then only
+             * consider this data if the publisher is
+             * in the same namespace as the requestor */
+            if (PMIX_RANGE_NAMESPACE == ent->data->range &&
+                0 != strncmp(requestor->nspace, ent->data->owner.nspace, PMIX_MAX_NSLEN)) {
+                pmix_output_verbose(10, prte_data_server_output,
+                                    "%s\tMISMATCH NSPACES %s %s",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), requestor->nspace,
+                                    ent->data->owner.nspace);
+                continue;
+            }
+            rinfo = PMIX_NEW(prte_ds_info_t);
+            memcpy(&rinfo->source, &ent->data->owner, sizeof(pmix_proc_t));
+            rinfo->info = ent->info;
+            rinfo->persistence = ent->data->persistence;
+            pmix_list_append(answers, &rinfo->super);
+            pmix_output_verbose(1, prte_data_server_output,
+                                "%s data server: adding %s to data from %s",
+                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), ent->info->key,
+                                PRTE_NAME_PRINT(&ent->data->owner));
+        }
+    }
+    return pmix_list_get_size(answers);
+}
+
+/* pack the answers into a byte object, removing any
+ * values that were only to be read once */
+static int pack_values(uint32_t uid, pmix_list_t *answers, pmix_byte_object_t *bo)
+{
+    pmix_data_buffer_t pbkt;
+    prte_ds_info_t *rinfo;
+    prte_data_key_t *dk;
+    prte_data_entry_t *ent;
+    pmix_list_t drops;
+    size_t n;
+    pmix_status_t ret;
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+    n = pmix_list_get_size(answers);
+    /* pack the number of data items found */
+    if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &n, 1, PMIX_SIZE))) {
+        PMIX_ERROR_LOG(ret);
+        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+        return PRTE_ERR_PACK_FAILURE;
+    }
+    /* loop thru and pack the individual responses - this is somewhat less
+     * efficient than packing an info array, but avoids another malloc
+     * operation just to assemble all the return values into a contiguous
+     * array */
+    PMIX_LIST_FOREACH(rinfo, answers, prte_ds_info_t)
+    {
+        /* pack the data owner */
+        if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            return PRTE_ERR_PACK_FAILURE;
+        }
+        if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, rinfo->info, 1, PMIX_INFO))) {
+            PMIX_ERROR_LOG(ret);
+            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            return PRTE_ERR_PACK_FAILURE;
+        }
+    }
+    ret = PMIx_Data_unload(&pbkt, bo);
+    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+    if (PMIX_SUCCESS != ret) {
+        PMIX_ERROR_LOG(ret);
+        return PRTE_ERR_PACK_FAILURE;
+    }
+
+    /* take the values that were only to be read once out of
+     * the index before discarding any of them so we cannot
+     * trip over one we already released */
+    PMIX_CONSTRUCT(&drops, pmix_list_t);
+    PMIX_LIST_FOREACH(rinfo, answers, prte_ds_info_t)
+    {
+        if (PMIX_PERSIST_FIRST_READ != rinfo->persistence) {
+            continue;
+        }
+        if (NULL == (dk = get_key(uid, rinfo->info->key, false))) {
+            continue;
+        }
+        PMIX_LIST_FOREACH(ent, &dk->entries, prte_data_entry_t) {
+            if (ent->info == rinfo->info) {
+                pmix_output_verbose(1, prte_data_server_output,
+                                    "%s REMOVING DATA FROM %s FOR KEY %s",
+                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
+                                    PRTE_NAME_PRINT(&rinfo->source), rinfo->info->key);
+                pmix_list_remove_item(&dk->entries, &ent->super);
+                pmix_list_append(&drops, &ent->super);
+                release_key(uid, rinfo->info->key, dk);
+                break;
+            }
+        }
+    }
+    while (NULL != (ent = (prte_data_entry_t *) pmix_list_remove_first(&drops))) {
+        drop_entry(ent);
+    }
+    PMIX_DESTRUCT(&drops);
+    return PRTE_SUCCESS;
+}
+
+/* send the answers to a lookup that had been waiting for them */
+static void send_values(prte_data_req_t *req, pmix_list_t *answers)
+{
+    pmix_data_buffer_t *reply;
+    pmix_byte_object_t pbo;
+    uint8_t command = PRTE_PMIX_LOOKUP_CMD;
+    int rc, status;
+
+    pmix_output_verbose(1, prte_data_server_output,
+                        "%s data server: returning data to %s:%d",
+                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), req->requestor.nspace,
+                        req->requestor.rank);
+
+    PMIX_DATA_BUFFER_CREATE(reply);
+    /* start with their room number */
+    rc = PMIx_Data_pack(NULL, reply, &req->room_number, 1, PMIX_INT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+        return;
+    }
+    /* we are responding to a lookup cmd */
+    rc = PMIx_Data_pack(NULL, reply, &command, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+        return;
+    }
+    /* if we found all of the requested keys, then indicate so */
+    if (pmix_list_get_size(answers) >= (size_t) PMIX_ARGV_COUNT_COMPAT(req->keys)) {
+        status = PRTE_SUCCESS;
+    } else {
+        status = PRTE_ERR_PARTIAL_SUCCESS;
+    }
+    rc = PMIx_Data_pack(NULL, reply, &status, 1, PMIX_INT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+        return;
+    }
+    rc = pack_values(req->uid, answers, &pbo);
+    if (PRTE_SUCCESS != rc) {
+        PMIX_DATA_BUFFER_RELEASE(reply);
+        return;
+    }
+    rc = PMIx_Data_pack(NULL, reply, &pbo, 1, PMIX_BYTE_OBJECT);
+    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+        return;
+    }
+    PRTE_RML_SEND(rc, req->proxy.rank, reply, PRTE_RML_TAG_DATA_CLIENT);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_RELEASE(reply);
+    }
+}
+
+/* take a completed lookup off the waiter lists of its keys - the
+ * list we are currently walking is left to the caller */
+static void remove_waiter(prte_data_req_t *req, prte_data_key_t *current)
+{
+    prte_data_key_t *dk;
+    prte_data_waiter_t *w, *wnext;
+    size_t i;
+
+    for (i = 0; NULL != req->keys[i]; i++) {
+        dk = get_key(req->uid, req->keys[i], false);
+        if (NULL == dk || current == dk) {
+            continue;
+        }
+        PMIX_LIST_FOREACH_SAFE(w, wnext, &dk->waiters, prte_data_waiter_t) {
+            if (w->req == req) {
+                pmix_list_remove_item(&dk->waiters, &w->super);
+                PMIX_RELEASE(w);
+            }
+        }
+        release_key(req->uid, req->keys[i], dk);
+    }
+}
+
+/* check the lookups waiting on any of the keys in a newly
+ * published object, answering those that can now be met */
+static void check_waiters(prte_data_object_t *data)
+{
+    prte_data_key_t *dk;
+    prte_data_waiter_t *w, *wnext;
+    prte_data_req_t *req;
+    pmix_list_t answers;
+    pmix_key_t key;
+    size_t n;
+
+    /* answering a lookup can remove values that were only to
+     * be read once - keep the object around until we are done */
+    PMIX_RETAIN(data);
+    for (n = 0; n < data->ninfo; n++) {
+        if ('\0' == data->info[n].key[0]) {
+            continue;
+        }
+        PMIX_LOAD_KEY(key, data->info[n].key);
+        if (NULL == (dk = get_key(data->uid, key, false))) {
+            continue;
+        }
+        PMIX_LIST_FOREACH_SAFE(w, wnext, &dk->waiters, prte_data_waiter_t) {
+            req = w->req;
+            if (!req->done) {
+                PMIX_CONSTRUCT(&answers, pmix_list_t);
+                if (req->need <= find_values(req->uid, &req->requestor, req->keys, &answers)) {
+                    send_values(req, &answers);
+                    req->done = true;
+                    pmix_list_remove_item(&pending, &req->super);
+                    PMIX_RELEASE(req);
+                    remove_waiter(req, dk);
+                }
+                PMIX_LIST_DESTRUCT(&answers);
+            }
+            if (req->done) {
+                pmix_list_remove_item(&dk->waiters, &w->super);
+                PMIX_RELEASE(w);
+            }
+        }
+        release_key(data->uid, key, dk);
+    }
+    PMIX_RELEASE(data);
+}
 
 int prte_data_server_init(void)
 {
@@ -138,12 +545,42 @@ int prte_data_server_init(void)
         pmix_output_set_verbosity(prte_data_server_output, prte_data_server_verbosity);
     }
 
+    prte_data_server_distributed = false;
+    (void) pmix_mca_base_var_register("prte", "prte", "data", "server_distributed",
+                                      "Spread the published data across all daemons in the DVM "
+                                      "by key instead of holding it on the HNP (ignored if an "
+                                      "external data server is given)",
+                                      PMIX_MCA_BASE_VAR_TYPE_BOOL,
+                                      &prte_data_server_distributed);
+
+    prte_data_server_replicas = 0;
+    (void) pmix_mca_base_var_register("prte", "prte", "data", "server_replicas",
+                                      "Number of additional daemons holding a copy of data "
+                                      "published with a persistence beyond the publishing proc "
+                                      "when the data server is distributed",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_data_server_replicas);
+    if (0 > prte_data_server_replicas) {
+        prte_data_server_replicas = 0;
+    }
+
+    prte_data_server_shard_timeout = 60;
+    (void) pmix_mca_base_var_register("prte", "prte", "data", "server_shard_timeout",
+                                      "Seconds to wait for a daemon to answer its part of a "
+                                      "request when the data server is distributed and the "
+                                      "request did not give a timeout (0 = wait forever)",
+                                      PMIX_MCA_BASE_VAR_TYPE_INT,
+                                      &prte_data_server_shard_timeout);
+
     PMIX_CONSTRUCT(&prte_data_server_store, pmix_pointer_array_t);
     if (PRTE_SUCCESS != (rc = pmix_pointer_array_init(&prte_data_server_store, 1, INT_MAX, 1))) {
         PRTE_ERROR_LOG(rc);
         return rc;
     }
 
+    PMIX_CONSTRUCT(&prte_data_server_index, pmix_hash_table_t);
+    pmix_hash_table_init(&prte_data_server_index, 1024);
+
     PMIX_CONSTRUCT(&pending, pmix_list_t);
 
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_DATA_SERVER,
@@ -156,6 +593,9 @@ void prte_data_server_finalize(void)
 {
     int32_t i;
     prte_data_object_t *data;
+    prte_data_key_t *dk;
+    void *key;
+    size_t len;
 
     if (!initialized) {
         return;
@@ -170,6 +610,12 @@ void prte_data_server_finalize(void)
         }
     }
     PMIX_DESTRUCT(&prte_data_server_store);
+    for (void *_nptr = NULL;
+         PMIX_SUCCESS == pmix_hash_table_get_next_key_ptr(&prte_data_server_index, &key, &len,
+                                                          (void **) &dk, _nptr, &_nptr);) {
+        PMIX_RELEASE(dk);
+    }
+    PMIX_DESTRUCT(&prte_data_server_index);
     PMIX_LIST_DESTRUCT(&pending);
 }
 
@@ -180,20 +626,22 @@ void prte_data_server(int status, pmix_proc_t *sender,
     uint8_t command;
     int32_t count;
     prte_data_object_t *data;
-    pmix_data_buffer_t *answer, *reply;
+    pmix_data_buffer_t *answer;
     int rc, k;
     uint32_t ninfo, i;
     char **keys = NULL, *str;
     bool wait = false;
+    size_t need = 0;
+    prte_data_key_t *dk;
+    prte_data_entry_t *ent, *enext;
+    prte_data_waiter_t *waiter;
     int room_number;
     uint32_t uid = UINT32_MAX;
     pmix_data_range_t range;
-    prte_data_req_t *req, *rqnext;
-    pmix_data_buffer_t pbkt;
+    prte_data_req_t *req;
     pmix_byte_object_t pbo;
     pmix_status_t ret;
     pmix_proc_t requestor;
-    prte_ds_info_t *rinfo;
     size_t n, nanswers;
     pmix_info_t *info;
     pmix_list_t answers;
@@ -316,144 +764,14 @@ void prte_data_server(int status, pmix_proc_t *sender,
 
         /* store this object */
         data->index = pmix_pointer_array_add(&prte_data_server_store, data);
+        index_data(data);
 
         pmix_output_verbose(1, prte_data_server_output,
                             "%s data server: checking for pending requests",
                             PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
 
         /* check for pending requests that match this data */
-        reply = NULL;
-        PMIX_LIST_FOREACH_SAFE(req, rqnext, &pending, prte_data_req_t)
-        {
-            if (req->uid != data->uid) {
-                continue;
-            }
-            /* if the published range is constrained to namespace, then only
-             * consider this data if the publisher is
-             * in the same namespace as the requestor */
-            if (PMIX_RANGE_NAMESPACE == data->range) {
-                if (0 != strncmp(req->requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
-                    continue;
-                }
-            }
-            for (i = 0; NULL != req->keys[i]; i++) {
-                /* cycle thru the data keys for matches */
-                for (n = 0; n < data->ninfo; n++) {
-                    pmix_output_verbose(10, prte_data_server_output, "%s\tCHECKING %s TO %s",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), data->info[n].key,
-                                        req->keys[i]);
-                    if (0 == strncmp(data->info[n].key, req->keys[i], PMIX_MAX_KEYLEN)) {
-                        pmix_output_verbose(10, prte_data_server_output,
-                                            "%s data server: packaging return",
-                                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
-                        /* track this response */
-                        pmix_output_verbose(
-                            10, prte_data_server_output,
-                            "%s data server: adding %s data %s from %s:%d to response",
-                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), data->info[n].key,
-                            PMIx_Data_type_string(data->info[n].value.type), data->owner.nspace,
-                            data->owner.rank);
-                        rinfo = PMIX_NEW(prte_ds_info_t);
-                        memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
-                        rinfo->info = &data->info[n];
-                        pmix_list_append(&req->answers, &rinfo->super);
-                        break; // a key can only occur once
-                    }
-                }
-            }
-            if (0 < (n = pmix_list_get_size(&req->answers))) {
-                /* send it back to the requestor */
-                pmix_output_verbose(1, prte_data_server_output,
-                                    "%s data server: returning data to %s:%d",
-                                    PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), req->requestor.nspace,
-                                    req->requestor.rank);
-
-                PMIX_DATA_BUFFER_CREATE(reply);
-                /* start with their room number */
-                rc = PMIx_Data_pack(NULL, reply, &req->room_number, 1, PMIX_INT);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    goto SEND_ERROR;
-                }
-                /* we are responding to a lookup cmd */
-                command = PRTE_PMIX_LOOKUP_CMD;
-                rc = PMIx_Data_pack(NULL, reply, &command, 1, PMIX_UINT8);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    goto SEND_ERROR;
-                }
-                /* if we found all of the requested keys, then indicate so */
-                if (n == (size_t) PMIX_ARGV_COUNT_COMPAT(req->keys)) {
-                    i = PRTE_SUCCESS;
-                } else {
-                    i = (uint32_t) PRTE_ERR_PARTIAL_SUCCESS;
-                }
-                /* return the status */
-                rc = PMIx_Data_pack(NULL, reply, &i, 1, PMIX_INT);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    goto SEND_ERROR;
-                }
-
-                /* pack the rest into a pmix_data_buffer_t */
-                PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
-
-                /* pack the number of returned info's */
-                if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &n, 1, PMIX_SIZE))) {
-                    PMIX_ERROR_LOG(ret);
-                    PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                    rc = PRTE_ERR_PACK_FAILURE;
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    goto SEND_ERROR;
-                }
-                /* loop thru and pack the individual responses - this is somewhat less
-                 * efficient than packing an info array, but avoids another malloc
-                 * operation just to assemble all the return values into a contiguous
-                 * array */
-                while (NULL != (rinfo = (prte_ds_info_t *) pmix_list_remove_first(&req->answers))) {
-                    /* pack the data owner */
-                    if (PMIX_SUCCESS
-                        != (ret = PMIx_Data_pack(NULL, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRTE_ERR_PACK_FAILURE;
-                        PMIX_DATA_BUFFER_RELEASE(reply);
-                        goto SEND_ERROR;
-                    }
-                    /* pack the data */
-                    if (PMIX_SUCCESS
-                        != (ret = PMIx_Data_pack(NULL, &pbkt, rinfo->info, 1, PMIX_INFO))) {
-                        PMIX_ERROR_LOG(ret);
-                        PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
-                        rc = PRTE_ERR_PACK_FAILURE;
-                        PMIX_DATA_BUFFER_RELEASE(reply);
-                        goto SEND_ERROR;
-                    }
-                }
-                PMIX_LIST_DESTRUCT(&req->answers);
-                PMIX_CONSTRUCT(&req->answers, pmix_list_t);
-
-                /* unload the pmix buffer */
-                rc = PMIx_Data_unload(&pbkt, &pbo);
-
-                /* pack it into our reply */
-                rc = PMIx_Data_pack(NULL, reply, &pbo, 1, PMIX_BYTE_OBJECT);
-                PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-                if (PMIX_SUCCESS != rc) {
-                    PMIX_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                    goto SEND_ERROR;
-                }
-                PRTE_RML_SEND(rc, req->proxy.rank, reply, PRTE_RML_TAG_DATA_CLIENT);
-                if (PRTE_SUCCESS != rc) {
-                    PRTE_ERROR_LOG(rc);
-                    PMIX_DATA_BUFFER_RELEASE(reply);
-                }
-            }
-        }
+        check_waiters(data);
 
         /* tell the user it was wonderful... */
         rc = PRTE_SUCCESS;
@@ -503,6 +821,7 @@ void prte_data_server(int status, pmix_proc_t *sender,
         }
 
         /* unpack the number of directives, if any */
+        range = PMIX_RANGE_SESSION; // default
         count = 1;
         if (PMIX_SUCCESS != (ret = PMIx_Data_unpack(NULL, buffer, &ninfo, &count, PMIX_SIZE))) {
             PMIX_ERROR_LOG(ret);
@@ -523,8 +842,12 @@ void prte_data_server(int status, pmix_proc_t *sender,
                 if (0 == strncmp(info[n].key, PMIX_USERID, PMIX_MAX_KEYLEN)) {
                     uid = info[n].value.data.uint32;
                 } else if (0 == strncmp(info[n].key, PMIX_WAIT, PMIX_MAX_KEYLEN)) {
-                    /* flag that we wait until the data is present */
+                    /* flag that we wait until the data is present - they
+                     * may tell us how many values are enough */
                     wait = true;
+                    if (PMIX_INT == info[n].value.type && 0 < info[n].value.data.integer) {
+                        need = info[n].value.data.integer;
+                    }
                 } else if (0 == strcmp(info[n].key, PMIX_RANGE)) {
                     range = info[n].value.data.range;
                 }
@@ -533,103 +856,14 @@ void prte_data_server(int status, pmix_proc_t *sender,
             PMIX_INFO_FREE(info, ninfo);
         }
 
-        /* cycle across the provided keys */
-        PMIX_DATA_BUFFER_CONSTRUCT(&pbkt);
+        /* find the provided keys */
         PMIX_CONSTRUCT(&answers, pmix_list_t);
+        nanswers = find_values(uid, &requestor, keys, &answers);
 
-        for (i = 0; NULL != keys[i]; i++) {
-            pmix_output_verbose(10, prte_data_server_output, "%s data server: looking for %s",
-                                PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), keys[i]);
-            /* cycle across the stored data, looking for a match */
-            for (k = 0; k < prte_data_server_store.size; k++) {
-                data = (prte_data_object_t *) pmix_pointer_array_get_item(&prte_data_server_store,
-                                                                          k);
-                if (NULL == data) {
-                    continue;
-                }
-                /* for security reasons, can only access data posted by the same user id */
-                if (uid != data->uid) {
-                    pmix_output_verbose(10, prte_data_server_output, "%s\tMISMATCH UID %u %u",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), (unsigned) uid,
-                                        (unsigned) data->uid);
-                    continue;
-                }
-                /* if the published range is constrained to namespace, then only
-                 * consider this data if the publisher is
-                 * in the same namespace as the requestor */
-                if (PMIX_RANGE_NAMESPACE == data->range) {
-                    if (0 != strncmp(requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)) {
-                        pmix_output_verbose(10, prte_data_server_output,
-                                            "%s\tMISMATCH NSPACES %s %s",
-                                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), requestor.nspace,
-                                            data->owner.nspace);
-                        continue;
-                    }
-                }
-                /* see if we have this key */
-                for (n = 0; n < data->ninfo; n++) {
-                    pmix_output_verbose(10, prte_data_server_output, "%s COMPARING %s %s",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), keys[i],
-                                        data->info[n].key);
-                    if (PMIX_CHECK_KEY(&data->info[n], keys[i])) {
-                        rinfo = PMIX_NEW(prte_ds_info_t);
-                        memcpy(&rinfo->source, &data->owner, sizeof(pmix_proc_t));
-                        rinfo->info = &data->info[n];
-                        rinfo->persistence = data->persistence;
-                        pmix_list_append(&answers, &rinfo->super);
-                        pmix_output_verbose(1, prte_data_server_output,
-                                            "%s data server: adding %s to data from %s",
-                                            PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), data->info[n].key,
-                                            PRTE_NAME_PRINT(&data->owner));
-                    }
-                }
-            } // loop over stored data
-        }     // loop over keys
-
-        if (0 < (nanswers = pmix_list_get_size(&answers))) {
-            /* pack the number of data items found */
-            if (PMIX_SUCCESS != (ret = PMIx_Data_pack(NULL, &pbkt, &nanswers, 1, PMIX_SIZE))) {
-                PMIX_ERROR_LOG(ret);
-                rc = PRTE_ERR_PACK_FAILURE;
-                PMIX_LIST_DESTRUCT(&answers);
-                PMIX_ARGV_FREE_COMPAT(keys);
-                goto SEND_ERROR;
-            }
-            /* loop thru and pack the individual responses - this is somewhat less
-             * efficient than packing an info array, but avoids another malloc
-             * operation just to assemble all the return values into a contiguous
-             * array */
-            PMIX_LIST_FOREACH(rinfo, &answers, prte_ds_info_t)
-            {
-                /* pack the data owner */
-                if (PMIX_SUCCESS
-                    != (ret = PMIx_Data_pack(NULL, &pbkt, &rinfo->source, 1, PMIX_PROC))) {
-                    PMIX_ERROR_LOG(ret);
-                    rc = PRTE_ERR_PACK_FAILURE;
-                    PMIX_LIST_DESTRUCT(&answers);
-                    PMIX_ARGV_FREE_COMPAT(keys);
-                    goto SEND_ERROR;
-                }
-                if (PMIX_SUCCESS
-                    != (ret = PMIx_Data_pack(NULL, &pbkt, rinfo->info, 1, PMIX_INFO))) {
-                    PMIX_ERROR_LOG(ret);
-                    rc = PRTE_ERR_PACK_FAILURE;
-                    PMIX_LIST_DESTRUCT(&answers);
-                    PMIX_ARGV_FREE_COMPAT(keys);
-                    goto SEND_ERROR;
-                }
-                if (PMIX_PERSIST_FIRST_READ == rinfo->persistence) {
-                    pmix_output_verbose(1, prte_data_server_output,
-                                        "%s REMOVING DATA FROM %s FOR KEY %s",
-                                        PRTE_NAME_PRINT(PRTE_PROC_MY_NAME),
-                                        PRTE_NAME_PRINT(&rinfo->source), rinfo->info->key);
-                    memset(rinfo->info->key, 0, PMIX_MAX_KEYLEN + 1);
-                }
-            }
+        if (0 == need || (size_t) PMIX_ARGV_COUNT_COMPAT(keys) < need) {
+            need = PMIX_ARGV_COUNT_COMPAT(keys);
         }
-        PMIX_LIST_DESTRUCT(&answers);
-
-        if (nanswers == (size_t) PMIX_ARGV_COUNT_COMPAT(keys)) {
+        if (nanswers >= (size_t) PMIX_ARGV_COUNT_COMPAT(keys)) {
             rc = PRTE_SUCCESS;
         } else {
             pmix_output_verbose(1, prte_data_server_output,
@@ -638,8 +872,8 @@ void prte_data_server(int status, pmix_proc_t *sender,
                                 (int) PMIX_ARGV_COUNT_COMPAT(keys));
 
             /* if we were told to wait for the data, then queue this up
-             * for later processing */
-            if (wait) {
+             * on each of the keys for later processing */
+            if (wait && nanswers < need) {
                 pmix_output_verbose(1, prte_data_server_output,
                                     "%s data server:lookup: pushing request to wait",
                                     PRTE_NAME_PRINT(PRTE_PROC_MY_NAME));
@@ -651,17 +885,25 @@ void prte_data_server(int status, pmix_proc_t *sender,
                 req->uid = uid;
                 req->range = range;
                 req->keys = keys;
+                req->need = need;
                 pmix_list_append(&pending, &req->super);
+                for (i = 0; NULL != keys[i]; i++) {
+                    waiter = PMIX_NEW(prte_data_waiter_t);
+                    PMIX_RETAIN(req);
+                    waiter->req = req;
+                    dk = get_key(uid, keys[i], true);
+                    pmix_list_append(&dk->waiters, &waiter->super);
+                }
                 /* drop the partial response we have - we'll build it when everything
                  * becomes available */
-                PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+                PMIX_LIST_DESTRUCT(&answers);
                 return;
             }
             if (0 == nanswers) {
                 /* nothing was found - indicate that situation */
                 rc = PRTE_ERR_NOT_FOUND;
                 PMIX_ARGV_FREE_COMPAT(keys);
-                PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+                PMIX_LIST_DESTRUCT(&answers);
                 goto SEND_ERROR;
             } else {
                 rc = PRTE_ERR_PARTIAL_SUCCESS;
@@ -675,11 +917,16 @@ void prte_data_server(int status, pmix_proc_t *sender,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DATA_BUFFER_RELEASE(answer);
-            PMIX_DATA_BUFFER_DESTRUCT(&pbkt);
+            PMIX_LIST_DESTRUCT(&answers);
+            return;
+        }
+        /* pack the values */
+        rc = pack_values(uid, &answers, &pbo);
+        PMIX_LIST_DESTRUCT(&answers);
+        if (PRTE_SUCCESS != rc) {
+            PMIX_DATA_BUFFER_RELEASE(answer);
             return;
         }
-        /* unload the packed values */
-        rc = PMIx_Data_unload(&pbkt, &pbo);
 
         /* pack it into our reply */
         rc = PMIx_Data_pack(NULL, answer, &pbo, 1, PMIX_BYTE_OBJECT);
@@ -687,7 +934,7 @@ void prte_data_server(int status, pmix_proc_t *sender,
         if (PMIX_SUCCESS != rc) {
             PMIX_ERROR_LOG(rc);
             PMIX_DATA_BUFFER_RELEASE(answer);
-            goto SEND_ERROR;
+            return;
         }
         goto SEND_ANSWER;
 
@@ -761,45 +1008,25 @@ void prte_data_server(int status, pmix_proc_t *sender,
 
         /* cycle across the provided keys */
         for (i = 0; NULL != keys[i]; i++) {
-            /* cycle across the stored data, looking for a match */
-            for (k = 0; k < prte_data_server_store.size; k++) {
-                data = (prte_data_object_t *) pmix_pointer_array_get_item(&prte_data_server_store,
-                                                                          k);
-                if (NULL == data) {
-                    continue;
-                }
-                /* can only access data posted by the same user id */
-                if (uid != data->uid) {
-                    continue;
-                }
+            /* can only access data posted by the same user id */
+            if (NULL == (dk = get_key(uid, keys[i], false))) {
+                continue;
+            }
+            PMIX_LIST_FOREACH_SAFE(ent, enext, &dk->entries, prte_data_entry_t) {
                 /* can only access data posted by the same process */
-                if (0 != strncmp(requestor.nspace, data->owner.nspace, PMIX_MAX_NSLEN)
-                    || requestor.rank != data->owner.rank) {
+                if (0 != strncmp(requestor.nspace, ent->data->owner.nspace, PMIX_MAX_NSLEN)
+                    || requestor.rank != ent->data->owner.rank) {
                     continue;
                 }
                 /* can only access data posted for the same range */
-                if (range != data->range) {
+                if (range != ent->data->range) {
                     continue;
                 }
-                /* see if we have this key */
-                nanswers = 0;
-                for (n = 0; n < data->ninfo; n++) {
-                    if (0 == strlen(data->info[n].key)) {
-                        ++nanswers;
-                        continue;
-                    }
-                    if (0 == strncmp(data->info[n].key, keys[i], PMIX_MAX_KEYLEN)) {
-                        /* found it -  delete the object from the data store */
-                        memset(data->info[n].key, 0, PMIX_MAX_KEYLEN + 1);
-                        ++nanswers;
-                    }
-                }
-                /* if all the data has been removed, then remove the object */
-                if (nanswers == data->ninfo) {
-                    pmix_pointer_array_set_item(&prte_data_server_store, k, NULL);
-                    PMIX_RELEASE(data);
-                }
+                /* found it -  delete it from the data store */
+                pmix_list_remove_item(&dk->entries, &ent->super);
+                drop_entry(ent);
             }
+            release_key(uid, keys[i], dk);
         }
         PMIX_ARGV_FREE_COMPAT(keys);
 
@@ -843,8 +1070,7 @@ void prte_data_server(int status, pmix_proc_t *sender,
                 continue;
             }
             /* remove the object */
-            pmix_pointer_array_set_item(&prte_data_server_store, k, NULL);
-            PMIX_RELEASE(data);
+            remove_data(data);
         }
         /* no response is required */
         PMIX_RELEASE(answer);
@@ -41,6 +41,16 @@ BEGIN_C_DECLS
 #define PRTE_PMIX_UNPUBLISH_CMD  0x03
 #define PRTE_PMIX_PURGE_PROC_CMD 0x04
 
+/* if true, the store is spread across the daemons in the DVM by
+ * key hash instead of being held entirely by the HNP, with data
+ * that must outlive its publisher copied to prte_data_server_replicas
+ * additional daemons. A daemon that does not answer its part of a
+ * request within prte_data_server_shard_timeout seconds is treated
+ * as having failed it */
+PRTE_EXPORT extern bool prte_data_server_distributed;
+PRTE_EXPORT extern int prte_data_server_replicas;
+PRTE_EXPORT extern int prte_data_server_shard_timeout;
+
 /* provide hooks to startup and finalize the data server */
 PRTE_EXPORT int prte_data_server_init(void);
 PRTE_EXPORT void prte_data_server_finalize(void);
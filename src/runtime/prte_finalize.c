@@ -44,6 +44,7 @@
 #include "src/runtime/prte_locks.h"
 #include "src/runtime/runtime.h"
 #include "src/util/name_fns.h"
+#include "src/util/nidmap.h"
 #include "src/util/proc_info.h"
 
 int prte_finalize(void)
@@ -91,6 +92,8 @@ int prte_finalize(void)
         PMIX_RELEASE(node);
     }
     PMIX_RELEASE(prte_node_pool);
+    prte_node_index_release();
+    prte_util_nidmap_release();
 
     for (n = 0; n < prte_job_data->size; n++) {
         jdata = (prte_job_t *) pmix_pointer_array_get_item(prte_job_data, n);
@@ -124,6 +127,7 @@ int prte_finalize(void)
         PMIX_RELEASE(jdata);
     }
     PMIX_RELEASE(prte_job_data);
+    prte_job_data_index_release();
 
     for (n = 0; n < prte_node_topologies->size; n++) {
         topo = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, n);
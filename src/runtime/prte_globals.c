@@ -196,11 +196,69 @@ int prte_dt_init(void)
     return PRTE_SUCCESS;
 }
 
-prte_job_t *prte_get_job_data_object(const pmix_nspace_t job)
+/* index of the job data array by nspace - the value is the
+ * position of the job in the array. Jobs are removed from the
+ * array in several places, so an entry is only trusted if the
+ * array still holds that job at that position */
+static pmix_hash_table_t job_index;
+static pmix_pointer_array_t *job_index_array = NULL;
+/* position of the most recent lookup - most lookups are for
+ * the same job as the one before */
+static int job_index_last = -1;
+
+static prte_job_t *job_at(int idx, const pmix_nspace_t job)
+{
+    prte_job_t *jptr;
+
+    jptr = (prte_job_t *) pmix_pointer_array_get_item(prte_job_data, idx);
+    if (NULL != jptr && PMIX_CHECK_NSPACE(jptr->nspace, job)) {
+        return jptr;
+    }
+    return NULL;
+}
+
+/* the index is (re)built whenever the job data array
+ * is not the one it was built from */
+static void check_job_index(void)
 {
     prte_job_t *jptr;
     int i;
 
+    if (job_index_array == prte_job_data) {
+        return;
+    }
+    if (NULL == job_index_array) {
+        PMIX_CONSTRUCT(&job_index, pmix_hash_table_t);
+        pmix_hash_table_init(&job_index, 64);
+    } else {
+        pmix_hash_table_remove_all(&job_index);
+    }
+    job_index_array = prte_job_data;
+    job_index_last = -1;
+    for (i = 0; i < prte_job_data->size; i++) {
+        if (NULL == (jptr = (prte_job_t *) pmix_pointer_array_get_item(prte_job_data, i))) {
+            continue;
+        }
+        pmix_hash_table_set_value_ptr(&job_index, jptr->nspace, strlen(jptr->nspace),
+                                      (void *) (uintptr_t) i);
+    }
+}
+
+void prte_job_data_index_release(void)
+{
+    if (NULL != job_index_array) {
+        PMIX_DESTRUCT(&job_index);
+        job_index_array = NULL;
+        job_index_last = -1;
+    }
+}
+
+prte_job_t *prte_get_job_data_object(const pmix_nspace_t job)
+{
+    prte_job_t *jptr;
+    void *ptr;
+    size_t len;
+
     /* if the job data wasn't setup, we cannot provide the data */
     if (NULL == prte_job_data) {
         return NULL;
@@ -209,22 +267,26 @@ prte_job_t *prte_get_job_data_object(const pmix_nspace_t job)
     if (PMIX_NSPACE_INVALID(job)) {
         return NULL;
     }
-    for (i = 0; i < prte_job_data->size; i++) {
-        if (NULL == (jptr = (prte_job_t *) pmix_pointer_array_get_item(prte_job_data, i))) {
-            continue;
-        }
-        if (PMIX_CHECK_NSPACE(jptr->nspace, job)) {
-            return jptr;
-        }
+    check_job_index();
+
+    if (0 <= job_index_last && NULL != (jptr = job_at(job_index_last, job))) {
+        return jptr;
     }
-    return NULL;
+    len = strnlen(job, PMIX_MAX_NSLEN);
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&job_index, job, len, &ptr)) {
+        return NULL;
+    }
+    if (NULL == (jptr = job_at((int) (uintptr_t) ptr, job))) {
+        /* the job has since been removed from the array */
+        pmix_hash_table_remove_value_ptr(&job_index, job, len);
+        return NULL;
+    }
+    job_index_last = jptr->index;
+    return jptr;
 }
 
 int prte_set_job_data_object(prte_job_t *jdata)
 {
-    prte_job_t *jptr;
-    int i, save = -1;
-
     /* if the job data wasn't setup, we cannot set the data */
     if (NULL == prte_job_data) {
         return PRTE_ERROR;
@@ -234,27 +296,17 @@ int prte_set_job_data_object(prte_job_t *jdata)
         return PRTE_ERROR;
     }
     /* verify that we don't already have this object */
-    for (i = 0; i < prte_job_data->size; i++) {
-        if (NULL == (jptr = (prte_job_t *) pmix_pointer_array_get_item(prte_job_data, i))) {
-            if (0 > save) {
-                save = i;
-            }
-            continue;
-        }
-        if (PMIX_CHECK_NSPACE(jptr->nspace, jdata->nspace)) {
-            return PRTE_EXISTS;
-        }
+    if (NULL != prte_get_job_data_object(jdata->nspace)) {
+        return PRTE_EXISTS;
     }
 
-    if (-1 == save) {
-        jdata->index = pmix_pointer_array_add(prte_job_data, jdata);
-    } else {
-        jdata->index = save;
-        pmix_pointer_array_set_item(prte_job_data, save, jdata);
-    }
+    /* this will fill the first empty slot */
+    jdata->index = pmix_pointer_array_add(prte_job_data, jdata);
     if (0 > jdata->index) {
         return PRTE_ERROR;
     }
+    pmix_hash_table_set_value_ptr(&job_index, jdata->nspace, strlen(jdata->nspace),
+                                  (void *) (uintptr_t) jdata->index);
     return PRTE_SUCCESS;
 }
 
@@ -317,9 +369,144 @@ prte_node_rank_t prte_get_proc_node_rank(const pmix_proc_t *proc)
     return proct->node_rank;
 }
 
+/* index of the node pool by node name and alias - the value is
+ * the position of the node in the pool. As with the job index,
+ * an entry is only trusted if the node at that position still
+ * carries the name */
+static pmix_hash_table_t node_index;
+static pmix_pointer_array_t *node_index_array = NULL;
+
+static bool node_has_name(prte_node_t *nptr, const char *name)
+{
+    int m;
+
+    if (NULL != nptr->name && 0 == strcmp(nptr->name, name)) {
+        return true;
+    }
+    if (NULL != nptr->aliases) {
+        for (m = 0; NULL != nptr->aliases[m]; m++) {
+            if (0 == strcmp(nptr->aliases[m], name)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static prte_node_t *node_at(const char *name)
+{
+    prte_node_t *nptr;
+    void *ptr;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&node_index, name, strlen(name), &ptr)) {
+        return NULL;
+    }
+    nptr = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, (int) (uintptr_t) ptr);
+    if (NULL == nptr || !node_has_name(nptr, name)) {
+        return NULL;
+    }
+    return nptr;
+}
+
+static void index_name(const char *name, int idx)
+{
+    /* nodes can be duplicated (e.g., when simulating large
+     * clusters), so leave the first one in place */
+    if (NULL != node_at(name)) {
+        return;
+    }
+    pmix_hash_table_set_value_ptr(&node_index, name, strlen(name), (void *) (uintptr_t) idx);
+}
+
+static void add_node_names(prte_node_t *nptr, int idx)
+{
+    int m;
+
+    if (NULL != nptr->name) {
+        index_name(nptr->name, idx);
+    }
+    if (NULL != nptr->aliases) {
+        for (m = 0; NULL != nptr->aliases[m]; m++) {
+            index_name(nptr->aliases[m], idx);
+        }
+    }
+}
+
+static void check_node_index(void)
+{
+    prte_node_t *nptr;
+    int i;
+
+    if (node_index_array == prte_node_pool) {
+        return;
+    }
+    if (NULL == node_index_array) {
+        PMIX_CONSTRUCT(&node_index, pmix_hash_table_t);
+        pmix_hash_table_init(&node_index, 1024);
+    } else {
+        pmix_hash_table_remove_all(&node_index);
+    }
+    node_index_array = prte_node_pool;
+    for (i = 0; i < prte_node_pool->size; i++) {
+        if (NULL != (nptr = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, i))) {
+            add_node_names(nptr, i);
+        }
+    }
+}
+
+void prte_node_index(prte_node_t *node)
+{
+    if (NULL == prte_node_pool || 0 > node->index) {
+        return;
+    }
+    check_node_index();
+    add_node_names(node, node->index);
+}
+
+void prte_node_index_release(void)
+{
+    if (NULL != node_index_array) {
+        PMIX_DESTRUCT(&node_index);
+        node_index_array = NULL;
+    }
+}
+
+prte_node_t *prte_node_lookup(const char *name)
+{
+    if (NULL == prte_node_pool || NULL == name) {
+        return NULL;
+    }
+    check_node_index();
+    return node_at(name);
+}
+
+prte_node_t *prte_node_pool_match(prte_node_t *node)
+{
+    prte_node_t *nptr;
+    int m;
+
+    if (NULL == prte_node_pool) {
+        return NULL;
+    }
+    check_node_index();
+    /* any match must involve one of the names of the
+     * given node, so just check each of them */
+    if (NULL != (nptr = node_at(node->name)) && prte_nptr_match(nptr, node)) {
+        return nptr;
+    }
+    if (NULL != node->aliases) {
+        for (m = 0; NULL != node->aliases[m]; m++) {
+            if (NULL != (nptr = node_at(node->aliases[m])) && prte_nptr_match(nptr, node)) {
+                return nptr;
+            }
+        }
+    }
+    return NULL;
+}
+
 prte_node_t* prte_node_match(pmix_list_t *nodes, const char *name)
 {
-    int m, n;
+    int m;
     prte_node_t *nptr;
     char *nm;
 
@@ -348,24 +535,11 @@ prte_node_t* prte_node_match(pmix_list_t *nodes, const char *name)
         }
     } else {
         /* check the node pool */
-        for (n=0; n < prte_node_pool->size; n++) {
-            nptr = (prte_node_t*)pmix_pointer_array_get_item(prte_node_pool, n);
-            if (NULL == nptr) {
-                continue;
-            }
-            if (0 == strcmp(nptr->name, nm)) {
-                return nptr;
-            }
-            if (NULL == nptr->aliases) {
-                continue;
-            }
-            /* no choice but an exhaustive search - fortunately, these lists are short! */
-            for (m = 0; NULL != nptr->aliases[m]; m++) {
-                if (0 == strcmp(name, nptr->aliases[m])) {
-                    /* this is the node! */
-                    return nptr;
-                }
-            }
+        if (NULL != (nptr = prte_node_lookup(nm))) {
+            return nptr;
+        }
+        if (nm != name) {
+            return prte_node_lookup(name);
         }
     }
 
@@ -420,7 +594,7 @@ static void prte_app_context_construct(prte_app_context_t *app_context)
     app_context->env = NULL;
     app_context->cwd = NULL;
     app_context->flags = 0;
-    PMIX_CONSTRUCT(&app_context->attributes, pmix_list_t);
+    PRTE_ATTR_LIST_CONSTRUCT(&app_context->attributes);
     PMIX_CONSTRUCT(&app_context->cli, pmix_cli_result_t);
 }
 
@@ -457,7 +631,7 @@ static void prte_app_context_destructor(prte_app_context_t *app_context)
         app_context->cwd = NULL;
     }
 
-    PMIX_LIST_DESTRUCT(&app_context->attributes);
+    PRTE_ATTR_LIST_DESTRUCT(&app_context->attributes);
     PMIX_DESTRUCT(&app_context->cli);
 }
 
@@ -499,7 +673,7 @@ static void prte_job_construct(prte_job_t *job)
     job->flags = 0;
     PRTE_FLAG_SET(job, PRTE_JOB_FLAG_FORWARD_OUTPUT);
 
-    PMIX_CONSTRUCT(&job->attributes, pmix_list_t);
+    PRTE_ATTR_LIST_CONSTRUCT(&job->attributes);
     PMIX_DATA_BUFFER_CONSTRUCT(&job->launch_msg);
     PMIX_CONSTRUCT(&job->children, pmix_list_t);
     PMIX_LOAD_NSPACE(job->launcher, NULL);
@@ -576,7 +750,7 @@ static void prte_job_destruct(prte_job_t *job)
     PMIX_RELEASE(job->procs);
 
     /* release the attributes */
-    PMIX_LIST_DESTRUCT(&job->attributes);
+    PRTE_ATTR_LIST_DESTRUCT(&job->attributes);
 
     PMIX_DATA_BUFFER_DESTRUCT(&job->launch_msg);
 
@@ -599,6 +773,9 @@ static void prte_job_destruct(prte_job_t *job)
     if (NULL != prte_job_data && 0 <= job->index) {
         /* remove the job from the global array */
         pmix_pointer_array_set_item(prte_job_data, job->index, NULL);
+        if (job_index_array == prte_job_data) {
+            pmix_hash_table_remove_value_ptr(&job_index, job->nspace, strlen(job->nspace));
+        }
     }
     if (NULL != job->traces) {
         PMIX_ARGV_FREE_COMPAT(job->traces);
@@ -635,7 +812,7 @@ static void prte_node_construct(prte_node_t *node)
     node->topology = NULL;
 
     node->flags = 0;
-    PMIX_CONSTRUCT(&node->attributes, pmix_list_t);
+    PRTE_ATTR_LIST_CONSTRUCT(&node->attributes);
 }
 
 static void prte_node_destruct(prte_node_t *node)
@@ -677,12 +854,52 @@ static void prte_node_destruct(prte_node_t *node)
     /* do NOT destroy the topology */
 
     /* release the attributes */
-    PMIX_LIST_DESTRUCT(&node->attributes);
+    PRTE_ATTR_LIST_DESTRUCT(&node->attributes);
 }
 
 PMIX_CLASS_INSTANCE(prte_node_t, pmix_list_item_t,
                     prte_node_construct, prte_node_destruct);
 
+/* index of the node topologies by signature - as with the job
+ * index, an entry is checked against the array before use */
+static pmix_hash_table_t topo_index;
+static bool topo_index_init = false;
+
+prte_topology_t *prte_topology_lookup(const char *sig)
+{
+    prte_topology_t *t;
+    void *ptr;
+    size_t len;
+    int i;
+
+    if (NULL == prte_node_topologies || NULL == sig) {
+        return NULL;
+    }
+    if (!topo_index_init) {
+        PMIX_CONSTRUCT(&topo_index, pmix_hash_table_t);
+        pmix_hash_table_init(&topo_index, 16);
+        topo_index_init = true;
+    }
+    len = strlen(sig);
+    if (PMIX_SUCCESS == pmix_hash_table_get_value_ptr(&topo_index, sig, len, &ptr)) {
+        t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies,
+                                                            (int) (uintptr_t) ptr);
+        if (NULL != t && NULL != t->sig && 0 == strcmp(t->sig, sig)) {
+            return t;
+        }
+    }
+    /* topologies are added in several places, so fall back
+     * to a search and remember what we find */
+    for (i = 0; i < prte_node_topologies->size; i++) {
+        t = (prte_topology_t *) pmix_pointer_array_get_item(prte_node_topologies, i);
+        if (NULL != t && NULL != t->sig && 0 == strcmp(t->sig, sig)) {
+            pmix_hash_table_set_value_ptr(&topo_index, sig, len, (void *) (uintptr_t) i);
+            return t;
+        }
+    }
+    return NULL;
+}
+
 static void prte_proc_construct(prte_proc_t *proc)
 {
     proc->name = *PRTE_NAME_INVALID;
@@ -701,7 +918,7 @@ static void prte_proc_construct(prte_proc_t *proc)
     proc->exit_code = 0; /* Assume we won't fail unless otherwise notified */
     proc->rml_uri = NULL;
     proc->flags = 0;
-    PMIX_CONSTRUCT(&proc->attributes, pmix_list_t);
+    PRTE_ATTR_LIST_CONSTRUCT(&proc->attributes);
 }
 
 static void prte_proc_destruct(prte_proc_t *proc)
@@ -719,7 +936,7 @@ static void prte_proc_destruct(prte_proc_t *proc)
         proc->rml_uri = NULL;
     }
 
-    PMIX_LIST_DESTRUCT(&proc->attributes);
+    PRTE_ATTR_LIST_DESTRUCT(&proc->attributes);
 }
 
 PMIX_CLASS_INSTANCE(prte_proc_t, pmix_list_item_t,
@@ -764,19 +981,6 @@ static void prte_job_map_destruct(prte_job_map_t *map)
 PMIX_CLASS_INSTANCE(prte_job_map_t, pmix_object_t,
                     prte_job_map_construct, prte_job_map_destruct);
 
-static void prte_attr_cons(prte_attribute_t *p)
-{
-    p->key = 0;
-    p->local = true; // default to local-only data
-    memset(&p->data, 0, sizeof(p->data));
-}
-static void prte_attr_des(prte_attribute_t *p)
-{
-    PMIX_VALUE_DESTRUCT(&p->data);
-}
-PMIX_CLASS_INSTANCE(prte_attribute_t, pmix_list_item_t,
-                    prte_attr_cons, prte_attr_des);
-
 static void tcon(prte_topology_t *t)
 {
     t->topo = NULL;
@@ -242,7 +242,7 @@ typedef struct {
      * flexibility without constantly expanding the memory footprint
      * every time we want some new (rarely used) option
      */
-    pmix_list_t attributes;
+    prte_attr_list_t attributes;
     // store the result of parsing this app's cmd line
     pmix_cli_result_t cli;
 } prte_app_context_t;
@@ -301,7 +301,7 @@ typedef struct {
     /* flags */
     prte_node_flags_t flags;
     /* list of prte_attribute_t */
-    pmix_list_t attributes;
+    prte_attr_list_t attributes;
 } prte_node_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_node_t);
 
@@ -362,7 +362,7 @@ typedef struct {
     /* flags */
     prte_job_flags_t flags;
     /* attributes */
-    pmix_list_t attributes;
+    prte_attr_list_t attributes;
     /* launch msg buffer */
     pmix_data_buffer_t launch_msg;
     /* track children of this job */
@@ -429,7 +429,7 @@ struct prte_proc_t {
     /* some boolean flags */
     prte_proc_flags_t flags;
     /* list of prte_value_t attributes */
-    pmix_list_t attributes;
+    prte_attr_list_t attributes;
 };
 typedef struct prte_proc_t prte_proc_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_proc_t);
@@ -450,9 +450,18 @@ PRTE_EXPORT prte_job_t *prte_get_job_data_object(const pmix_nspace_t job);
  */
 PRTE_EXPORT int prte_set_job_data_object(prte_job_t *jdata);
 
+/**
+ * Release the nspace index of the job data array
+ */
+PRTE_EXPORT void prte_job_data_index_release(void);
+
 /** Pack/unpack a job object */
 PRTE_EXPORT int prte_job_pack(pmix_data_buffer_t *bkt, prte_job_t *job);
 PRTE_EXPORT int prte_job_unpack(pmix_data_buffer_t *bkt, prte_job_t **job);
+/* the launch message packs the procs of a job as run-length
+ * encoded columns - only the launch path uses this form */
+PRTE_EXPORT int prte_job_pack_launch(pmix_data_buffer_t *bkt, prte_job_t *job);
+PRTE_EXPORT int prte_job_unpack_launch(pmix_data_buffer_t *bkt, prte_job_t **job);
 PRTE_EXPORT int prte_job_copy(prte_job_t **dest, prte_job_t *src);
 PRTE_EXPORT void prte_job_print(char **output, prte_job_t *jdata);
 
@@ -495,10 +504,23 @@ PRTE_EXPORT char *prte_get_proc_hostname(const pmix_proc_t *proc);
 /* get the node rank of a proc */
 PRTE_EXPORT prte_node_rank_t prte_get_proc_node_rank(const pmix_proc_t *proc);
 
+/* find a node topology by its signature */
+PRTE_EXPORT prte_topology_t *prte_topology_lookup(const char *sig);
+
 /* check to see if two nodes match */
 PRTE_EXPORT prte_node_t* prte_node_match(pmix_list_t *nodes, const char *name);
 PRTE_EXPORT bool prte_nptr_match(prte_node_t *n1, prte_node_t *n2);
 
+/* the node pool is indexed by node name and alias - the
+ * index must be updated whenever a node is placed in the
+ * pool or given a new name or alias */
+PRTE_EXPORT void prte_node_index(prte_node_t *node);
+PRTE_EXPORT void prte_node_index_release(void);
+/* find a node in the pool by name or alias */
+PRTE_EXPORT prte_node_t *prte_node_lookup(const char *name);
+/* find the node in the pool that matches the given node */
+PRTE_EXPORT prte_node_t *prte_node_pool_match(prte_node_t *node);
+
 /* global variables used by RTE - instanced in prte_globals.c */
 PRTE_EXPORT extern bool prte_debug_daemons_flag;
 PRTE_EXPORT extern bool prte_debug_daemons_file_flag;
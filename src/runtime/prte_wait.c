@@ -50,7 +50,11 @@
 #ifdef HAVE_SYS_WAIT_H
 #    include <sys/wait.h>
 #endif
+#ifdef __linux__
+#    include <sys/syscall.h>
+#endif
 
+#include "src/class/pmix_hash_table.h"
 #include "src/class/pmix_list.h"
 #include "src/class/pmix_object.h"
 #include "src/event/event-internal.h"
@@ -65,6 +69,12 @@
 
 #include "src/runtime/prte_wait.h"
 
+#if defined(SYS_pidfd_open) && defined(HAVE_SYS_WAIT_H)
+#    define PRTE_WAIT_HAVE_PIDFD 1
+#else
+#    define PRTE_WAIT_HAVE_PIDFD 0
+#endif
+
 /* Timer Object Declaration */
 static void timer_const(prte_timer_t *tm)
 {
@@ -83,9 +93,15 @@ static void wccon(prte_wait_tracker_t *p)
     p->child = NULL;
     p->cbfunc = NULL;
     p->cbdata = NULL;
+    p->pid = 0;
+    p->pidfd = -1;
 }
 static void wcdes(prte_wait_tracker_t *p)
 {
+    if (0 <= p->pidfd) {
+        prte_event_del(&p->pidev);
+        close(p->pidfd);
+    }
     if (NULL != p->child) {
         PMIX_RELEASE(p->child);
     }
@@ -95,7 +111,13 @@ PMIX_CLASS_INSTANCE(prte_wait_tracker_t, pmix_list_item_t,
 
 /* Local Variables */
 static prte_event_t handler;
-static pmix_list_t pending_cbs;
+/* pending callbacks, indexed by the address of the proc
+ * object and, once it is known, by the pid of the proc */
+static pmix_hash_table_t by_child;
+static pmix_hash_table_t by_pid;
+#if PRTE_WAIT_HAVE_PIDFD
+static bool use_pidfd = true;
+#endif
 
 /* Local Function Prototypes */
 static void wait_signal_callback(int fd, short event, void *arg);
@@ -114,7 +136,10 @@ void prte_wait_enable(void)
 
 int prte_wait_init(void)
 {
-    PMIX_CONSTRUCT(&pending_cbs, pmix_list_t);
+    PMIX_CONSTRUCT(&by_child, pmix_hash_table_t);
+    pmix_hash_table_init(&by_child, 256);
+    PMIX_CONSTRUCT(&by_pid, pmix_hash_table_t);
+    pmix_hash_table_init(&by_pid, 256);
 
     prte_event_set(prte_event_base, &handler, SIGCHLD,
                    PRTE_EV_SIGNAL | PRTE_EV_PERSIST,
@@ -126,14 +151,117 @@ int prte_wait_init(void)
 
 int prte_wait_finalize(void)
 {
+    prte_wait_tracker_t *t2;
+    void *key;
+    size_t len;
+
     prte_event_del(&handler);
 
     /* clear out the pending cbs */
-    PMIX_LIST_DESTRUCT(&pending_cbs);
+    for (void *_nptr = NULL;
+         PMIX_SUCCESS == pmix_hash_table_get_next_key_ptr(&by_child, &key, &len,
+                                                          (void **) &t2, _nptr, &_nptr);) {
+        PMIX_RELEASE(t2);
+    }
+    PMIX_DESTRUCT(&by_child);
+    PMIX_DESTRUCT(&by_pid);
 
     return PRTE_SUCCESS;
 }
 
+static prte_wait_tracker_t *lookup(prte_proc_t *child)
+{
+    prte_wait_tracker_t *t2;
+
+    if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&by_child, &child, sizeof(child),
+                                                      (void **) &t2)) {
+        return NULL;
+    }
+    return t2;
+}
+
+/* stop tracking the given proc */
+static void untrack(prte_wait_tracker_t *t2)
+{
+    prte_proc_t *child = t2->child;
+
+    pmix_hash_table_remove_value_ptr(&by_child, &child, sizeof(child));
+    if (0 < t2->pid) {
+        pmix_hash_table_remove_value_uint32(&by_pid, (uint32_t) t2->pid);
+    }
+    if (0 <= t2->pidfd) {
+        prte_event_del(&t2->pidev);
+        close(t2->pidfd);
+        t2->pidfd = -1;
+    }
+}
+
+/* the proc has terminated - execute the callback */
+static void complete(prte_wait_tracker_t *t2, int status)
+{
+    t2->child->exit_code = status;
+    untrack(t2);
+    if (NULL != t2->cbfunc) {
+        prte_event_set(prte_event_base, &t2->ev, -1, PRTE_EV_WRITE, t2->cbfunc, t2);
+        prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
+    } else {
+        PMIX_RELEASE(t2);
+    }
+}
+
+#if PRTE_WAIT_HAVE_PIDFD
+/* callback from the event library when a child's pidfd
+ * becomes readable, indicating that it has terminated */
+static void pidfd_callback(int fd, short event, void *arg)
+{
+    prte_wait_tracker_t *t2 = (prte_wait_tracker_t *) arg;
+    int status;
+    pid_t pid;
+    PRTE_HIDE_UNUSED_PARAMS(fd, event);
+
+    PMIX_ACQUIRE_OBJECT(t2);
+
+    do {
+        pid = waitpid(t2->pid, &status, WNOHANG);
+    } while (-1 == pid && EINTR == errno);
+
+    if (pid == t2->pid) {
+        complete(t2, status);
+    } else if (0 == pid) {
+        /* not ready after all - keep watching */
+        prte_event_add(&t2->pidev, NULL);
+    }
+    /* otherwise, the SIGCHLD handler got to it first */
+}
+#endif
+
+/* index the tracker by the pid of its proc and, if we can,
+ * watch for its termination directly */
+static void attach_pid(prte_wait_tracker_t *t2)
+{
+    if (0 != t2->pid || t2->child->pid <= 0) {
+        return;
+    }
+    t2->pid = t2->child->pid;
+    pmix_hash_table_set_value_uint32(&by_pid, (uint32_t) t2->pid, t2);
+
+#if PRTE_WAIT_HAVE_PIDFD
+    if (use_pidfd) {
+        t2->pidfd = (int) syscall(SYS_pidfd_open, t2->pid, 0);
+        if (0 > t2->pidfd) {
+            if (ENOSYS == errno) {
+                /* not supported by this kernel - don't try again */
+                use_pidfd = false;
+            }
+            return;
+        }
+        prte_event_set(prte_event_base, &t2->pidev, t2->pidfd, PRTE_EV_READ,
+                       pidfd_callback, t2);
+        prte_event_add(&t2->pidev, NULL);
+    }
+#endif
+}
+
 /* this function *must* always be called from
  * within an event in the prte_event_base */
 void prte_wait_cb(prte_proc_t *child,
@@ -164,13 +292,10 @@ void prte_wait_cb(prte_proc_t *child,
     }
 
     /* we just override any existing registration */
-    PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-    {
-        if (t2->child == child) {
-            t2->cbfunc = callback;
-            t2->cbdata = data;
-            return;
-        }
+    if (NULL != (t2 = lookup(child))) {
+        t2->cbfunc = callback;
+        t2->cbdata = data;
+        return;
     }
     /* get here if this is a new registration */
     t2 = PMIX_NEW(prte_wait_tracker_t);
@@ -178,7 +303,40 @@ void prte_wait_cb(prte_proc_t *child,
     t2->child = child;
     t2->cbfunc = callback;
     t2->cbdata = data;
-    pmix_list_append(&pending_cbs, &t2->super);
+    pmix_hash_table_set_value_ptr(&by_child, &child, sizeof(child), t2);
+    /* the pid may already be known */
+    attach_pid(t2);
+}
+
+static void track_callback(int fd, short args, void *cbdata)
+{
+    prte_wait_tracker_t *trk = (prte_wait_tracker_t *) cbdata;
+    prte_wait_tracker_t *t2;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(trk);
+
+    if (NULL != (t2 = lookup(trk->child))) {
+        attach_pid(t2);
+    }
+    PMIX_RELEASE(trk);
+}
+
+void prte_wait_track(prte_proc_t *child)
+{
+    prte_wait_tracker_t *trk;
+
+    if (NULL == child) {
+        /* bozo protection */
+        PRTE_ERROR_LOG(PRTE_ERR_BAD_PARAM);
+        return;
+    }
+
+    /* push this into the event library for handling */
+    trk = PMIX_NEW(prte_wait_tracker_t);
+    PMIX_RETAIN(child); // protect against race conditions
+    trk->child = child;
+    PRTE_PMIX_THREADSHIFT(trk, prte_event_base, track_callback);
 }
 
 static void cancel_callback(int fd, short args, void *cbdata)
@@ -189,14 +347,9 @@ static void cancel_callback(int fd, short args, void *cbdata)
 
     PMIX_ACQUIRE_OBJECT(trk);
 
-    PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-    {
-        if (t2->child == trk->child) {
-            pmix_list_remove_item(&pending_cbs, &t2->super);
-            PMIX_RELEASE(t2);
-            PMIX_RELEASE(trk);
-            return;
-        }
+    if (NULL != (t2 = lookup(trk->child))) {
+        untrack(t2);
+        PMIX_RELEASE(t2);
     }
 
     PMIX_RELEASE(trk);
@@ -226,6 +379,8 @@ static void wait_signal_callback(int fd, short event, void *arg)
     int status;
     pid_t pid;
     prte_wait_tracker_t *t2;
+    void *key;
+    size_t len;
     PRTE_HIDE_UNUSED_PARAMS(fd, event);
 
     PMIX_ACQUIRE_OBJECT(signal);
@@ -248,19 +403,20 @@ static void wait_signal_callback(int fd, short event, void *arg)
             return;
         }
 
-        /* we are already in an event, so it is safe to access the list */
-        PMIX_LIST_FOREACH(t2, &pending_cbs, prte_wait_tracker_t)
-        {
+        /* we are already in an event, so it is safe to access the tables */
+        if (PMIX_SUCCESS == pmix_hash_table_get_value_uint32(&by_pid, (uint32_t) pid,
+                                                             (void **) &t2)) {
+            complete(t2, status);
+            continue;
+        }
+        /* the proc may have terminated before we were told
+         * its pid, so we have to look for it */
+        for (void *_nptr = NULL;
+             PMIX_SUCCESS == pmix_hash_table_get_next_key_ptr(&by_child, &key, &len,
+                                                              (void **) &t2, _nptr, &_nptr);) {
             if (pid == t2->child->pid) {
                 /* found it! */
-                t2->child->exit_code = status;
-                pmix_list_remove_item(&pending_cbs, &t2->super);
-                if (NULL != t2->cbfunc) {
-                    prte_event_set(prte_event_base, &t2->ev, -1, PRTE_EV_WRITE, t2->cbfunc, t2);
-                    prte_event_active(&t2->ev, PRTE_EV_WRITE, 1);
-                } else {
-                    PMIX_RELEASE(t2);
-                }
+                complete(t2, status);
                 break;
             }
         }
@@ -66,6 +66,12 @@ typedef struct {
     prte_proc_t *child;
     prte_wait_cbfunc_t cbfunc;
     void *cbdata;
+    /* pid we are indexed under, once known */
+    pid_t pid;
+    /* where supported, a pidfd for the child whose
+     * event fires when the child terminates */
+    int pidfd;
+    prte_event_t pidev;
 } prte_wait_tracker_t;
 PRTE_EXPORT PMIX_CLASS_DECLARATION(prte_wait_tracker_t);
 
@@ -91,6 +97,16 @@ PRTE_EXPORT void prte_wait_cb(prte_proc_t *proc,
 
 PRTE_EXPORT void prte_wait_cb_cancel(prte_proc_t *proc);
 
+/**
+ * Indicate that the pid of a process registered with prte_wait_cb
+ * is now known. The callback can then be located directly when the
+ * process terminates and, where supported, the termination is
+ * detected through a pidfd instead of waiting for SIGCHLD. Not
+ * required if the pid was set when the callback was registered.
+ * May be called from any thread.
+ */
+PRTE_EXPORT void prte_wait_track(prte_proc_t *proc);
+
 /* In a few places, we need to barrier until something happens
  * that changes a flag to indicate we can release - e.g., waiting
  * for a specific message to arrive. If no progress thread is running,
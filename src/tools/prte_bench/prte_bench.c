@@ -0,0 +1,464 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Microbenchmark for the launch path. Starts a DVM on a simulated
+ * allocation (see the ras/simulator component), submits a single job
+ * to it, and times each of the steps the DVM performs to get that job
+ * ready for launch. No daemons or procs are actually started, so very
+ * large configurations can be exercised on a single machine.
+ */
+
+#include "prte_config.h"
+#include "src/include/constants.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif /* HAVE_SYS_TIME_H */
+#include <sys/resource.h>
+
+#include "src/event/event-internal.h"
+#include "src/mca/base/pmix_base.h"
+#include "src/pmix/pmix-internal.h"
+#include "src/util/pmix_argv.h"
+#include "src/util/pmix_basename.h"
+
+#include "src/hwloc/hwloc-internal.h"
+#include "src/mca/errmgr/errmgr.h"
+#include "src/mca/odls/base/base.h"
+#include "src/mca/plm/plm.h"
+#include "src/mca/rmaps/base/base.h"
+#include "src/mca/schizo/base/base.h"
+#include "src/mca/state/state.h"
+#include "src/prted/pmix/pmix_server.h"
+#include "src/runtime/prte_globals.h"
+#include "src/runtime/runtime.h"
+#include "src/util/nidmap.h"
+
+typedef struct {
+    const char *name;
+    double secs;
+    bool have_rss;
+    long rss;
+    long maxrss;
+    size_t bytes;
+} bench_phase_t;
+
+#define BENCH_MAX_PHASES 8
+
+static bench_phase_t phases[BENCH_MAX_PHASES];
+static int nphases = 0;
+static bool mapped = false;
+static bool map_failed = false;
+static long start_rss = -1;
+
+static struct option longopts[] = {
+    {"nodes", required_argument, NULL, 'n'},
+    {"slots", required_argument, NULL, 's'},
+    {"np", required_argument, NULL, 'p'},
+    {"map-by", required_argument, NULL, 'm'},
+    {"rank-by", required_argument, NULL, 'r'},
+    {"bind-to", required_argument, NULL, 'b'},
+    {"topo", required_argument, NULL, 't'},
+    {"help", no_argument, NULL, 'h'},
+    {NULL, 0, NULL, 0}
+};
+
+static void usage(const char *cmd)
+{
+    fprintf(stderr,
+            "Usage: %s --nodes N[,N...] [options]\n"
+            "  -n|--nodes <list>   Number of nodes to simulate for each topology\n"
+            "  -s|--slots <list>   Number of slots on each simulated node [1]\n"
+            "  -p|--np <n>         Number of procs to map [one per slot]\n"
+            "  -m|--map-by <spec>  Mapping policy\n"
+            "  -r|--rank-by <spec> Ranking policy\n"
+            "  -b|--bind-to <spec> Binding policy\n"
+            "  -t|--topo <file>    Topology XML file to use for every node\n",
+            cmd);
+}
+
+static double now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (double) tv.tv_sec + (double) tv.tv_usec / 1000000.0;
+}
+
+/* current resident set size in KB, or -1 if it cannot be
+ * determined. ru_maxrss only reports the high-water mark, so
+ * it cannot show what an individual phase allocated */
+static long current_rss(void)
+{
+    FILE *fp;
+    unsigned long size, resident;
+    long rss = -1;
+
+    if (NULL == (fp = fopen("/proc/self/statm", "r"))) {
+        return -1;
+    }
+    if (2 == fscanf(fp, "%lu %lu", &size, &resident)) {
+        rss = (long) (resident * (unsigned long) sysconf(_SC_PAGESIZE) / 1024);
+    }
+    fclose(fp);
+    return rss;
+}
+
+static void begin(double *start)
+{
+    start_rss = current_rss();
+    *start = now();
+}
+
+static void record_secs(const char *name, double secs, bool have_rss, size_t bytes)
+{
+    struct rusage ru;
+    long rss;
+
+    if (BENCH_MAX_PHASES <= nphases) {
+        return;
+    }
+    rss = current_rss();
+    getrusage(RUSAGE_SELF, &ru);
+    phases[nphases].name = name;
+    phases[nphases].secs = secs;
+    phases[nphases].have_rss = have_rss && 0 <= start_rss && 0 <= rss;
+    phases[nphases].rss = rss - start_rss;
+    phases[nphases].maxrss = ru.ru_maxrss;
+    phases[nphases].bytes = bytes;
+    ++nphases;
+}
+
+static void record(const char *name, double start, size_t bytes)
+{
+    record_secs(name, now() - start, true, bytes);
+}
+
+/* time the mapper. Binding is performed as each proc is placed,
+ * so it is included here, but the mappers compute the vpids in
+ * a separate step at the end - time that on its own */
+static void bench_map(int fd, short args, void *cbdata)
+{
+    double start, secs;
+
+    prte_rmaps_base.rank_time = 0.0;
+    begin(&start);
+    prte_rmaps_base_map_job(fd, args, cbdata);
+    secs = now() - start;
+    /* the memory used by ranking cannot be separated from
+     * that used by the mapper, so it is all reported here */
+    record_secs("map", secs - prte_rmaps_base.rank_time, true, 0);
+    record_secs("rank", prte_rmaps_base.rank_time, false, 0);
+}
+
+/* report what the job's proc objects cost the HNP. Each proc
+ * holds its own copy of its cpuset string, so also show what
+ * the strings would cost if procs bound to the same cpus
+ * shared one copy */
+static void proc_table_summary(prte_job_t *jdata)
+{
+    pmix_hash_table_t seen;
+    prte_proc_t *proc;
+    void *ptr;
+    size_t nprocs = 0, ndistinct = 0, cpubytes = 0, sharedbytes = 0, len;
+    int n;
+
+    PMIX_CONSTRUCT(&seen, pmix_hash_table_t);
+    pmix_hash_table_init(&seen, 64);
+    for (n = 0; n < jdata->procs->size; n++) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(jdata->procs, n);
+        if (NULL == proc) {
+            continue;
+        }
+        ++nprocs;
+        if (NULL == proc->cpuset) {
+            continue;
+        }
+        len = strlen(proc->cpuset) + 1;
+        cpubytes += len;
+        if (PMIX_SUCCESS != pmix_hash_table_get_value_ptr(&seen, proc->cpuset, len, &ptr)) {
+            pmix_hash_table_set_value_ptr(&seen, proc->cpuset, len, proc);
+            sharedbytes += len;
+            ++ndistinct;
+        }
+    }
+    PMIX_DESTRUCT(&seen);
+
+    fprintf(stdout, "proc objects: %lu x %lu bytes = %lu KB  (name %lu, object header %lu)\n",
+            (unsigned long) nprocs, (unsigned long) sizeof(prte_proc_t),
+            (unsigned long) (nprocs * sizeof(prte_proc_t) / 1024),
+            (unsigned long) sizeof(pmix_proc_t), (unsigned long) sizeof(pmix_list_item_t));
+    fprintf(stdout, "cpuset strings: %lu distinct, %lu KB stored vs %lu KB if shared\n",
+            (unsigned long) ndistinct, (unsigned long) (cpubytes / 1024),
+            (unsigned long) (sharedbytes / 1024));
+}
+
+/* stop the state machine once the job has been mapped - we
+ * drive the remaining steps ourselves */
+static void bench_mapped(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+    mapped = true;
+    PMIX_RELEASE(caddy);
+}
+
+/* the mapper could not place the job - stop waiting for it */
+static void bench_map_failed(int fd, short args, void *cbdata)
+{
+    prte_state_caddy_t *caddy = (prte_state_caddy_t *) cbdata;
+    PRTE_HIDE_UNUSED_PARAMS(fd, args);
+
+    PMIX_ACQUIRE_OBJECT(caddy);
+    map_failed = true;
+    PMIX_RELEASE(caddy);
+}
+
+static void opcbfunc(pmix_status_t status, void *cbdata)
+{
+    prte_pmix_lock_t *lk = (prte_pmix_lock_t *) cbdata;
+
+    PMIX_POST_OBJECT(lk);
+    lk->status = prte_pmix_convert_status(status);
+    PRTE_PMIX_WAKEUP_THREAD(lk);
+}
+
+int main(int argc, char **argv)
+{
+    int rc, opt, np = 0;
+    char *nodes = NULL, *slots = NULL, *mapby = NULL, *rankby = NULL;
+    char *bindto = NULL, *topo = NULL;
+    char **pargv = NULL;
+    int pargc = 1;
+    double start;
+    prte_job_t *daemons, *jdata;
+    prte_app_context_t *app;
+    pmix_data_buffer_t buf;
+    prte_pmix_lock_t lock;
+    int n;
+
+    while (-1 != (opt = getopt_long(argc, argv, "n:s:p:m:r:b:t:h", longopts, NULL))) {
+        switch (opt) {
+        case 'n':
+            nodes = optarg;
+            break;
+        case 's':
+            slots = optarg;
+            break;
+        case 'p':
+            np = strtol(optarg, NULL, 10);
+            break;
+        case 'm':
+            mapby = optarg;
+            break;
+        case 'r':
+            rankby = optarg;
+            break;
+        case 'b':
+            bindto = optarg;
+            break;
+        case 't':
+            topo = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+    if (NULL == nodes) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /* point the simulator at the requested allocation */
+    setenv("PRTE_MCA_ras_simulator_num_nodes", nodes, true);
+    if (NULL != slots) {
+        setenv("PRTE_MCA_ras_simulator_slots", slots, true);
+    }
+    if (NULL != topo) {
+        setenv("PRTE_MCA_hwloc_use_topo_file", topo, true);
+    }
+
+    /* the schizo components look at the tool name */
+    prte_tool_basename = pmix_basename(argv[0]);
+
+    rc = prte_init_minimum();
+    if (PRTE_SUCCESS != rc) {
+        return rc;
+    }
+    prte_init_util(PRTE_PROC_MASTER);
+    rc = prte_event_base_open();
+    if (PRTE_SUCCESS != rc) {
+        fprintf(stderr, "Unable to initialize event library\n");
+        return rc;
+    }
+    rc = pmix_mca_base_framework_open(&prte_schizo_base_framework,
+                                      PMIX_MCA_BASE_OPEN_DEFAULT);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    if (PRTE_SUCCESS != (rc = prte_schizo_base_select())) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&pargv, argv[0]);
+    begin(&start);
+    if (PRTE_SUCCESS != (rc = prte_init(&pargc, &pargv, PRTE_PROC_MASTER))) {
+        PRTE_ERROR_LOG(rc);
+        return rc;
+    }
+    record("init", start, 0);
+
+    /* bring up the (simulated) DVM */
+    if (NULL == (daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace))) {
+        PRTE_ERROR_LOG(PRTE_ERR_NOT_FOUND);
+        rc = PRTE_ERR_NOT_FOUND;
+        goto done;
+    }
+    begin(&start);
+    PRTE_ACTIVATE_JOB_STATE(daemons, PRTE_JOB_STATE_ALLOCATE);
+    while (prte_event_base_active && !prte_dvm_ready) {
+        prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
+    }
+    if (!prte_dvm_ready) {
+        fprintf(stderr, "%s: DVM failed to start\n", argv[0]);
+        rc = PRTE_ERR_FATAL;
+        goto done;
+    }
+    record("dvm", start, 0);
+
+    /* intercept the state machine around the mapper */
+    prte_state.set_job_state_callback(PRTE_JOB_STATE_MAP, bench_map);
+    prte_state.set_job_state_callback(PRTE_JOB_STATE_MAP_COMPLETE, bench_mapped);
+    if (PRTE_SUCCESS != prte_state.set_job_state_callback(PRTE_JOB_STATE_MAP_FAILED,
+                                                          bench_map_failed)) {
+        prte_state.add_job_state(PRTE_JOB_STATE_MAP_FAILED, bench_map_failed);
+    }
+
+    /* setup the job */
+    jdata = PMIX_NEW(prte_job_t);
+    jdata->map = PMIX_NEW(prte_job_map_t);
+    PMIX_LOAD_PROCID(&jdata->originator, PRTE_PROC_MY_NAME->nspace, PRTE_PROC_MY_NAME->rank);
+    jdata->schizo = (struct prte_schizo_base_module_t *) prte_schizo_base_detect_proxy(NULL);
+    app = PMIX_NEW(prte_app_context_t);
+    app->job = (struct prte_job_t *) jdata;
+    app->idx = pmix_pointer_array_add(jdata->apps, app);
+    jdata->num_apps++;
+    app->app = strdup("/bin/true");
+    PMIX_ARGV_APPEND_NOSIZE_COMPAT(&app->argv, "true");
+    app->cwd = strdup("/");
+    app->num_procs = np;
+    if (NULL != mapby &&
+        PRTE_SUCCESS != (rc = prte_rmaps_base_set_mapping_policy(jdata, mapby))) {
+        goto done;
+    }
+    if (NULL != rankby &&
+        PRTE_SUCCESS != (rc = prte_rmaps_base_set_ranking_policy(jdata, rankby))) {
+        goto done;
+    }
+    if (NULL != bindto &&
+        PRTE_SUCCESS != (rc = prte_hwloc_base_set_binding_policy(jdata, bindto))) {
+        goto done;
+    }
+
+    if (PRTE_SUCCESS != (rc = prte_plm.spawn(jdata))) {
+        PRTE_ERROR_LOG(rc);
+        goto done;
+    }
+    while (prte_event_base_active && !mapped && !map_failed) {
+        prte_event_loop(prte_event_base, PRTE_EVLOOP_ONCE);
+    }
+    if (!mapped) {
+        fprintf(stderr, "%s: job failed to map\n", argv[0]);
+        rc = PRTE_ERR_FATAL;
+        goto done;
+    }
+
+    /* the remaining steps are those the DVM performs on
+     * the mapped job before sending the launch message */
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    begin(&start);
+    rc = prte_util_nidmap_create(prte_node_pool, &buf);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        goto done;
+    }
+    record("nidmap-create", start, buf.bytes_used);
+
+    /* the HNP only parses the nidmap as it already
+     * holds the node pool */
+    begin(&start);
+    rc = prte_util_decode_nidmap(&buf);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        goto done;
+    }
+    record("nidmap-decode", start, 0);
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&buf);
+    begin(&start);
+    rc = prte_odls_base_default_get_add_procs_data(&buf, jdata->nspace);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&buf);
+        goto done;
+    }
+    record("launch-msg", start, buf.bytes_used);
+    PMIX_DATA_BUFFER_DESTRUCT(&buf);
+
+    begin(&start);
+    rc = prte_pmix_server_register_nspace(jdata);
+    if (PRTE_SUCCESS != rc) {
+        PRTE_ERROR_LOG(rc);
+        goto done;
+    }
+    record("register-nspace", start, 0);
+
+    PRTE_PMIX_CONSTRUCT_LOCK(&lock);
+    PMIx_server_deregister_nspace(jdata->nspace, opcbfunc, &lock);
+    PRTE_PMIX_WAIT_THREAD(&lock);
+    PRTE_PMIX_DESTRUCT_LOCK(&lock);
+
+    fprintf(stdout, "nodes: %s  slots: %s  procs: %lu  map-by: %s  rank-by: %s  bind-to: %s\n",
+            nodes, (NULL == slots) ? "1" : slots, (unsigned long) jdata->num_procs,
+            prte_rmaps_base_print_mapping(jdata->map->mapping),
+            prte_rmaps_base_print_ranking(jdata->map->ranking),
+            prte_hwloc_base_print_binding(jdata->map->binding));
+    fprintf(stdout, "%-16s %12s %14s %14s %14s\n", "phase", "seconds", "rss-delta(KB)",
+            "peak-rss(KB)", "bytes");
+    for (n = 0; n < nphases; n++) {
+        if (phases[n].have_rss) {
+            fprintf(stdout, "%-16s %12.6f %14ld %14ld %14lu\n", phases[n].name, phases[n].secs,
+                    phases[n].rss, phases[n].maxrss, (unsigned long) phases[n].bytes);
+        } else {
+            fprintf(stdout, "%-16s %12.6f %14s %14ld %14lu\n", phases[n].name, phases[n].secs,
+                    "-", phases[n].maxrss, (unsigned long) phases[n].bytes);
+        }
+    }
+    proc_table_summary(jdata);
+    rc = PRTE_SUCCESS;
+
+done:
+    prte_finalize();
+    PMIX_ARGV_FREE_COMPAT(pargv);
+    return (PRTE_SUCCESS == rc) ? 0 : 1;
+}
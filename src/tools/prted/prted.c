@@ -515,6 +515,10 @@ int main(int argc, char *argv[])
     PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_PRTED_CALLBACK,
                   PRTE_RML_PERSISTENT, rollup, NULL);
 
+    /* setup to merge proc state reports from our children */
+    PRTE_RML_RECV(PRTE_NAME_WILDCARD, PRTE_RML_TAG_PROC_STATE,
+                  PRTE_RML_PERSISTENT, prte_state_base_relay_reports, NULL);
+
     if (prte_static_ports || NULL != prte_parent_uri) {
         /* since we will be waiting for any children to send us
          * their rollup info before sending to our parent, save
@@ -594,6 +594,7 @@ int main(int argc, char *argv[])
     node->index = PRTE_PROC_MY_NAME->rank;
     PRTE_FLAG_SET(node, PRTE_NODE_FLAG_LOC_VERIFIED);
     pmix_pointer_array_set_item(prte_node_pool, PRTE_PROC_MY_NAME->rank, node);
+    prte_node_index(node);
 
     /* create and store a proc object for us */
     pptr = PMIX_NEW(prte_proc_t);
@@ -42,33 +42,80 @@ typedef struct {
 /* all default to NULL */
 static prte_attr_converter_t converters[MAX_CONVERTERS];
 
-bool prte_get_attribute(pmix_list_t *attributes, prte_attribute_key_t key, void **data,
+/* make room for one more attribute at the given position */
+static prte_attribute_t *insert_kv(prte_attr_list_t *attributes, uint32_t pos)
+{
+    prte_attribute_t *tmp;
+    uint32_t size;
+
+    if (attributes->num_attrs == attributes->size) {
+        size = (0 == attributes->size) ? 4 : 2 * attributes->size;
+        tmp = (prte_attribute_t *) realloc(attributes->attrs, size * sizeof(prte_attribute_t));
+        if (NULL == tmp) {
+            return NULL;
+        }
+        attributes->attrs = tmp;
+        attributes->size = size;
+    }
+    if (pos < attributes->num_attrs) {
+        memmove(&attributes->attrs[pos + 1], &attributes->attrs[pos],
+                (attributes->num_attrs - pos) * sizeof(prte_attribute_t));
+    }
+    attributes->num_attrs++;
+    PRTE_ATTRIBUTE_CONSTRUCT(&attributes->attrs[pos]);
+    return &attributes->attrs[pos];
+}
+
+static void remove_kv(prte_attr_list_t *attributes, prte_attribute_t *kv)
+{
+    uint32_t pos = kv - attributes->attrs;
+
+    PRTE_ATTRIBUTE_DESTRUCT(kv);
+    attributes->num_attrs--;
+    if (pos < attributes->num_attrs) {
+        memmove(&attributes->attrs[pos], &attributes->attrs[pos + 1],
+                (attributes->num_attrs - pos) * sizeof(prte_attribute_t));
+    }
+}
+
+static prte_attribute_t *find_kv(prte_attr_list_t *attributes, uint32_t start,
+                                 prte_attribute_key_t key)
+{
+    uint32_t n;
+
+    for (n = start; n < attributes->num_attrs; n++) {
+        if (key == attributes->attrs[n].key) {
+            return &attributes->attrs[n];
+        }
+    }
+    return NULL;
+}
+
+bool prte_get_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key, void **data,
                         pmix_data_type_t type)
 {
     prte_attribute_t *kv;
     int rc;
 
-    PMIX_LIST_FOREACH(kv, attributes, prte_attribute_t)
-    {
-        if (key == kv->key) {
-            if (kv->data.type != type) {
-                PRTE_ERROR_LOG(PRTE_ERR_TYPE_MISMATCH);
-                pmix_output(0, "KV %s TYPE %s", PMIx_Data_type_string(kv->data.type), PMIx_Data_type_string(type));
-                return false;
-            }
-            if (NULL != data) {
-                if (PRTE_SUCCESS != (rc = prte_attr_unload(kv, data, type))) {
-                    PRTE_ERROR_LOG(rc);
-                }
-            }
-            return true;
+    kv = find_kv(attributes, 0, key);
+    if (NULL == kv) {
+        /* not found */
+        return false;
+    }
+    if (kv->data.type != type) {
+        PRTE_ERROR_LOG(PRTE_ERR_TYPE_MISMATCH);
+        pmix_output(0, "KV %s TYPE %s", PMIx_Data_type_string(kv->data.type), PMIx_Data_type_string(type));
+        return false;
+    }
+    if (NULL != data) {
+        if (PRTE_SUCCESS != (rc = prte_attr_unload(kv, data, type))) {
+            PRTE_ERROR_LOG(rc);
         }
     }
-    /* not found */
-    return false;
+    return true;
 }
 
-int prte_set_attribute(pmix_list_t *attributes, prte_attribute_key_t key,
+int prte_set_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key,
                        bool local, void *data,
                        pmix_data_type_t type)
 {
@@ -76,109 +123,92 @@ int prte_set_attribute(pmix_list_t *attributes, prte_attribute_key_t key,
     bool *bl, bltrue = true;
     int rc;
 
-    PMIX_LIST_FOREACH(kv, attributes, prte_attribute_t)
-    {
-        if (key == kv->key) {
-            if (kv->data.type != type) {
-                return PRTE_ERR_TYPE_MISMATCH;
-            }
-            if (PMIX_BOOL == type) {
-                if (NULL == data) {
-                    bl = &bltrue;
-                } else {
-                    bl = (bool*)data;
-                }
-                if (false == *bl) {
-                    pmix_list_remove_item(attributes, &kv->super);
-                    PMIX_RELEASE(kv);
-                    return PRTE_SUCCESS;
-                }
+    kv = find_kv(attributes, 0, key);
+    if (NULL != kv) {
+        if (kv->data.type != type) {
+            return PRTE_ERR_TYPE_MISMATCH;
+        }
+        if (PMIX_BOOL == type) {
+            if (NULL == data) {
+                bl = &bltrue;
+            } else {
+                bl = (bool*)data;
             }
-            if (PRTE_SUCCESS != (rc = prte_attr_load(kv, data, type))) {
-                PRTE_ERROR_LOG(rc);
+            if (false == *bl) {
+                remove_kv(attributes, kv);
+                return PRTE_SUCCESS;
             }
-            return rc;
         }
+        if (PRTE_SUCCESS != (rc = prte_attr_load(kv, data, type))) {
+            PRTE_ERROR_LOG(rc);
+        }
+        return rc;
     }
     /* not found - add it */
-    kv = PMIX_NEW(prte_attribute_t);
+    kv = insert_kv(attributes, attributes->num_attrs);
+    if (NULL == kv) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
     kv->key = key;
     kv->local = local;
     if (PRTE_SUCCESS != (rc = prte_attr_load(kv, data, type))) {
-        PMIX_RELEASE(kv);
+        remove_kv(attributes, kv);
         return rc;
     }
-    pmix_list_append(attributes, &kv->super);
     return PRTE_SUCCESS;
 }
 
-prte_attribute_t *prte_fetch_attribute(pmix_list_t *attributes, prte_attribute_t *prev,
+prte_attribute_t *prte_fetch_attribute(prte_attr_list_t *attributes, prte_attribute_t *prev,
                                        prte_attribute_key_t key)
 {
-    prte_attribute_t *kv, *end, *next;
-
-    /* if prev is NULL, then find the first attr on the list
-     * that matches the key */
+    /* if prev is NULL, then find the first attr that matches
+     * the key - otherwise, search from the one after it */
     if (NULL == prev) {
-        PMIX_LIST_FOREACH(kv, attributes, prte_attribute_t)
-        {
-            if (key == kv->key) {
-                return kv;
-            }
-        }
-        /* if we get, then the key isn't on the list */
-        return NULL;
-    }
-
-    /* if we are at the end of the list, then nothing to do */
-    end = (prte_attribute_t *) pmix_list_get_end(attributes);
-    if (prev == end || end == (prte_attribute_t *) pmix_list_get_next(&prev->super)
-        || NULL == pmix_list_get_next(&prev->super)) {
-        return NULL;
-    }
-
-    /* starting with the next item on the list, search
-     * for the next attr with the matching key */
-    next = (prte_attribute_t *) pmix_list_get_next(&prev->super);
-    while (NULL != next) {
-        if (next->key == key) {
-            return next;
-        }
-        next = (prte_attribute_t *) pmix_list_get_next(&next->super);
+        return find_kv(attributes, 0, key);
     }
-
-    /* if we get here, then no matching key was found */
-    return NULL;
+    return find_kv(attributes, (prev - attributes->attrs) + 1, key);
 }
 
-int prte_prepend_attribute(pmix_list_t *attributes, prte_attribute_key_t key, bool local,
+int prte_prepend_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key, bool local,
                            void *data, pmix_data_type_t type)
 {
     prte_attribute_t *kv;
     int rc;
 
-    kv = PMIX_NEW(prte_attribute_t);
+    kv = insert_kv(attributes, 0);
+    if (NULL == kv) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
     kv->key = key;
     kv->local = local;
     if (PRTE_SUCCESS != (rc = prte_attr_load(kv, data, type))) {
-        PMIX_RELEASE(kv);
+        remove_kv(attributes, kv);
         return rc;
     }
-    pmix_list_prepend(attributes, &kv->super);
     return PRTE_SUCCESS;
 }
 
-void prte_remove_attribute(pmix_list_t *attributes, prte_attribute_key_t key)
+/* add the given attribute to the end of the store - the
+ * store takes over the attribute's data */
+int prte_attr_list_append(prte_attr_list_t *attributes, prte_attribute_t *kv)
+{
+    prte_attribute_t *ptr;
+
+    ptr = insert_kv(attributes, attributes->num_attrs);
+    if (NULL == ptr) {
+        return PRTE_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy(ptr, kv, sizeof(prte_attribute_t));
+    return PRTE_SUCCESS;
+}
+
+void prte_remove_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key)
 {
     prte_attribute_t *kv;
 
-    PMIX_LIST_FOREACH(kv, attributes, prte_attribute_t)
-    {
-        if (key == kv->key) {
-            pmix_list_remove_item(attributes, &kv->super);
-            PMIX_RELEASE(kv);
-            return;
-        }
+    kv = find_kv(attributes, 0, key);
+    if (NULL != kv) {
+        remove_kv(attributes, kv);
     }
 }
 
@@ -202,12 +232,12 @@ int prte_attr_register(const char *project, prte_attribute_key_t key_base,
     return PRTE_ERR_OUT_OF_RESOURCE;
 }
 
-char *prte_attr_print_list(pmix_list_t *attributes)
+char *prte_attr_print_list(prte_attr_list_t *attributes)
 {
     char *out1, **cache = NULL;
     prte_attribute_t *attr;
 
-    PMIX_LIST_FOREACH(attr, attributes, prte_attribute_t)
+    PRTE_ATTR_FOREACH(attr, attributes)
     {
         PMIX_ARGV_APPEND_NOSIZE_COMPAT(&cache, prte_attr_key_to_str(attr->key));
     }
@@ -285,27 +285,31 @@ typedef uint16_t prte_proc_flags_t;
 PRTE_EXPORT const char *prte_attr_key_to_str(prte_attribute_key_t key);
 
 /* Retrieve the named attribute from a list */
-PRTE_EXPORT bool prte_get_attribute(pmix_list_t *attributes, prte_attribute_key_t key, void **data,
+PRTE_EXPORT bool prte_get_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key, void **data,
                                     pmix_data_type_t type);
 
 /* Set the named attribute in a list, overwriting any prior entry */
-PRTE_EXPORT int prte_set_attribute(pmix_list_t *attributes, prte_attribute_key_t key, bool local,
+PRTE_EXPORT int prte_set_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key, bool local,
                                    void *data, pmix_data_type_t type);
 
 /* Remove the named attribute from a list */
-PRTE_EXPORT void prte_remove_attribute(pmix_list_t *attributes, prte_attribute_key_t key);
+PRTE_EXPORT void prte_remove_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key);
 
-PRTE_EXPORT prte_attribute_t *prte_fetch_attribute(pmix_list_t *attributes, prte_attribute_t *prev,
+PRTE_EXPORT prte_attribute_t *prte_fetch_attribute(prte_attr_list_t *attributes, prte_attribute_t *prev,
                                                    prte_attribute_key_t key);
 
-PRTE_EXPORT int prte_prepend_attribute(pmix_list_t *attributes, prte_attribute_key_t key,
+/* Append a copy of an attribute to a list - the list takes
+ * over any storage the attribute's data points to */
+PRTE_EXPORT int prte_attr_list_append(prte_attr_list_t *attributes, prte_attribute_t *kv);
+
+PRTE_EXPORT int prte_prepend_attribute(prte_attr_list_t *attributes, prte_attribute_key_t key,
                                        bool local, void *data, pmix_data_type_t type);
 
 PRTE_EXPORT int prte_attr_load(prte_attribute_t *kv, void *data, pmix_data_type_t type);
 
 PRTE_EXPORT int prte_attr_unload(prte_attribute_t *kv, void **data, pmix_data_type_t type);
 
-PRTE_EXPORT char *prte_attr_print_list(pmix_list_t *attributes);
+PRTE_EXPORT char *prte_attr_print_list(prte_attr_list_t *attributes);
 
 /*
  * Register a handler for converting attr keys to strings
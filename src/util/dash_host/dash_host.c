@@ -416,17 +416,11 @@ int prte_util_add_dash_host_nodes(pmix_list_t *nodes, char *hosts, bool allocati
         prte_node_t *node_from_pool = NULL;
         PMIX_LIST_FOREACH(node, nodes, prte_node_t) {
             needcheck = true;
-            for (i = 0; i < prte_node_pool->size; i++) {
-                node_from_pool = (prte_node_t *) pmix_pointer_array_get_item(prte_node_pool, i);
-                if (NULL == node_from_pool) {
-                    continue;
-                }
-                if (prte_nptr_match(node_from_pool, node)) {
-                    needcheck = false;
-                    if (node->slots < node_from_pool->slots) {
-                        node_from_pool->slots = node->slots;
-                    }
-                    break;
+            node_from_pool = prte_node_pool_match(node);
+            if (NULL != node_from_pool) {
+                needcheck = false;
+                if (node->slots < node_from_pool->slots) {
+                    node_from_pool->slots = node->slots;
                 }
             }
             if (needcheck) {
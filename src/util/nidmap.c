@@ -23,6 +23,7 @@
 #include <ctype.h>
 
 #include "src/util/pmix_argv.h"
+#include "src/util/pmix_printf.h"
 
 #include "src/mca/errmgr/errmgr.h"
 #include "src/mca/rmaps/base/base.h"
@@ -32,58 +33,372 @@
 
 #include "src/util/nidmap.h"
 
-int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer)
+/* version of the node map we hold. The HNP advances this each
+ * time it distributes an update to the DVM */
+uint32_t prte_nidmap_epoch = 0;
+
+#define PRTE_NIDMAP_FULL  1
+#define PRTE_NIDMAP_DELTA 2
+
+/* what the HNP last distributed about each node, so the
+ * next update need only carry what has changed */
+typedef struct {
+    bool present;
+    int naliases;
+    pmix_rank_t vpid;
+} prte_nidmap_entry_t;
+
+static prte_nidmap_entry_t *snapshot = NULL;
+static int nsnapshot = 0;
+static pmix_rank_t snapshot_daemons = 0;
+
+/* a new daemon can be sent an update before the full map it
+ * is based on arrives - hold it, keyed by the version it
+ * updates, until we have that map */
+typedef struct {
+    pmix_list_item_t super;
+    uint32_t base;
+    pmix_data_buffer_t data;
+} prte_nidmap_held_t;
+static void hdcon(prte_nidmap_held_t *p)
+{
+    PMIX_DATA_BUFFER_CONSTRUCT(&p->data);
+}
+static void hddes(prte_nidmap_held_t *p)
+{
+    PMIX_DATA_BUFFER_DESTRUCT(&p->data);
+}
+static PMIX_CLASS_INSTANCE(prte_nidmap_held_t, pmix_list_item_t, hdcon, hddes);
+
+static pmix_list_t held;
+static bool held_init = false;
+
+/* pack a block of data, compressing it if we can */
+static int pack_blob(pmix_data_buffer_t *buffer, void *data, size_t size)
 {
-    char *raw = NULL;
-    pmix_rank_t *vpids = NULL;
-    uint8_t u8;
-    int n, m, ndaemons, nbytes;
-    bool compressed;
-    char **names = NULL;
-    char **aliases = NULL, **als;
-    prte_node_t *nptr;
     pmix_byte_object_t bo;
+    bool compressed;
     size_t sz;
     pmix_status_t rc;
 
-    /* pack a flag indicating if the HNP was included in the allocation */
-    if (prte_hnp_is_allocated) {
-        u8 = 1;
+    if (PMIx_Data_compress((uint8_t *) data, size, (uint8_t **) &bo.bytes, &sz)) {
+        /* mark that this was compressed */
+        compressed = true;
+        bo.size = sz;
     } else {
-        u8 = 0;
+        /* mark that this was not compressed */
+        compressed = false;
+        bo.bytes = (char *) data;
+        bo.size = size;
     }
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
+    /* indicate compression */
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
+    if (PMIX_SUCCESS == rc) {
+        /* add the object */
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+    }
+    if (compressed) {
+        free(bo.bytes);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+    }
+    return rc;
+}
+
+static int unpack_blob(pmix_data_buffer_t *buffer, char **data, size_t *size)
+{
+    pmix_byte_object_t pbo;
+    bool compressed;
+    int cnt;
+    pmix_status_t rc;
+
+    /* unpack compression flag */
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buffer, &compressed, &cnt, PMIX_BOOL);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
         return rc;
     }
 
-    /* pack a flag indicating if we are in a managed allocation */
-    if (prte_managed_allocation) {
-        u8 = 1;
+    /* unpack the object */
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buffer, &pbo, &cnt, PMIX_BYTE_OBJECT);
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        return rc;
+    }
+
+    /* if compressed, decompress */
+    if (compressed) {
+        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, (uint8_t **) data, size)) {
+            PRTE_ERROR_LOG(PRTE_ERROR);
+            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
+            return PRTE_ERROR;
+        }
+        PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
     } else {
-        u8 = 0;
+        *data = pbo.bytes;
+        *size = pbo.size;
     }
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
+    return PRTE_SUCCESS;
+}
+
+/* Node names are sent as a list of ranges - each is a prefix,
+ * a sequence of consecutive numbers (optionally zero-padded to a
+ * given width) and a suffix. Thus "rack12-node0001" thru
+ * "rack12-node0400" are sent as a single range. Names that carry
+ * no number are sent as a range of one */
+typedef struct {
+    char *prefix;
+    char *suffix;
+    int width;  // -1 => no number
+    uint32_t start;
+    uint32_t count;
+    int first;  // index of the first name in the range
+} prte_nidmap_range_t;
+
+typedef struct {
+    prte_nidmap_range_t *ranges;
+    int nranges;
+    int nnames;
+    int cur;
+} prte_nidmap_hostlist_t;
+
+/* the caller is responsible for releasing the name */
+static char *format_name(prte_nidmap_range_t *r, uint32_t k)
+{
+    char *name = NULL;
+
+    if (0 > r->width) {
+        return strdup(r->prefix);
+    }
+    if (0 > pmix_asprintf(&name, "%s%0*u%s", r->prefix, r->width, r->start + k, r->suffix)) {
+        return NULL;
+    }
+    return name;
+}
+
+/* locate the last group of digits in the name */
+static bool split_name(const char *name, size_t *plen, size_t *dlen, uint32_t *num)
+{
+    size_t n, end;
+
+    for (end = strlen(name); 0 < end && !isdigit((unsigned char) name[end - 1]); end--);
+    if (0 == end) {
+        return false;
+    }
+    for (n = end; 0 < n && isdigit((unsigned char) name[n - 1]); n--);
+    /* don't let the number overflow */
+    if (9 < end - n) {
+        return false;
+    }
+    *plen = n;
+    *dlen = end - n;
+    *num = (uint32_t) strtoul(name + n, NULL, 10);
+    return true;
+}
+
+static int pack_names(pmix_data_buffer_t *buffer, char **names, int nnames)
+{
+    prte_nidmap_range_t *ranges, *r = NULL;
+    pmix_data_buffer_t data;
+    char *tmp;
+    bool match;
+    size_t plen, dlen;
+    uint32_t num;
+    int n, nranges = 0, rc;
+
+    ranges = (prte_nidmap_range_t *) calloc(nnames, sizeof(prte_nidmap_range_t));
+    for (n = 0; n < nnames; n++) {
+        if (NULL != r && 0 <= r->width) {
+            /* see if this name continues the current range */
+            tmp = format_name(r, r->count);
+            match = (NULL != tmp && 0 == strcmp(tmp, names[n]));
+            free(tmp);
+            if (match) {
+                r->count++;
+                continue;
+            }
+        }
+        r = &ranges[nranges++];
+        r->count = 1;
+        if (split_name(names[n], &plen, &dlen, &num)) {
+            r->prefix = (char *) malloc(plen + 1);
+            memcpy(r->prefix, names[n], plen);
+            r->prefix[plen] = '\0';
+            r->suffix = strdup(names[n] + plen + dlen);
+            r->width = (1 < dlen && '0' == names[n][plen]) ? (int) dlen : 0;
+            r->start = num;
+        } else {
+            r->prefix = strdup(names[n]);
+            r->suffix = strdup("");
+            r->width = -1;
+            r->start = 0;
+        }
+    }
+
+    PMIX_DATA_BUFFER_CONSTRUCT(&data);
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &data, &nranges, 1, PMIX_INT);
+    for (n = 0; PMIX_SUCCESS == rc && n < nranges; n++) {
+        r = &ranges[n];
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &data, &r->prefix, 1, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &data, &r->suffix, 1, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &data, &r->width, 1, PMIX_INT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &data, &r->start, 1, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == rc) {
+            rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, &data, &r->count, 1, PMIX_UINT32);
+        }
+    }
+    for (n = 0; n < nranges; n++) {
+        free(ranges[n].prefix);
+        free(ranges[n].suffix);
+    }
+    free(ranges);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&data);
         return rc;
     }
 
+    rc = pack_blob(buffer, data.base_ptr, data.bytes_used);
+    PMIX_DATA_BUFFER_DESTRUCT(&data);
+    return rc;
+}
+
+static void hostlist_destruct(prte_nidmap_hostlist_t *hl)
+{
+    int n;
+
+    for (n = 0; n < hl->nranges; n++) {
+        free(hl->ranges[n].prefix);
+        free(hl->ranges[n].suffix);
+    }
+    free(hl->ranges);
+    hl->ranges = NULL;
+    hl->nranges = 0;
+    hl->nnames = 0;
+}
+
+/* unpack the list of ranges - the names themselves are
+ * only generated as they are needed */
+static int unpack_names(pmix_data_buffer_t *buffer, prte_nidmap_hostlist_t *hl)
+{
+    prte_nidmap_range_t *r;
+    pmix_data_buffer_t data;
+    pmix_byte_object_t bo;
+    int n, cnt, rc;
+
+    rc = unpack_blob(buffer, &bo.bytes, &bo.size);
+    if (PRTE_SUCCESS != rc) {
+        return rc;
+    }
+    PMIX_DATA_BUFFER_CONSTRUCT(&data);
+    PMIx_Data_load(&data, &bo);
+
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &data, &hl->nranges, &cnt, PMIX_INT);
+    if (PMIX_SUCCESS != rc || 0 > hl->nranges) {
+        PMIX_ERROR_LOG(rc);
+        PMIX_DATA_BUFFER_DESTRUCT(&data);
+        hl->nranges = 0;
+        return PRTE_ERR_UNPACK_FAILURE;
+    }
+    hl->ranges = (prte_nidmap_range_t *) calloc(hl->nranges + 1, sizeof(prte_nidmap_range_t));
+    for (n = 0; n < hl->nranges; n++) {
+        r = &hl->ranges[n];
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &data, &r->prefix, &cnt, PMIX_STRING);
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &data, &r->suffix, &cnt, PMIX_STRING);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &data, &r->width, &cnt, PMIX_INT);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &data, &r->start, &cnt, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS == rc) {
+            cnt = 1;
+            rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, &data, &r->count, &cnt, PMIX_UINT32);
+        }
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
+            PMIX_DATA_BUFFER_DESTRUCT(&data);
+            hl->nranges = n + 1;
+            hostlist_destruct(hl);
+            return rc;
+        }
+        /* an empty string may arrive as NULL */
+        if (NULL == r->prefix) {
+            r->prefix = strdup("");
+        }
+        if (NULL == r->suffix) {
+            r->suffix = strdup("");
+        }
+        r->first = hl->nnames;
+        hl->nnames += r->count;
+    }
+    PMIX_DATA_BUFFER_DESTRUCT(&data);
+    hl->cur = 0;
+    return PRTE_SUCCESS;
+}
+
+/* generate the name at the given position - positions are
+ * usually asked for in order, so start from the last range.
+ * The caller is responsible for releasing the name */
+static char *hostname_at(prte_nidmap_hostlist_t *hl, int idx)
+{
+    prte_nidmap_range_t *r;
+
+    if (0 == hl->nranges || idx < hl->ranges[hl->cur].first) {
+        hl->cur = 0;
+    }
+    while (hl->cur < hl->nranges) {
+        r = &hl->ranges[hl->cur];
+        if (idx < r->first + (int) r->count) {
+            return format_name(r, idx - r->first);
+        }
+        hl->cur++;
+    }
+    hl->cur = 0;
+    return NULL;
+}
+
+/* pack the given nodes from the pool - if indices is NULL, then
+ * this is the entire pool */
+static int pack_nodes(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer,
+                      uint32_t *indices, int nnodes)
+{
+    char *raw = NULL;
+    pmix_rank_t *vpids = NULL;
+    int n, m, nd;
+    char **names = NULL;
+    char **aliases = NULL, **als;
+    prte_node_t *nptr;
+    pmix_status_t rc;
+
     /* daemon vpids start from 0 and increase linearly by one
-     * up to the number of nodes in the system. The vpid is
-     * a 32-bit value. We don't know how many of the nodes
-     * in the system have daemons - we may not be using them
-     * all just yet. However, even the largest systems won't
-     * have more than a million nodes for quite some time,
-     * so for now we'll just allocate enough space to hold
-     * them all. Someone can optimize this further later */
-    nbytes = prte_process_info.num_daemons * sizeof(pmix_rank_t);
-    vpids = (pmix_rank_t *) malloc(nbytes);
-
-    ndaemons = 0;
-    for (n = 0; n < pool->size; n++) {
+     * up to the number of nodes in the system - we don't know
+     * how many of the nodes have daemons, so allow for all */
+    vpids = (pmix_rank_t *) malloc(nnodes * sizeof(pmix_rank_t));
+
+    for (nd = 0; nd < nnodes; nd++) {
+        n = (NULL == indices) ? nd : (int) indices[nd];
         if (NULL == (nptr = (prte_node_t *) pmix_pointer_array_get_item(pool, n))) {
+            /* the node has been removed */
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&names, "");
+            PMIX_ARGV_APPEND_NOSIZE_COMPAT(&aliases, "PRTENONE");
+            vpids[nd] = PMIX_RANK_INVALID;
             continue;
         }
         /* add the hostname to the argv */
@@ -102,11 +417,10 @@ int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buff
         }
         /* store the vpid */
         if (NULL == nptr->daemon) {
-            vpids[ndaemons] = PMIX_RANK_INVALID;
+            vpids[nd] = PMIX_RANK_INVALID;
         } else {
-            vpids[ndaemons] = nptr->daemon->name.rank;
+            vpids[nd] = nptr->daemon->name.rank;
         }
-        ++ndaemons;
     }
 
     /* little protection */
@@ -116,116 +430,325 @@ int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buff
         return PRTE_ERR_NOT_FOUND;
     }
 
-    /* construct the string of node names for compression */
-    raw = PMIX_ARGV_JOIN_COMPAT(names, ',');
+    rc = pack_names(buffer, names, nnodes);
     PMIX_ARGV_FREE_COMPAT(names);
-    if (PMIx_Data_compress((uint8_t *) raw, strlen(raw) + 1, (uint8_t **) &bo.bytes, &sz)) {
-        /* mark that this was compressed */
-        compressed = true;
-        bo.size = sz;
-        free(raw);
-    } else {
-        /* mark that this was not compressed */
-        compressed = false;
-        bo.bytes = (char *) raw;
-        bo.size = strlen(raw) + 1;
-    }
-    /* indicate compression */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
     if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
+        PMIX_ARGV_FREE_COMPAT(aliases);
         free(vpids);
         return rc;
     }
-    /* add the object */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+
+    raw = PMIX_ARGV_JOIN_COMPAT(aliases, ';');
+    PMIX_ARGV_FREE_COMPAT(aliases);
+    rc = pack_blob(buffer, raw, strlen(raw) + 1);
+    free(raw);
     if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
         free(vpids);
         return rc;
     }
-    free(bo.bytes);
 
-    /* construct the string of aliases for compression */
-    raw = PMIX_ARGV_JOIN_COMPAT(aliases, ';');
-    PMIX_ARGV_FREE_COMPAT(aliases);
-    if (PMIx_Data_compress((uint8_t *) raw, strlen(raw) + 1, (uint8_t **) &bo.bytes, &sz)) {
-        /* mark that this was compressed */
-        compressed = true;
-        bo.size = sz;
-        free(raw);
-    } else {
-        /* mark that this was not compressed */
-        compressed = false;
-        bo.bytes = (char *) raw;
-        bo.size = strlen(raw) + 1;
+    rc = pack_blob(buffer, vpids, nnodes * sizeof(pmix_rank_t));
+    free(vpids);
+    return rc;
+}
+
+static int pack_header(pmix_data_buffer_t *buffer, uint8_t type, uint32_t base)
+{
+    uint8_t u8;
+    pmix_status_t rc;
+
+    /* pack the type of map and its version */
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &type, 1, PMIX_UINT8);
+    if (PMIX_SUCCESS == rc) {
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &prte_nidmap_epoch, 1, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc && PRTE_NIDMAP_DELTA == type) {
+        /* the version it updates */
+        rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &base, 1, PMIX_UINT32);
     }
-    /* indicate compression */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
-        free(vpids);
         return rc;
     }
-    /* add the object */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
+
+    /* pack a flag indicating if the HNP was included in the allocation */
+    if (prte_hnp_is_allocated) {
+        u8 = 1;
+    } else {
+        u8 = 0;
+    }
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
-        free(vpids);
         return rc;
     }
-    free(bo.bytes);
 
-    /* compress the vpids */
-    if (PMIx_Data_compress((uint8_t *) vpids, nbytes, (uint8_t **) &bo.bytes, &sz)) {
-        /* mark that this was compressed */
-        compressed = true;
-        bo.size = sz;
-        free(vpids);
+    /* pack a flag indicating if we are in a managed allocation */
+    if (prte_managed_allocation) {
+        u8 = 1;
     } else {
-        /* mark that this was not compressed */
-        compressed = false;
-        bo.bytes = (char *) vpids;
-        bo.size = ndaemons * sizeof(pmix_rank_t);
+        u8 = 0;
     }
-    /* indicate compression */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &compressed, 1, PMIX_BOOL);
+    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &u8, 1, PMIX_UINT8);
     if (PMIX_SUCCESS != rc) {
         PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
         return rc;
     }
-    /* add the object */
-    rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &bo, 1, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        free(bo.bytes);
+    return PRTE_SUCCESS;
+}
+
+int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer)
+{
+    int rc, n, nnodes;
+
+    rc = pack_header(buffer, PRTE_NIDMAP_FULL, 0);
+    if (PRTE_SUCCESS != rc) {
         return rc;
     }
-    free(bo.bytes);
+    /* the pool is filled from the bottom, so
+     * everything through the last node is included */
+    nnodes = 0;
+    for (n = 0; n < pool->size; n++) {
+        if (NULL != pmix_pointer_array_get_item(pool, n)) {
+            nnodes = n + 1;
+        }
+    }
+    return pack_nodes(pool, buffer, NULL, nnodes);
+}
 
-    return rc;
+static int node_naliases(prte_node_t *nptr)
+{
+    if (NULL == nptr || NULL == nptr->aliases) {
+        return 0;
+    }
+    return PMIX_ARGV_COUNT_COMPAT(nptr->aliases);
 }
 
-int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
+int prte_util_nidmap_create_update(pmix_pointer_array_t *pool, pmix_data_buffer_t *buffer,
+                                   pmix_rank_t *first_new)
 {
-    uint8_t u8;
+    prte_nidmap_entry_t *entry;
+    prte_node_t *nptr;
+    uint32_t *indices = NULL, base;
+    pmix_rank_t vpid;
+    int n, nchanged = 0, rc;
+
+    base = prte_nidmap_epoch;
+    ++prte_nidmap_epoch;
+
+    if (NULL == snapshot) {
+        /* nothing has been sent before - send it all */
+        *first_new = PMIX_RANK_INVALID;
+        rc = prte_util_nidmap_create(pool, buffer);
+    } else {
+        /* collect the nodes that changed since the last update */
+        indices = (uint32_t *) malloc(pool->size * sizeof(uint32_t));
+        for (n = 0; n < pool->size; n++) {
+            nptr = (prte_node_t *) pmix_pointer_array_get_item(pool, n);
+            if (n >= nsnapshot) {
+                if (NULL != nptr) {
+                    indices[nchanged++] = n;
+                }
+                continue;
+            }
+            entry = &snapshot[n];
+            vpid = (NULL == nptr || NULL == nptr->daemon) ? PMIX_RANK_INVALID
+                                                          : nptr->daemon->name.rank;
+            if (entry->present != (NULL != nptr) || entry->vpid != vpid
+                || entry->naliases != node_naliases(nptr)) {
+                indices[nchanged++] = n;
+            }
+        }
+        *first_new = snapshot_daemons;
+
+        rc = pack_header(buffer, PRTE_NIDMAP_DELTA, base);
+        if (PRTE_SUCCESS == rc) {
+            rc = PMIx_Data_pack(PRTE_PROC_MY_NAME, buffer, &nchanged, 1, PMIX_INT);
+            if (PMIX_SUCCESS != rc) {
+                PMIX_ERROR_LOG(rc);
+            }
+        }
+        if (PRTE_SUCCESS == rc && 0 < nchanged) {
+            rc = pack_blob(buffer, indices, nchanged * sizeof(uint32_t));
+            if (PRTE_SUCCESS == rc) {
+                rc = pack_nodes(pool, buffer, indices, nchanged);
+            }
+        }
+        free(indices);
+    }
+    if (PRTE_SUCCESS != rc) {
+        return rc;
+    }
+
+    PMIX_OUTPUT_VERBOSE((1, prte_rml_base.rml_output,
+                         "%s nidmap: epoch %u carries %s (%d nodes)",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), prte_nidmap_epoch,
+                         (NULL == snapshot) ? "full map" : "delta",
+                         (NULL == snapshot) ? pool->size : nchanged));
+
+    /* remember what we sent */
+    if (nsnapshot < pool->size) {
+        snapshot = (prte_nidmap_entry_t *) realloc(snapshot,
+                                                   pool->size * sizeof(prte_nidmap_entry_t));
+        nsnapshot = pool->size;
+    }
+    for (n = 0; n < nsnapshot; n++) {
+        nptr = (prte_node_t *) pmix_pointer_array_get_item(pool, n);
+        snapshot[n].present = (NULL != nptr);
+        snapshot[n].naliases = node_naliases(nptr);
+        snapshot[n].vpid = (NULL == nptr || NULL == nptr->daemon) ? PMIX_RANK_INVALID
+                                                                  : nptr->daemon->name.rank;
+    }
+    snapshot_daemons = prte_process_info.num_daemons;
+    return PRTE_SUCCESS;
+}
+
+void prte_util_nidmap_release(void)
+{
+    if (held_init) {
+        PMIX_LIST_DESTRUCT(&held);
+        held_init = false;
+    }
+    if (NULL != snapshot) {
+        free(snapshot);
+        snapshot = NULL;
+    }
+    nsnapshot = 0;
+    snapshot_daemons = 0;
+}
+
+/* bring our record of the node at the given index
+ * in line with what we were sent */
+static void update_node(int idx, const char *name, char *alias, pmix_rank_t vpid,
+                        prte_job_t *daemons, prte_topology_t *t)
+{
+    prte_node_t *nd;
+    prte_proc_t *proc;
+
+    nd = (prte_node_t*)pmix_pointer_array_get_item(prte_node_pool, idx);
+    if ('\0' == name[0]) {
+        /* this node has been removed */
+        if (NULL != nd) {
+            pmix_pointer_array_set_item(prte_node_pool, idx, NULL);
+            PMIX_RELEASE(nd);
+        }
+        return;
+    }
+    if (NULL != nd) {
+        /* check the name */
+        if (0 != strcmp(nd->name, name)) {
+            free(nd->name);
+            nd->name = strdup(name);
+        }
+        if (0 != strcmp(alias, "PRTENONE")) {
+            if (NULL != nd->aliases) {
+                PMIX_ARGV_FREE_COMPAT(nd->aliases);
+            }
+            nd->aliases = PMIX_ARGV_SPLIT_COMPAT(alias, ',');
+        }
+        prte_node_index(nd);
+        if (NULL != nd->daemon &&
+            (PMIX_RANK_INVALID == vpid || nd->daemon->name.rank != vpid)) {
+            /* the daemon has gone */
+            if (nd->daemon->node == nd) {
+                nd->daemon->node = NULL;
+                PMIX_RELEASE(nd);
+            }
+            PMIX_RELEASE(nd->daemon);
+            nd->daemon = NULL;
+        }
+        if (NULL != nd->daemon || PMIX_RANK_INVALID == vpid) {
+            return;
+        }
+    } else {
+        /* add this name to the pool */
+        nd = PMIX_NEW(prte_node_t);
+        nd->name = strdup(name);
+        nd->index = idx;
+        pmix_pointer_array_set_item(prte_node_pool, idx, nd);
+        /* add any aliases */
+        if (0 != strcmp(alias, "PRTENONE")) {
+            nd->aliases = PMIX_ARGV_SPLIT_COMPAT(alias, ',');
+        }
+        prte_node_index(nd);
+        /* set the topology - always default to homogeneous
+         * as that is the most common scenario */
+        nd->topology = t;
+    }
+    /* see if it has a daemon on it */
+    if (PMIX_RANK_INVALID != vpid) {
+        proc = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, vpid);
+        if (NULL == proc) {
+            proc = PMIX_NEW(prte_proc_t);
+            PMIX_LOAD_PROCID(&proc->name, PRTE_PROC_MY_NAME->nspace, vpid);
+            proc->state = PRTE_PROC_STATE_RUNNING;
+            PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
+            daemons->num_procs++;
+            pmix_pointer_array_set_item(daemons->procs, proc->name.rank, proc);
+        }
+        PMIX_RETAIN(nd);
+        proc->node = nd;
+        PMIX_RETAIN(proc);
+        nd->daemon = proc;
+    }
+}
+
+static void hold_update(uint32_t base, char *start, size_t len)
+{
+    prte_nidmap_held_t *hd;
+    char *bytes;
+
+    if (!held_init) {
+        PMIX_CONSTRUCT(&held, pmix_list_t);
+        held_init = true;
+    }
+    PMIX_LIST_FOREACH(hd, &held, prte_nidmap_held_t) {
+        if (hd->base == base) {
+            /* already have it */
+            return;
+        }
+    }
+    PMIX_OUTPUT_VERBOSE((5, prte_rml_base.rml_output,
+                         "%s nidmap: holding update of epoch %u until we have it",
+                         PRTE_NAME_PRINT(PRTE_PROC_MY_NAME), base));
+    hd = PMIX_NEW(prte_nidmap_held_t);
+    hd->base = base;
+    bytes = (char *) malloc(len);
+    memcpy(bytes, start, len);
+    PMIX_DATA_BUFFER_LOAD(&hd->data, bytes, len);
+    pmix_list_append(&held, &hd->super);
+}
+
+static int decode_nidmap(pmix_data_buffer_t *buf)
+{
+    uint8_t u8, type;
+    uint32_t epoch, base = 0, *indices = NULL;
     pmix_rank_t *vpid = NULL;
-    int cnt, n;
-    bool compressed;
+    int cnt, n, nnodes = 0;
     size_t sz;
-    pmix_byte_object_t pbo;
-    char *raw = NULL, **names = NULL, **aliases = NULL;
-    prte_node_t *nd;
+    char *raw = NULL, **aliases = NULL, *name;
+    prte_nidmap_hostlist_t names = {0};
     prte_job_t *daemons;
-    prte_proc_t *proc;
     prte_topology_t *t = NULL;
+    char *start = buf->unpack_ptr;
     pmix_status_t rc;
 
+    /* unpack the type of map and its version */
+    cnt = 1;
+    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &type, &cnt, PMIX_UINT8);
+    if (PMIX_SUCCESS == rc) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &epoch, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS == rc && PRTE_NIDMAP_DELTA == type) {
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &base, &cnt, PMIX_UINT32);
+    }
+    if (PMIX_SUCCESS != rc) {
+        PMIX_ERROR_LOG(rc);
+        goto cleanup;
+    }
+
     /* unpack the flag indicating if HNP is in allocation */
     cnt = 1;
     rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &u8, &cnt, PMIX_UINT8);
@@ -252,103 +775,53 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
         prte_managed_allocation = false;
     }
 
-    /* unpack compression flag for node names */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
-
-    /* unpack the nodename object */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
-
-    /* if compressed, decompress */
-    if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, (uint8_t **) &raw, &sz)) {
-            PRTE_ERROR_LOG(PRTE_ERROR);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            rc = PRTE_ERROR;
+    if (PRTE_NIDMAP_DELTA == type) {
+        /* unpack the number of nodes that changed */
+        cnt = 1;
+        rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &nnodes, &cnt, PMIX_INT);
+        if (PMIX_SUCCESS != rc) {
+            PMIX_ERROR_LOG(rc);
             goto cleanup;
         }
-    } else {
-        raw = (char *) pbo.bytes;
-        pbo.bytes = NULL; // protect the data
-        pbo.size = 0;
-    }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-    names = PMIX_ARGV_SPLIT_COMPAT(raw, ',');
-    free(raw);
-
-    /* unpack compression flag for node aliases */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
-
-    /* unpack the aliases object */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
+        if (0 < nnodes) {
+            rc = unpack_blob(buf, &raw, &sz);
+            if (PRTE_SUCCESS != rc) {
+                goto cleanup;
+            }
+            indices = (uint32_t *) raw;
+            raw = NULL;
+        }
     }
 
-    /* if compressed, decompress */
-    if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, (uint8_t **) &raw, &sz)) {
-            PRTE_ERROR_LOG(PRTE_ERROR);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            rc = PRTE_ERROR;
+    if (PRTE_NIDMAP_FULL == type || 0 < nnodes) {
+        /* unpack the node names */
+        rc = unpack_names(buf, &names);
+        if (PRTE_SUCCESS != rc) {
             goto cleanup;
         }
-    } else {
-        raw = (char *) pbo.bytes;
-        pbo.bytes = NULL; // protect the data
-        pbo.size = 0;
-    }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-    aliases = PMIX_ARGV_SPLIT_COMPAT(raw, ';');
-    free(raw);
 
-    /* unpack compression flag for daemon vpids */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &compressed, &cnt, PMIX_BOOL);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
-
-    /* unpack the vpid object */
-    cnt = 1;
-    rc = PMIx_Data_unpack(PRTE_PROC_MY_NAME, buf, &pbo, &cnt, PMIX_BYTE_OBJECT);
-    if (PMIX_SUCCESS != rc) {
-        PMIX_ERROR_LOG(rc);
-        goto cleanup;
-    }
+        /* unpack the node aliases */
+        rc = unpack_blob(buf, &raw, &sz);
+        if (PRTE_SUCCESS != rc) {
+            goto cleanup;
+        }
+        aliases = PMIX_ARGV_SPLIT_COMPAT(raw, ';');
+        free(raw);
 
-    /* if compressed, decompress */
-    if (compressed) {
-        if (!PMIx_Data_decompress((uint8_t *) pbo.bytes, pbo.size, (uint8_t **) &vpid, &sz)) {
-            PRTE_ERROR_LOG(PRTE_ERROR);
-            PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
-            rc = PRTE_ERROR;
+        /* unpack the daemon vpids */
+        rc = unpack_blob(buf, &raw, &sz);
+        if (PRTE_SUCCESS != rc) {
+            goto cleanup;
+        }
+        vpid = (pmix_rank_t *) raw;
+        nnodes = names.nnames;
+        if (PMIX_ARGV_COUNT_COMPAT(aliases) != nnodes
+            || sz != (size_t) nnodes * sizeof(pmix_rank_t)) {
+            PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+            rc = PRTE_ERR_UNPACK_FAILURE;
             goto cleanup;
         }
-    } else {
-        vpid = (pmix_rank_t *) pbo.bytes;
-        sz = pbo.size;
-        pbo.bytes = NULL;
-        pbo.size = 0;
     }
-    PMIX_BYTE_OBJECT_DESTRUCT(&pbo);
 
     /* if we are the HNP, we don't need any of this stuff */
     if (PRTE_PROC_IS_MASTER) {
@@ -356,6 +829,21 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
         goto cleanup;
     }
 
+    if (PRTE_NIDMAP_DELTA == type) {
+        if (prte_nidmap_epoch < base) {
+            /* we don't have the map this updates yet */
+            hold_update(base, start, buf->unpack_ptr - start);
+            rc = PRTE_SUCCESS;
+            goto cleanup;
+        }
+        if (epoch <= prte_nidmap_epoch) {
+            /* we already have it */
+            rc = PRTE_SUCCESS;
+            goto cleanup;
+        }
+    }
+    prte_nidmap_epoch = epoch;
+
     /* get the daemon job object */
     daemons = prte_get_job_data_object(PRTE_PROC_MY_NAME->nspace);
 
@@ -367,53 +855,18 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
         rc = PRTE_ERR_NOT_FOUND;
         goto cleanup;
     }
-    /* create the node pool array - this will include
+    /* update the node pool array - a full map includes
      * _all_ nodes known to the allocation */
-    for (n = 0; NULL != names[n]; n++) {
-        /* do we already have this node? */
-        nd = (prte_node_t*)pmix_pointer_array_get_item(prte_node_pool, n);
-        if (NULL != nd) {
-            /* check the name */
-            if (0 != strcmp(nd->name, names[n])) {
-                free(nd->name);
-                nd->name = strdup(names[n]);
-            }
-            if (0 != strcmp(aliases[n], "PRTENONE")) {
-                if (NULL != nd->aliases) {
-                    PMIX_ARGV_FREE_COMPAT(nd->aliases);
-                }
-                nd->aliases = PMIX_ARGV_SPLIT_COMPAT(aliases[n], ',');
-            }
-            continue;
-        }
-        /* add this name to the pool */
-        nd = PMIX_NEW(prte_node_t);
-        nd->name = strdup(names[n]);
-        nd->index = n;
-        pmix_pointer_array_set_item(prte_node_pool, n, nd);
-        /* add any aliases */
-        if (0 != strcmp(aliases[n], "PRTENONE")) {
-            nd->aliases = PMIX_ARGV_SPLIT_COMPAT(aliases[n], ',');
-        }
-        /* set the topology - always default to homogeneous
-         * as that is the most common scenario */
-        nd->topology = t;
-        /* see if it has a daemon on it */
-        if (PMIX_RANK_INVALID != vpid[n]) {
-            proc = (prte_proc_t *) pmix_pointer_array_get_item(daemons->procs, vpid[n]);
-            if (NULL == proc) {
-                proc = PMIX_NEW(prte_proc_t);
-                PMIX_LOAD_PROCID(&proc->name, PRTE_PROC_MY_NAME->nspace, vpid[n]);
-                proc->state = PRTE_PROC_STATE_RUNNING;
-                PRTE_FLAG_SET(proc, PRTE_PROC_FLAG_ALIVE);
-                daemons->num_procs++;
-                pmix_pointer_array_set_item(daemons->procs, proc->name.rank, proc);
-            }
-            PMIX_RETAIN(nd);
-            proc->node = nd;
-            PMIX_RETAIN(proc);
-            nd->daemon = proc;
+    for (n = 0; n < nnodes; n++) {
+        name = hostname_at(&names, n);
+        if (NULL == name) {
+            PRTE_ERROR_LOG(PRTE_ERR_UNPACK_FAILURE);
+            rc = PRTE_ERR_UNPACK_FAILURE;
+            goto cleanup;
         }
+        update_node((NULL == indices) ? n : (int) indices[n], name, aliases[n], vpid[n],
+                    daemons, t);
+        free(name);
     }
 
     /* update num procs */
@@ -421,15 +874,52 @@ int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
         prte_process_info.num_daemons = daemons->num_procs;
         /* update the routing tree */
         prte_rml_compute_routing_tree();
+    } else if (prte_rml_base.locality) {
+        /* the tree depends upon where the daemons are, which
+         * we may only just have learned */
+        prte_rml_compute_routing_tree();
     }
-
+    rc = PRTE_SUCCESS;
 
 cleanup:
     if (NULL != vpid) {
         free(vpid);
     }
-    if (NULL != names) {
-        PMIX_ARGV_FREE_COMPAT(names);
+    if (NULL != indices) {
+        free(indices);
+    }
+    hostlist_destruct(&names);
+    if (NULL != aliases) {
+        PMIX_ARGV_FREE_COMPAT(aliases);
+    }
+    return rc;
+}
+
+int prte_util_decode_nidmap(pmix_data_buffer_t *buf)
+{
+    prte_nidmap_held_t *hd, *next;
+    int rc;
+
+    rc = decode_nidmap(buf);
+    if (PRTE_SUCCESS != rc || !held_init) {
+        return rc;
+    }
+    /* apply any updates we were holding that we now have the map
+     * for, discarding those already covered by it */
+    hd = (prte_nidmap_held_t *) pmix_list_get_first(&held);
+    while (PRTE_SUCCESS == rc && hd != (prte_nidmap_held_t *) pmix_list_get_end(&held)) {
+        next = (prte_nidmap_held_t *) pmix_list_get_next(&hd->super);
+        if (hd->base < prte_nidmap_epoch) {
+            pmix_list_remove_item(&held, &hd->super);
+            PMIX_RELEASE(hd);
+        } else if (hd->base == prte_nidmap_epoch) {
+            pmix_list_remove_item(&held, &hd->super);
+            rc = decode_nidmap(&hd->data);
+            PMIX_RELEASE(hd);
+            /* this may have made another one applicable */
+            next = (prte_nidmap_held_t *) pmix_list_get_first(&held);
+        }
+        hd = next;
     }
     return rc;
 }
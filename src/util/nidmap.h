@@ -30,9 +30,23 @@
 #include "src/pmix/pmix-internal.h"
 #include "src/runtime/prte_globals.h"
 
+/* version of the node map held by this process */
+PRTE_EXPORT extern uint32_t prte_nidmap_epoch;
+
 /* pass info about the nodes in an allocation */
 PRTE_EXPORT int prte_util_nidmap_create(pmix_pointer_array_t *pool, pmix_data_buffer_t *buf);
 
+/* pass the changes to the nodes since the last update was created,
+ * advancing the version of the map. The first update is the full
+ * map. Daemons that were not covered by the prior update - i.e.,
+ * those whose rank is at least first_new - need to be sent the full
+ * map. first_new is set to PMIX_RANK_INVALID for a full map */
+PRTE_EXPORT int prte_util_nidmap_create_update(pmix_pointer_array_t *pool,
+                                               pmix_data_buffer_t *buf,
+                                               pmix_rank_t *first_new);
+
+PRTE_EXPORT void prte_util_nidmap_release(void);
+
 PRTE_EXPORT int prte_util_decode_nidmap(pmix_data_buffer_t *buf);
 
 #endif /* PRTE_NIDMAP_H */
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026      Nanook Consulting.  All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Check that published data can still be found after the DVM
+ * grows when the data server is distributed across the daemons.
+ * Run a single proc on the initial allocation and give it the
+ * host(s) to add, e.g.:
+ *
+ *   prterun --prtemca prte_data_server_distributed 1 --host a,b -n 1 ./pubgrow c,d
+ *
+ * The proc publishes a set of keys, then spawns a child onto the
+ * added hosts - which adds daemons to the DVM. Both the child and
+ * the parent then look up every key. The parent waits for the
+ * child to publish its result, unpublishes its keys and checks
+ * that they are gone.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <pmix.h>
+
+#define NKEYS 64
+
+static bool check_keys(pmix_proc_t *myproc)
+{
+    pmix_pdata_t *pdata;
+    pmix_status_t rc;
+    bool ok = true;
+    int n;
+
+    PMIX_PDATA_CREATE(pdata, NKEYS);
+    for (n = 0; n < NKEYS; n++) {
+        snprintf(pdata[n].key, PMIX_MAX_KEYLEN, "pubgrow-%d", n);
+    }
+    rc = PMIx_Lookup(pdata, NKEYS, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s:%u: PMIx_Lookup failed: %s\n", myproc->nspace, myproc->rank,
+                PMIx_Error_string(rc));
+        ok = false;
+    }
+    for (n = 0; ok && n < NKEYS; n++) {
+        if (PMIX_UINT32 != pdata[n].value.type || (uint32_t) n != pdata[n].value.data.uint32) {
+            fprintf(stderr, "%s:%u: key %s returned the wrong value\n", myproc->nspace,
+                    myproc->rank, pdata[n].key);
+            ok = false;
+        }
+    }
+    PMIX_PDATA_FREE(pdata, NKEYS);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    pmix_proc_t myproc;
+    pmix_status_t rc;
+    pmix_value_t *val = NULL;
+    pmix_info_t *info;
+    pmix_pdata_t *pdata;
+    pmix_app_t app;
+    pmix_nspace_t nspace;
+    pmix_persistence_t persist = PMIX_PERSIST_SESSION;
+    char *keys[NKEYS + 1];
+    char names[NKEYS][PMIX_MAX_KEYLEN];
+    uint8_t result;
+    int n, timeout = 60;
+    bool ok = false, child = false;
+
+    if (PMIX_SUCCESS != (rc = PMIx_Init(&myproc, NULL, 0))) {
+        fprintf(stderr, "PMIx_Init failed: %s\n", PMIx_Error_string(rc));
+        exit(1);
+    }
+
+    if (PMIX_SUCCESS == PMIx_Get(&myproc, PMIX_PARENT_ID, NULL, 0, &val)) {
+        /* we are the child, running on one of the added daemons */
+        PMIX_VALUE_RELEASE(val);
+        child = true;
+        ok = check_keys(&myproc);
+        result = ok ? 1 : 0;
+        PMIX_INFO_CREATE(info, 2);
+        PMIX_INFO_LOAD(&info[0], "pubgrow-done", &result, PMIX_UINT8);
+        PMIX_INFO_LOAD(&info[1], PMIX_PERSISTENCE, &persist, PMIX_PERSIST);
+        rc = PMIx_Publish(info, 2);
+        PMIX_INFO_FREE(info, 2);
+        if (PMIX_SUCCESS != rc) {
+            fprintf(stderr, "%s:%u: PMIx_Publish failed: %s\n", myproc.nspace, myproc.rank,
+                    PMIx_Error_string(rc));
+            ok = false;
+        }
+        goto done;
+    }
+
+    if (2 > argc) {
+        fprintf(stderr, "Usage: %s <hosts to add>\n", argv[0]);
+        goto done;
+    }
+
+    /* publish enough keys that some of them will be owned
+     * by the daemons we add */
+    PMIX_INFO_CREATE(info, NKEYS);
+    for (n = 0; n < NKEYS; n++) {
+        snprintf(info[n].key, PMIX_MAX_KEYLEN, "pubgrow-%d", n);
+        info[n].value.type = PMIX_UINT32;
+        info[n].value.data.uint32 = n;
+    }
+    rc = PMIx_Publish(info, NKEYS);
+    PMIX_INFO_FREE(info, NKEYS);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s:%u: PMIx_Publish failed: %s\n", myproc.nspace, myproc.rank,
+                PMIx_Error_string(rc));
+        goto done;
+    }
+
+    /* grow the DVM by starting a child on the new hosts */
+    PMIX_APP_CONSTRUCT(&app);
+    app.cmd = strdup(argv[0]);
+    PMIX_ARGV_APPEND(rc, app.argv, argv[0]);
+    app.maxprocs = 1;
+    app.ninfo = 2;
+    PMIX_INFO_CREATE(app.info, app.ninfo);
+    PMIX_INFO_LOAD(&app.info[0], PMIX_ADD_HOST, argv[1], PMIX_STRING);
+    PMIX_INFO_LOAD(&app.info[1], PMIX_HOST, argv[1], PMIX_STRING);
+    rc = PMIx_Spawn(NULL, 0, &app, 1, nspace);
+    PMIX_APP_DESTRUCT(&app);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s:%u: PMIx_Spawn failed: %s\n", myproc.nspace, myproc.rank,
+                PMIx_Error_string(rc));
+        goto done;
+    }
+
+    /* our daemon now knows about the added daemons */
+    if (!check_keys(&myproc)) {
+        goto done;
+    }
+
+    /* wait for the child's verdict */
+    PMIX_PDATA_CREATE(pdata, 1);
+    PMIX_LOAD_KEY(pdata[0].key, "pubgrow-done");
+    PMIX_INFO_CREATE(info, 2);
+    PMIX_INFO_LOAD(&info[0], PMIX_WAIT, NULL, PMIX_BOOL);
+    PMIX_INFO_LOAD(&info[1], PMIX_TIMEOUT, &timeout, PMIX_INT);
+    rc = PMIx_Lookup(pdata, 1, info, 2);
+    PMIX_INFO_FREE(info, 2);
+    if (PMIX_SUCCESS != rc || PMIX_UINT8 != pdata[0].value.type ||
+        1 != pdata[0].value.data.uint8) {
+        fprintf(stderr, "%s:%u: child could not find the keys: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        PMIX_PDATA_FREE(pdata, 1);
+        goto done;
+    }
+    PMIX_PDATA_FREE(pdata, 1);
+
+    /* remove the keys - including those placed before we grew */
+    for (n = 0; n < NKEYS; n++) {
+        snprintf(names[n], PMIX_MAX_KEYLEN, "pubgrow-%d", n);
+        keys[n] = names[n];
+    }
+    keys[NKEYS] = NULL;
+    rc = PMIx_Unpublish(keys, NULL, 0);
+    if (PMIX_SUCCESS != rc) {
+        fprintf(stderr, "%s:%u: PMIx_Unpublish failed: %s\n", myproc.nspace, myproc.rank,
+                PMIx_Error_string(rc));
+        goto done;
+    }
+    PMIX_PDATA_CREATE(pdata, NKEYS);
+    for (n = 0; n < NKEYS; n++) {
+        snprintf(pdata[n].key, PMIX_MAX_KEYLEN, "pubgrow-%d", n);
+    }
+    rc = PMIx_Lookup(pdata, NKEYS, NULL, 0);
+    PMIX_PDATA_FREE(pdata, NKEYS);
+    if (PMIX_ERR_NOT_FOUND != rc) {
+        fprintf(stderr, "%s:%u: keys still found after unpublish: %s\n", myproc.nspace,
+                myproc.rank, PMIx_Error_string(rc));
+        goto done;
+    }
+    ok = true;
+
+done:
+    if (!child) {
+        fprintf(stderr, "PUBGROW %s\n", ok ? "SUCCEEDED" : "FAILED");
+    }
+    PMIx_Finalize(NULL, 0);
+    return ok ? 0 : 1;
+}